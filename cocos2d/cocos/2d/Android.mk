@@ -80,6 +80,7 @@ CCProgressTimer.cpp \
 CCRenderTexture.cpp \
 CCScene.cpp \
 CCScheduler.cpp \
+CCPoseBatch.cpp \
 CCScriptSupport.cpp \
 CCShaderCache.cpp \
 ccShaders.cpp \
@@ -112,6 +113,7 @@ TransformUtils.cpp \
 ZipUtils.cpp \
 platform/CCGLViewProtocol.cpp \
 platform/CCFileUtils.cpp \
+platform/CCBinaryValueCache.cpp \
 platform/CCSAXParser.cpp \
 platform/CCThread.cpp \
 platform/CCImage.cpp \
@@ -127,6 +129,8 @@ renderer/CCRenderMaterial.cpp \
 ../base/atitc.cpp \
 ../base/CCAffineTransform.cpp \
 ../base/CCAutoreleasePool.cpp \
+../base/CCSlabAllocator.cpp \
+../base/CCJobPool.cpp \
 ../base/CCConsole.cpp \
 ../base/CCData.cpp \
 ../base/CCDataVisitor.cpp \
@@ -134,6 +138,7 @@ renderer/CCRenderMaterial.cpp \
 ../base/CCNS.cpp \
 ../base/CCRef.cpp \
 ../base/CCValue.cpp \
+../base/CCValueFlatMap.cpp \
 ../base/etc1.cpp \
 ../base/s3tc.cpp \
 ../deprecated/CCArray.cpp \
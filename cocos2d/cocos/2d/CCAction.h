@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __ACTIONS_CCACTION_H__
 
 #include "CCRef.h"
+#include "CCSlabAllocator.h"
 #include "CCGeometry.h"
 
 NS_CC_BEGIN
@@ -44,6 +45,7 @@ class Node;
  */
 class CC_DLL Action : public Ref, public Clonable
 {
+    CC_SLAB_ALLOCATED
 public:
     /// Default tag used for all the actions
     static const int INVALID_TAG = -1;
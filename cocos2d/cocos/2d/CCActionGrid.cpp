@@ -121,6 +121,35 @@ void Grid3DAction::setVertex(const Point& position, const Vertex3F& vertex)
     g->setVertex(position, vertex);
 }
 
+Grid3D* Grid3DAction::getVertexEffectGrid(float time)
+{
+#if CC_ENABLE_GPU_GRID_EFFECTS
+    Grid3D *g = (Grid3D*)_gridNodeTarget->getGrid();
+    if (time < 1 && !_bakingVertexEffect && g->isVertexEffectSupported())
+    {
+        _vertexEffectTime = time;
+        return g;
+    }
+
+    g->setVertexEffect(Grid3D::VertexEffect::NONE);
+#endif // CC_ENABLE_GPU_GRID_EFFECTS
+    return nullptr;
+}
+
+void Grid3DAction::stop()
+{
+    // the action was stopped before its last update: set the vertices it left in the shader
+    Grid3D *g = dynamic_cast<Grid3D*>(_gridNodeTarget->getGrid());
+    if (g && g->getVertexEffect() != Grid3D::VertexEffect::NONE)
+    {
+        _bakingVertexEffect = true;
+        update(_vertexEffectTime);
+        _bakingVertexEffect = false;
+    }
+
+    GridAction::stop();
+}
+
 // implementation of TiledGrid3DAction
 
 GridBase* TiledGrid3DAction::getGrid(void)
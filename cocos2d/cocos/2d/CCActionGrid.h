@@ -32,6 +32,7 @@ THE SOFTWARE.
 NS_CC_BEGIN
 
 class GridBase;
+class Grid3D;
 class NodeGrid;
 
 /**
@@ -110,6 +111,19 @@ public:
 
     // Overrides
 	virtual Grid3DAction * clone() const override = 0;
+    virtual void stop() override;
+
+protected:
+    Grid3DAction() : _vertexEffectTime(0), _bakingVertexEffect(false) {}
+
+    /** returns the grid if the action can let it apply its effect in the vertex shader at the given time,
+     or nullptr if the vertices have to be set on the CPU. The last update and stop() always set them,
+     so the actions that reuse the grid find the transformed vertices.
+     */
+    Grid3D* getVertexEffectGrid(float time);
+
+    float _vertexEffectTime;
+    bool _bakingVertexEffect;
 };
 
 /** @brief Base class for TiledGrid3D actions */
@@ -25,6 +25,7 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "CCActionGrid3D.h"
 #include "CCDirector.h"
+#include "CCGrid.h"
 #include <stdlib.h>
 
 NS_CC_BEGIN
@@ -74,6 +75,13 @@ Waves3D* Waves3D::clone() const
 
 void Waves3D::update(float time)
 {
+    Grid3D *grid = getVertexEffectGrid(time);
+    if (grid)
+    {
+        grid->setVertexEffect(Grid3D::VertexEffect::WAVES_3D, (float)M_PI * time * _waves * 2, _amplitude * _amplitudeRate);
+        return;
+    }
+
     int i, j;
     for (i = 0; i < _gridSize.width + 1; ++i)
     {
@@ -447,6 +455,13 @@ Ripple3D* Ripple3D::clone() const
 
 void Ripple3D::update(float time)
 {
+    Grid3D *grid = getVertexEffectGrid(time);
+    if (grid)
+    {
+        grid->setVertexEffect(Grid3D::VertexEffect::RIPPLE_3D, time*(float)M_PI * _waves * 2, _amplitude * _amplitudeRate, _position.x, _position.y, _radius);
+        return;
+    }
+
     int i, j;
 
     for (i = 0; i < (_gridSize.width+1); ++i)
@@ -580,6 +595,13 @@ Liquid* Liquid::clone() const
 
 void Liquid::update(float time)
 {
+    Grid3D *grid = getVertexEffectGrid(time);
+    if (grid)
+    {
+        grid->setVertexEffect(Grid3D::VertexEffect::LIQUID, time * (float)M_PI * _waves * 2, _amplitude * _amplitudeRate);
+        return;
+    }
+
     int i, j;
 
     for (i = 1; i < _gridSize.width; ++i)
@@ -642,6 +664,13 @@ Waves* Waves::clone() const
 
 void Waves::update(float time)
 {
+    Grid3D *grid = getVertexEffectGrid(time);
+    if (grid)
+    {
+        grid->setVertexEffect(Grid3D::VertexEffect::WAVES, time * (float)M_PI * _waves * 2, _amplitude * _amplitudeRate, _vertical ? 1 : 0, _horizontal ? 1 : 0);
+        return;
+    }
+
     int i, j;
 
     for (i = 0; i < _gridSize.width + 1; ++i)
@@ -717,6 +746,13 @@ Twirl *Twirl::clone() const
 
 void Twirl::update(float time)
 {
+    Grid3D *grid = getVertexEffectGrid(time);
+    if (grid)
+    {
+        grid->setVertexEffect(Grid3D::VertexEffect::TWIRL, time * (float)M_PI * _twirls * 2, 0.1f * _amplitude * _amplitudeRate, _position.x, _position.y);
+        return;
+    }
+
     int i, j;
     Point    c = _position;
     
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "CCScheduler.h"
 #include "ccMacros.h"
 #include "ccCArray.h"
+#include "CCProfiling.h"
 #include "uthash.h"
 
 NS_CC_BEGIN
@@ -339,6 +340,8 @@ ssize_t ActionManager::getNumberOfRunningActionsInTarget(const Node *target) con
 // main loop
 void ActionManager::update(float dt)
 {
+    CC_PROFILER_ZONE("ActionManager - update");
+
     for (tHashElement *elt = _targets; elt != nullptr; )
     {
         _currentTarget = elt;
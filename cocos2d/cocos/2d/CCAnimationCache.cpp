@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "CCSpriteFrameCache.h"
 #include "deprecated/CCString.h"
 #include "platform/CCFileUtils.h"
+#include <memory>
 
 using namespace std;
 
@@ -81,18 +82,25 @@ void AnimationCache::removeAnimation(const std::string& name)
     _animations.erase(name);
 }
 
+// unlike operator[], doesn't insert the key in the dictionary when it is missing
+static const Value& findValue(const ValueFlatMap& dict, const char* key)
+{
+    auto iter = dict.find(key);
+    return iter != dict.end() ? iter->second : Value::Null;
+}
+
 Animation* AnimationCache::getAnimation(const std::string& name)
 {
     return _animations.at(name);
 }
 
-void AnimationCache::parseVersion1(const ValueMap& animations)
+void AnimationCache::parseVersion1(const ValueFlatMap& animations)
 {
     SpriteFrameCache *frameCache = SpriteFrameCache::getInstance();
 
-    for (auto iter = animations.cbegin(); iter != animations.cend(); ++iter)
+    for (auto iter = animations.begin(); iter != animations.end(); ++iter)
     {
-        const ValueMap& animationDict = iter->second.asValueMap();
+        const ValueFlatMap& animationDict = iter->second.asValueFlatMap();
         const ValueVector& frameNames = animationDict.at("frames").asValueVector();
         float delay = animationDict.at("delay").asFloat();
         Animation* animation = nullptr;
@@ -136,19 +144,19 @@ void AnimationCache::parseVersion1(const ValueMap& animations)
     }
 }
 
-void AnimationCache::parseVersion2(const ValueMap& animations)
+void AnimationCache::parseVersion2(const ValueFlatMap& animations)
 {
     SpriteFrameCache *frameCache = SpriteFrameCache::getInstance();
 
-    for (auto iter = animations.cbegin(); iter != animations.cend(); ++iter)
+    for (auto iter = animations.begin(); iter != animations.end(); ++iter)
     {
         std::string name = iter->first;
-        ValueMap& animationDict = const_cast<ValueMap&>(iter->second.asValueMap());
+        const ValueFlatMap& animationDict = iter->second.asValueFlatMap();
 
-        const Value& loops = animationDict["loops"];
-        bool restoreOriginalFrame = animationDict["restoreOriginalFrame"].asBool();
+        const Value& loops = findValue(animationDict, "loops");
+        bool restoreOriginalFrame = findValue(animationDict, "restoreOriginalFrame").asBool();
 
-        ValueVector& frameArray = animationDict["frames"].asValueVector();
+        const ValueVector& frameArray = findValue(animationDict, "frames").asValueVector();
 
         if ( frameArray.empty() )
         {
@@ -161,8 +169,8 @@ void AnimationCache::parseVersion2(const ValueMap& animations)
 
         for (auto& obj : frameArray)
         {
-            ValueMap& entry = obj.asValueMap();
-            std::string spriteFrameName = entry["spriteframe"].asString();
+            const ValueFlatMap& entry = obj.asValueFlatMap();
+            std::string spriteFrameName = findValue(entry, "spriteframe").asString();
             SpriteFrame *spriteFrame = frameCache->getSpriteFrameByName(spriteFrameName);
 
             if( ! spriteFrame ) {
@@ -171,15 +179,15 @@ void AnimationCache::parseVersion2(const ValueMap& animations)
                 continue;
             }
 
-            float delayUnits = entry["delayUnits"].asFloat();
-            Value& userInfo = entry["notification"];
+            float delayUnits = findValue(entry, "delayUnits").asFloat();
+            const Value& userInfo = findValue(entry, "notification");
 
-            AnimationFrame *animFrame = AnimationFrame::create(spriteFrame, delayUnits, userInfo.asValueMap());
+            AnimationFrame *animFrame = AnimationFrame::create(spriteFrame, delayUnits, userInfo.asValueFlatMap().toValueMap());
 
             array.pushBack(animFrame);
         }
 
-        float delayPerUnit = animationDict["delayPerUnit"].asFloat();
+        float delayPerUnit = findValue(animationDict, "delayPerUnit").asFloat();
         Animation *animation = Animation::create(array, delayPerUnit, loops.getType() != Value::Type::NONE ? loops.asInt() : 1);
 
         animation->setRestoreOriginalFrame(restoreOriginalFrame);
@@ -189,6 +197,11 @@ void AnimationCache::parseVersion2(const ValueMap& animations)
 }
 
 void AnimationCache::addAnimationsWithDictionary(const ValueMap& dictionary,const std::string& plist)
+{
+    addAnimationsWithFlatDictionary(ValueFlatMap(dictionary), plist);
+}
+
+void AnimationCache::addAnimationsWithFlatDictionary(const ValueFlatMap& dictionary, const std::string& plist)
 {
     if ( dictionary.find("animations") == dictionary.end() )
     {
@@ -201,7 +214,7 @@ void AnimationCache::addAnimationsWithDictionary(const ValueMap& dictionary,cons
 
     if( dictionary.find("properties") != dictionary.end() )
     {
-        const ValueMap& properties = dictionary.at("properties").asValueMap();
+        const ValueFlatMap& properties = dictionary.at("properties").asValueFlatMap();
         version = properties.at("format").asInt();
         const ValueVector& spritesheets = properties.at("spritesheets").asValueVector();
 
@@ -213,10 +226,10 @@ void AnimationCache::addAnimationsWithDictionary(const ValueMap& dictionary,cons
 
     switch (version) {
         case 1:
-            parseVersion1(animations.asValueMap());
+            parseVersion1(animations.asValueFlatMap());
             break;
         case 2:
-            parseVersion2(animations.asValueMap());
+            parseVersion2(animations.asValueFlatMap());
             break;
         default:
             CCASSERT(false, "Invalid animation format");
@@ -229,11 +242,55 @@ void AnimationCache::addAnimationsWithFile(const std::string& plist)
     CCASSERT( plist.size()>0, "Invalid texture file name");
 
     std::string path = FileUtils::getInstance()->fullPathForFilename(plist);
-    ValueMap dict =  FileUtils::getInstance()->getValueMapFromFile(path);
+    ValueFlatMap dict =  FileUtils::getInstance()->getValueFlatMapFromFile(path);
 
     CCASSERT( !dict.empty(), "CCAnimationCache: File could not be found");
 
-    addAnimationsWithDictionary(dict,plist);
+    addAnimationsWithFlatDictionary(dict,plist);
+}
+
+void AnimationCache::addAnimationsWithFileAsync(const std::string& plist, const std::function<void()>& callback)
+{
+    CCASSERT( plist.size()>0, "Invalid texture file name");
+
+    std::string path = FileUtils::getInstance()->fullPathForFilename(plist);
+    auto dict = std::make_shared<ValueFlatMap>(FileUtils::getInstance()->getValueFlatMapFromFile(path));
+
+    CCASSERT( !dict->empty(), "CCAnimationCache: File could not be found");
+
+    std::vector<std::string> sheets;
+    auto properties = dict->find("properties");
+    if (properties != dict->end())
+    {
+        auto spritesheets = properties->second.asValueFlatMap().find("spritesheets");
+        if (spritesheets != properties->second.asValueFlatMap().end())
+        {
+            for (const auto &value : spritesheets->second.asValueVector())
+            {
+                sheets.push_back(FileUtils::getInstance()->fullPathFromRelativeFile(value.asString(), plist));
+            }
+        }
+    }
+
+    // addAnimationsWithDictionary() finds the sheets in the cache once they are all loaded
+    auto pending = std::make_shared<size_t>(sheets.size() + 1);
+    auto onSheetLoaded = [this, dict, plist, pending, callback](bool){
+        if (--(*pending) == 0)
+        {
+            addAnimationsWithFlatDictionary(*dict, plist);
+            if (callback)
+            {
+                callback();
+            }
+        }
+    };
+
+    for (const auto &sheet : sheets)
+    {
+        SpriteFrameCache::getInstance()->addSpriteFramesWithFileAsync(sheet, onSheetLoaded);
+    }
+
+    onSheetLoaded(true);
 }
 
 
@@ -30,8 +30,10 @@ THE SOFTWARE.
 #include "CCRef.h"
 #include "CCMap.h"
 #include "CCValue.h"
+#include "CCValueFlatMap.h"
 
 #include <string>
+#include <functional>
 
 NS_CC_BEGIN
 
@@ -117,9 +119,18 @@ public:
      */
     void addAnimationsWithFile(const std::string& plist);
 
+    /** Adds the animations of a plist file once the sprite sheets it refers to are loaded.
+     The textures of the sheets are loaded in another thread with SpriteFrameCache::addSpriteFramesWithFileAsync(),
+     and the callback is called in the cocos2d thread once the animations are in the cache.
+     @since v3.0
+     */
+    void addAnimationsWithFileAsync(const std::string& plist, const std::function<void()>& callback);
+
 private:
-    void parseVersion1(const ValueMap& animations);
-    void parseVersion2(const ValueMap& animations);
+    /** addAnimationsWithDictionary() for the dictionaries read with FileUtils::getValueFlatMapFromFile() */
+    void addAnimationsWithFlatDictionary(const ValueFlatMap& dictionary, const std::string& plist);
+    void parseVersion1(const ValueFlatMap& animations);
+    void parseVersion2(const ValueFlatMap& animations);
 
 private:
     Map<std::string, Animation*> _animations;
@@ -31,6 +31,9 @@
 #include "CCShaderCache.h"
 #include "CCDirector.h"
 #include "CCDrawingPrimitives.h"
+#include "CCDrawNode.h"
+#include "CCSprite.h"
+#include "CCLayer.h"
 
 #include "renderer/CCRenderer.h"
 #include "renderer/CCGroupCommand.h"
@@ -43,6 +46,11 @@ static GLint g_sStencilBits = -1;
 // this will allow nesting up to n ClippingNode,
 // where n is the number of bits of the stencil buffer.
 static GLint s_layer = -1;
+// the last clipping node visited that clipped with the stencil buffer
+static ClippingNode* s_lastClippingNode = nullptr;
+// number of clipping nodes using the stencil buffer that are being visited,
+// the layer s_layer will be set to when the commands queued now are rendered
+static GLint s_visitLayer = -1;
 
 static void setProgram(Node *n, GLProgram *p)
 {
@@ -58,6 +66,11 @@ ClippingNode::ClippingNode()
 : _stencil(nullptr)
 , _alphaThreshold(0.0f)
 , _inverted(false)
+, _currentScissorEnabled(GL_FALSE)
+, _reuseStencil(false)
+, _addedCommandsAfterVisit(0)
+, _framesAfterVisit(0)
+, _stencilLayer(-1)
 , _currentStencilEnabled(GL_FALSE)
 , _currentStencilWriteMask(~0)
 , _currentStencilFunc(GL_ALWAYS)
@@ -76,6 +89,11 @@ ClippingNode::ClippingNode()
 
 ClippingNode::~ClippingNode()
 {
+    if (s_lastClippingNode == this)
+    {
+        s_lastClippingNode = nullptr;
+    }
+
     if (_stencil)
     {
         _stencil->stopAllActions();
@@ -219,6 +237,25 @@ void ClippingNode::visit(Renderer *renderer, const kmMat4 &parentTransform, bool
     kmGLPushMatrix();
     kmGLLoadMatrix(&_modelViewTransform);
 
+    Rect scissorRect;
+    bool scissor = getStencilRectangle(_modelViewTransform, &scissorRect);
+
+    // the previous clipping node left its stencil in the layer this one is going to use,
+    // it can be reused if nothing was queued since in this frame and the stencil is the same, at the same place
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    ClippingNode* previous = s_lastClippingNode;
+    _stencilLayer = scissor ? -1 : s_visitLayer + 1;
+    _reuseStencil = ! scissor
+        && previous != nullptr
+        && previous->_framesAfterVisit == frame
+        && previous->_addedCommandsAfterVisit == renderer->getAddedCommands()
+        && previous->_stencilLayer == _stencilLayer
+        && previous->_stencil == _stencil
+        && previous->_inverted == _inverted
+        && previous->_alphaThreshold == _alphaThreshold
+        && previous->_globalZOrder == 0 && _globalZOrder == 0
+        && memcmp(&previous->_modelViewTransform, &_modelViewTransform, sizeof(kmMat4)) == 0;
+
     //Add group command
         
     _groupCommand.init(_globalZOrder);
@@ -226,32 +263,53 @@ void ClippingNode::visit(Renderer *renderer, const kmMat4 &parentTransform, bool
 
     renderer->pushGroup(_groupCommand.getRenderQueueID());
 
-    _beforeVisitCmd.init(_globalZOrder);
-    _beforeVisitCmd.func = CC_CALLBACK_0(ClippingNode::onBeforeVisit, this);
-    renderer->addCommand(&_beforeVisitCmd);
-    if (_alphaThreshold < 1)
+    if (scissor)
     {
+        // the stencil is not drawn, a scissor does the clipping
+        _scissorRect = scissorRect;
+        _beforeVisitScissorCmd.init(_globalZOrder);
+        _beforeVisitScissorCmd.func = CC_CALLBACK_0(ClippingNode::onBeforeVisitScissor, this);
+        renderer->addCommand(&_beforeVisitScissorCmd);
+    }
+    else
+    {
+        _beforeVisitCmd.init(_globalZOrder);
+        _beforeVisitCmd.func = CC_CALLBACK_0(ClippingNode::onBeforeVisit, this);
+        renderer->addCommand(&_beforeVisitCmd);
+    }
+
+    if (! scissor && ! _reuseStencil)
+    {
+        if (_alphaThreshold < 1)
+        {
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_MAC || CC_TARGET_PLATFORM == CC_PLATFORM_WINDOWS || CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
 #else
-        // since glAlphaTest do not exists in OES, use a shader that writes
-        // pixel only if greater than an alpha threshold
-        GLProgram *program = ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST_NO_MV);
-        GLint alphaValueLocation = glGetUniformLocation(program->getProgram(), GLProgram::UNIFORM_NAME_ALPHA_TEST_VALUE);
-        // set our alphaThreshold
-        program->use();
-        program->setUniformLocationWith1f(alphaValueLocation, _alphaThreshold);
-        // we need to recursively apply this shader to all the nodes in the stencil node
-        // XXX: we should have a way to apply shader to all nodes without having to do this
-        setProgram(_stencil, program);
-        
+            // since glAlphaTest do not exists in OES, use a shader that writes
+            // pixel only if greater than an alpha threshold
+            GLProgram *program = ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST_NO_MV);
+            GLint alphaValueLocation = glGetUniformLocation(program->getProgram(), GLProgram::UNIFORM_NAME_ALPHA_TEST_VALUE);
+            // set our alphaThreshold
+            program->use();
+            program->setUniformLocationWith1f(alphaValueLocation, _alphaThreshold);
+            // we need to recursively apply this shader to all the nodes in the stencil node
+            // XXX: we should have a way to apply shader to all nodes without having to do this
+            setProgram(_stencil, program);
+            
 #endif
 
+        }
+        _stencil->visit(renderer, _modelViewTransform, dirty);
+
+        _afterDrawStencilCmd.init(_globalZOrder);
+        _afterDrawStencilCmd.func = CC_CALLBACK_0(ClippingNode::onAfterDrawStencil, this);
+        renderer->addCommand(&_afterDrawStencilCmd);
     }
-    _stencil->visit(renderer, _modelViewTransform, dirty);
 
-    _afterDrawStencilCmd.init(_globalZOrder);
-    _afterDrawStencilCmd.func = CC_CALLBACK_0(ClippingNode::onAfterDrawStencil, this);
-    renderer->addCommand(&_afterDrawStencilCmd);
+    if (! scissor)
+    {
+        // the children are drawn in the next layer
+        s_visitLayer++;
+    }
 
     int i = 0;
     
@@ -279,13 +337,91 @@ void ClippingNode::visit(Renderer *renderer, const kmMat4 &parentTransform, bool
         this->draw(renderer, _modelViewTransform, dirty);
     }
 
-    _afterVisitCmd.init(_globalZOrder);
-    _afterVisitCmd.func = CC_CALLBACK_0(ClippingNode::onAfterVisit, this);
-    renderer->addCommand(&_afterVisitCmd);
+    if (! scissor)
+    {
+        s_visitLayer--;
+    }
+
+    if (scissor)
+    {
+        _afterVisitScissorCmd.init(_globalZOrder);
+        _afterVisitScissorCmd.func = CC_CALLBACK_0(ClippingNode::onAfterVisitScissor, this);
+        renderer->addCommand(&_afterVisitScissorCmd);
+    }
+    else
+    {
+        _afterVisitCmd.init(_globalZOrder);
+        _afterVisitCmd.func = CC_CALLBACK_0(ClippingNode::onAfterVisit, this);
+        renderer->addCommand(&_afterVisitCmd);
+    }
 
     renderer->popGroup();
     
     kmGLPopMatrix();
+
+    _addedCommandsAfterVisit = renderer->getAddedCommands();
+    _framesAfterVisit = frame;
+    s_lastClippingNode = scissor ? nullptr : this;
+}
+
+bool ClippingNode::getStencilRectangle(const kmMat4& transform, Rect* rect) const
+{
+    // the whole stencil is drawn in the stencil buffer only without alpha test
+    if (_stencil == nullptr || ! _stencil->isVisible() || _stencil->getChildrenCount() > 0 || _inverted || _alphaThreshold < 1)
+    {
+        return false;
+    }
+
+    Rect local;
+    DrawNode* drawNode = dynamic_cast<DrawNode*>(_stencil);
+    Sprite* sprite = dynamic_cast<Sprite*>(_stencil);
+    if (drawNode)
+    {
+        if (! drawNode->isRectangle(&local))
+        {
+            return false;
+        }
+    }
+    else if (sprite)
+    {
+        V3F_C4B_T2F_Quad quad = sprite->getQuad();
+        float minX = MIN(quad.bl.vertices.x, quad.tr.vertices.x);
+        float minY = MIN(quad.bl.vertices.y, quad.tr.vertices.y);
+        local.setRect(minX, minY, MAX(quad.bl.vertices.x, quad.tr.vertices.x) - minX, MAX(quad.bl.vertices.y, quad.tr.vertices.y) - minY);
+    }
+    else if (dynamic_cast<LayerColor*>(_stencil))
+    {
+        local.setRect(0, 0, _stencil->getContentSize().width, _stencil->getContentSize().height);
+    }
+    else
+    {
+        return false;
+    }
+
+    kmMat4 m;
+    kmMat4Multiply(&m, &transform, &_stencil->getNodeToParentTransform());
+
+    // only scales and translations in the plane, possibly with a quarter turn
+    static const float EPSILON = 1e-5f;
+    bool keepsAxes = fabsf(m.mat[1]) < EPSILON && fabsf(m.mat[4]) < EPSILON;
+    bool swapsAxes = fabsf(m.mat[0]) < EPSILON && fabsf(m.mat[5]) < EPSILON;
+    if ((! keepsAxes && ! swapsAxes)
+        || fabsf(m.mat[2]) > EPSILON || fabsf(m.mat[6]) > EPSILON
+        || fabsf(m.mat[3]) > EPSILON || fabsf(m.mat[7]) > EPSILON)
+    {
+        return false;
+    }
+
+    kmVec4 corner0, corner1, v4local;
+    kmVec4Fill(&v4local, local.getMinX(), local.getMinY(), 0, 1);
+    kmVec4MultiplyMat4(&corner0, &v4local, &m);
+    kmVec4Fill(&v4local, local.getMaxX(), local.getMaxY(), 0, 1);
+    kmVec4MultiplyMat4(&corner1, &v4local, &m);
+
+    float minX = MIN(corner0.x, corner1.x);
+    float minY = MIN(corner0.y, corner1.y);
+    rect->setRect(minX, minY, MAX(corner0.x, corner1.x) - minX, MAX(corner0.y, corner1.y) - minY);
+    return true;
 }
 
 Node* ClippingNode::getStencil() const
@@ -355,6 +491,14 @@ void ClippingNode::onBeforeVisit()
     // this means that operation like glClear or glStencilOp will be masked with this value
     glStencilMask(mask_layer);
 
+    if (_reuseStencil)
+    {
+        // the current layer already holds the same stencil, draw the content right away
+        glStencilFunc(GL_EQUAL, _mask_layer_le, _mask_layer_le);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        return;
+    }
+
     // manually save the depth test state
 
     glGetBooleanv(GL_DEPTH_WRITEMASK, &_currentDepthWriteMask);
@@ -473,4 +617,56 @@ void ClippingNode::onAfterVisit()
     s_layer--;
 }
 
+void ClippingNode::onBeforeVisitScissor()
+{
+    // manually save the scissor state
+    _currentScissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+    glGetIntegerv(GL_SCISSOR_BOX, _currentScissorBox);
+
+    // project the rectangle like its vertices would be, this also works inside a RenderTexture
+    kmMat4 projection;
+    kmGLGetMatrix(KM_GL_PROJECTION, &projection);
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    kmVec4 corner0, corner1, v4world;
+    kmVec4Fill(&v4world, _scissorRect.getMinX(), _scissorRect.getMinY(), 0, 1);
+    kmVec4MultiplyMat4(&corner0, &v4world, &projection);
+    kmVec4Fill(&v4world, _scissorRect.getMaxX(), _scissorRect.getMaxY(), 0, 1);
+    kmVec4MultiplyMat4(&corner1, &v4world, &projection);
+
+    float x0 = viewport[0] + (corner0.x / corner0.w + 1) * 0.5f * viewport[2];
+    float y0 = viewport[1] + (corner0.y / corner0.w + 1) * 0.5f * viewport[3];
+    float x1 = viewport[0] + (corner1.x / corner1.w + 1) * 0.5f * viewport[2];
+    float y1 = viewport[1] + (corner1.y / corner1.w + 1) * 0.5f * viewport[3];
+
+    // the pixels whose center is inside the rectangle, like the stencil would cover
+    GLint left = (GLint)floorf(MIN(x0, x1) + 0.5f);
+    GLint bottom = (GLint)floorf(MIN(y0, y1) + 0.5f);
+    GLint right = (GLint)floorf(MAX(x0, x1) + 0.5f);
+    GLint top = (GLint)floorf(MAX(y0, y1) + 0.5f);
+
+    // nested in an other scissor
+    if (_currentScissorEnabled)
+    {
+        left = MAX(left, _currentScissorBox[0]);
+        bottom = MAX(bottom, _currentScissorBox[1]);
+        right = MIN(right, _currentScissorBox[0] + _currentScissorBox[2]);
+        top = MIN(top, _currentScissorBox[1] + _currentScissorBox[3]);
+    }
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(left, bottom, MAX(right - left, 0), MAX(top - bottom, 0));
+}
+
+void ClippingNode::onAfterVisitScissor()
+{
+    // manually restore the scissor state
+    glScissor(_currentScissorBox[0], _currentScissorBox[1], _currentScissorBox[2], _currentScissorBox[3]);
+    if (!_currentScissorEnabled)
+    {
+        glDisable(GL_SCISSOR_TEST);
+    }
+}
+
 NS_CC_END
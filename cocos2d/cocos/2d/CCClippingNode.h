@@ -39,6 +39,12 @@ NS_CC_BEGIN
  It draws its content (childs) clipped using a stencil.
  The stencil is an other Node that will not be drawn.
  The clipping is done using the alpha part of the stencil (adjusted with an alphaThreshold).
+
+ When the stencil is an axis aligned rectangle (a DrawNode with a single rectangle, a Sprite or a LayerColor,
+ without children, alpha threshold of 1 and not inverted), the clipping is done with a scissor instead,
+ which neither draws the stencil nor uses a layer of the stencil buffer.
+ A clipping node that directly follows an other one with the same stencil at the same position reuses
+ the stencil layer it drew.
  */
 class CC_DLL ClippingNode : public Node
 {
@@ -124,10 +130,29 @@ protected:
     GLfloat _alphaThreshold;
     bool    _inverted;
 
+    /** whether the stencil is an axis aligned rectangle once transformed by transform,
+     in which case rect is set to it in world coordinates */
+    bool getStencilRectangle(const kmMat4& transform, Rect* rect) const;
+
     //renderData and callback
     void onBeforeVisit();
     void onAfterDrawStencil();
     void onAfterVisit();
+    void onBeforeVisitScissor();
+    void onAfterVisitScissor();
+
+    // rectangular stencil, in world coordinates
+    Rect _scissorRect;
+    GLboolean _currentScissorEnabled;
+    GLint _currentScissorBox[4];
+
+    // true when the stencil layer drawn by the previous clipping node is used as is
+    bool _reuseStencil;
+    // value of Renderer::getAddedCommands() and of Director::getTotalFrames() at the end of the last visit
+    unsigned int _addedCommandsAfterVisit;
+    unsigned int _framesAfterVisit;
+    // stencil layer used during the last visit, -1 when it clipped with a scissor
+    GLint _stencilLayer;
 
     GLboolean _currentStencilEnabled;
     GLuint _currentStencilWriteMask;
@@ -149,6 +174,8 @@ protected:
     CustomCommand _beforeVisitCmd;
     CustomCommand _afterDrawStencilCmd;
     CustomCommand _afterVisitCmd;
+    CustomCommand _beforeVisitScissorCmd;
+    CustomCommand _afterVisitScissorCmd;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(ClippingNode);
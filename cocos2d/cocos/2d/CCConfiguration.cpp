@@ -47,6 +47,7 @@ Configuration::Configuration()
 , _supportsBGRA8888(false)
 , _supportsDiscardFramebuffer(false)
 , _supportsShareableVAO(false)
+, _supportsPixelBufferObject(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(nullptr)
@@ -142,6 +143,9 @@ void Configuration::gatherGPUInfo()
     _supportsShareableVAO = checkForGLExtension("vertex_array_object");
 	_valueDict["gl.supports_vertex_array_object"] = Value(_supportsShareableVAO);
 
+    _supportsPixelBufferObject = checkForGLExtension("pixel_buffer_object");
+    _valueDict["gl.supports_pixel_buffer_object"] = Value(_supportsPixelBufferObject);
+
     CHECK_GL_ERROR_DEBUG();
 }
 
@@ -247,6 +251,15 @@ bool Configuration::supportsShareableVAO() const
 #endif
 }
 
+bool Configuration::supportsPixelBufferObject() const
+{
+#ifdef GL_PIXEL_PACK_BUFFER
+    return _supportsPixelBufferObject;
+#else
+    return false;
+#endif
+}
+
 //
 // generic getters for properties
 //
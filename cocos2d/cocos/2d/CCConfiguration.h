@@ -110,6 +110,12 @@ public:
      */
 	bool supportsShareableVAO() const;
 
+    /** Whether or not pixel buffer objects can be used to read pixels back asynchronously.
+     They are not available on OpenGL ES 2.0.
+     @since v3.0
+     */
+    bool supportsPixelBufferObject() const;
+
     /** returns whether or not an OpenGL is supported */
     bool checkForGLExtension(const std::string &searchName) const;
 
@@ -146,6 +152,7 @@ protected:
     bool            _supportsBGRA8888;
     bool            _supportsDiscardFramebuffer;
     bool            _supportsShareableVAO;
+    bool            _supportsPixelBufferObject;
     GLint           _maxSamplesAllowed;
     GLint           _maxTextureUnits;
     char *          _glExtensions;
@@ -61,6 +61,9 @@ THE SOFTWARE.
 #include "renderer/CCRenderer.h"
 #include "renderer/CCFrustum.h"
 #include "CCConsole.h"
+#include "CCPoseBatch.h"
+#include "CCJobPool.h"
+#include "CCSlabAllocator.h"
 
 #include "kazmath/kazmath.h"
 #include "kazmath/GL/matrix.h"
@@ -166,6 +169,14 @@ bool Director::init(void)
     // paused ?
     _paused = false;
 
+    // fixed time step
+    _fixedTimeStep = 0.0f;
+    _maxFixedStepsPerFrame = 5;
+    _accumulatedTime = 0.0;
+    _interpolationAlpha = 0.0f;
+
+    _headless = false;
+
     // purge ?
     _purgeDirectorInNextLoop = false;
 
@@ -293,6 +304,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    CC_PROFILER_ZONE("Director - drawScene");
+
     // calculate "global" dt
     calculateDeltaTime();
     
@@ -302,7 +315,7 @@ void Director::drawScene()
         return;
     }
 
-    if (_openGLView)
+    if (_openGLView && !_headless)
     {
         _openGLView->pollInputEvents();
     }
@@ -310,8 +323,18 @@ void Director::drawScene()
     //tick before glClear: issue #533
     if (! _paused)
     {
-        _scheduler->update(_deltaTime);
-        _eventDispatcher->dispatchEvent(_eventAfterUpdate);
+        updateSimulation();
+    }
+
+    if (_headless)
+    {
+        if (_nextScene)
+        {
+            setNextScene();
+        }
+
+        _totalFrames++;
+        return;
     }
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -350,6 +373,12 @@ void Director::drawScene()
     _renderer->render();
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
 
+    // drops the textures nobody retained when over the budget, see TextureCache::setMemoryBudget()
+    if (_textureCache)
+    {
+        _textureCache->trimToMemoryBudget();
+    }
+
     kmGLPopMatrix();
 
     _totalFrames++;
@@ -366,8 +395,72 @@ void Director::drawScene()
     }
 }
 
+void Director::updateSimulation()
+{
+    if (_fixedTimeStep <= 0)
+    {
+        _scheduler->update(_deltaTime);
+        PoseBatch::getInstance()->flush();
+        _eventDispatcher->dispatchEvent(_eventAfterUpdate);
+        return;
+    }
+
+    _accumulatedTime += _deltaTime;
+
+    unsigned int steps = 0;
+    while (_accumulatedTime >= _fixedTimeStep && steps < _maxFixedStepsPerFrame)
+    {
+        _scheduler->update(_fixedTimeStep);
+        PoseBatch::getInstance()->flush();
+        _eventDispatcher->dispatchEvent(_eventAfterUpdate);
+        _accumulatedTime -= _fixedTimeStep;
+        ++steps;
+    }
+
+    // too far behind: drop what can't be simulated instead of spiralling into longer and longer frames
+    if (_accumulatedTime >= _fixedTimeStep)
+    {
+        _accumulatedTime = fmod(_accumulatedTime, (double)_fixedTimeStep);
+    }
+
+    _interpolationAlpha = (float)(_accumulatedTime / _fixedTimeStep);
+}
+
+void Director::setFixedTimeStep(float fixedTimeStep)
+{
+    CCASSERT(fixedTimeStep >= 0, "fixed time step should not be negative");
+
+    _fixedTimeStep = MAX(0.0f, fixedTimeStep);
+    _accumulatedTime = 0.0;
+    _interpolationAlpha = 0.0f;
+}
+
+void Director::setMaxFixedStepsPerFrame(unsigned int maxSteps)
+{
+    CCASSERT(maxSteps > 0, "at least one fixed step should be run per frame");
+
+    _maxFixedStepsPerFrame = MAX(1u, maxSteps);
+}
+
+void Director::setHeadless(bool headless)
+{
+    if (_headless != headless)
+    {
+        _headless = headless;
+        // the wall clock was not read while headless, don't feed the gap to the scheduler
+        _nextDeltaTimeZero = true;
+    }
+}
+
 void Director::calculateDeltaTime()
 {
+    if (_headless)
+    {
+        // simulated time only: the same inputs always give the same steps
+        _deltaTime = _fixedTimeStep > 0 ? _fixedTimeStep : (float)_animationInterval;
+        return;
+    }
+
     struct timeval now;
 
     if (gettimeofday(&now, nullptr) != 0)
@@ -566,6 +659,7 @@ void Director::purgeCachedData(void)
         log("%s\n", _textureCache->getCachedTextureInfo().c_str());
     }
     FileUtils::getInstance()->purgeCachedEntries();
+    SlabAllocator::getInstance()->purge();
 }
 
 float Director::getZEye(void) const
@@ -835,6 +929,8 @@ void Director::purgeDirector()
 
     // purge all managed caches
     DrawPrimitives::free();
+    PoseBatch::destroyInstance();
+    JobPool::destroyInstance();
     AnimationCache::destroyInstance();
     SpriteFrameCache::destroyInstance();
     ShaderCache::destroyInstance();
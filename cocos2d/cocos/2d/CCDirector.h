@@ -386,6 +386,41 @@ public:
      */
     float getFrameRate() const { return _frameRate; }
 
+    /** Sets a fixed simulation step, in seconds.
+     When it is greater than 0 the scheduler is always updated with this step: the elapsed frame time
+     is accumulated and as many fixed steps as fit in it are run before drawing, so the simulation
+     no longer depends on the frame rate. 0 (the default) updates the scheduler once per frame with
+     the real delta time.
+     @since v3.0
+     */
+    void setFixedTimeStep(float fixedTimeStep);
+    float getFixedTimeStep() const { return _fixedTimeStep; }
+
+    /** Sets the maximum number of fixed steps run in a single frame. When a frame takes longer than
+     that, the remaining accumulated time is dropped instead of being caught up later. Default is 5.
+     @since v3.0
+     */
+    void setMaxFixedStepsPerFrame(unsigned int maxSteps);
+    unsigned int getMaxFixedStepsPerFrame() const { return _maxFixedStepsPerFrame; }
+
+    /** Fraction of a fixed step that was accumulated but not simulated yet, in the [0, 1) range.
+     Rendering code may use it to interpolate between the two last simulated states.
+     It is always 0 when no fixed time step is set.
+     @since v3.0
+     */
+    float getInterpolationAlpha() const { return _interpolationAlpha; }
+
+    /** Runs the Director without rendering.
+     In headless mode every main loop iteration advances the simulation by exactly one fixed step
+     (or by the animation interval when no fixed step is set) without reading the clock, and nothing
+     is cleared, visited, rendered or presented. Useful for servers, replays and automated tests.
+     It still needs an OpenGL view: textures, shaders and the run loops of the platforms are created
+     and polled through it, so a window (or an offscreen display such as Xvfb) has to exist.
+     @since v3.0
+     */
+    void setHeadless(bool headless);
+    bool isHeadless() const { return _headless; }
+
 protected:
     void purgeDirector();
     bool _purgeDirectorInNextLoop; // this flag will be set to true in end()
@@ -400,6 +435,9 @@ protected:
     /** calculates delta time since last time it was called */    
     void calculateDeltaTime();
 
+    /** updates the scheduler, either once with the delta time or with fixed steps */
+    void updateSimulation();
+
     //textureCache creation or release
     void initTextureCache();
     void destroyTextureCache();
@@ -469,6 +507,16 @@ protected:
 
     /* whether or not the next delta time will be zero */
     bool _nextDeltaTimeZero;
+
+    /* fixed simulation step, 0 when the scheduler is updated with the frame delta time */
+    float _fixedTimeStep;
+    unsigned int _maxFixedStepsPerFrame;
+    /* frame time not consumed by the fixed steps yet */
+    double _accumulatedTime;
+    float _interpolationAlpha;
+
+    /* whether or not the scene is rendered */
+    bool _headless;
     
     /* projection used */
     Projection _projection;
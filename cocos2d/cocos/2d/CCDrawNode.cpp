@@ -101,24 +101,46 @@ static inline Tex2F __t(const Vertex2F &v)
 
 // implementation of DrawNode
 
+// vertices of a chunk are indexed with GLushort
+static const GLsizei MAX_CHUNK_VERTICES = 65536;
+
 DrawNode::DrawNode()
 : _vao(0)
 , _vbo(0)
+, _ibo(0)
 , _bufferCapacity(0)
 , _bufferCount(0)
 , _buffer(nullptr)
+, _indexCapacity(0)
+, _indexCount(0)
+, _indices(nullptr)
+, _staticBufferCount(0)
+, _staticIndexCount(0)
+, _staticChunksCount(1)
+, _vboCapacity(0)
+, _iboCapacity(0)
+, _uploadedBufferCount(0)
+, _uploadedIndexCount(0)
+, _rectangleBufferCount(0)
 , _dirty(false)
 {
     _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+
+    Chunk chunk = {0, 0};
+    _chunks.push_back(chunk);
 }
 
 DrawNode::~DrawNode()
 {
     free(_buffer);
     _buffer = nullptr;
+    free(_indices);
+    _indices = nullptr;
     
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
+    glDeleteBuffers(1, &_ibo);
+    _ibo = 0;
     
     if (Configuration::getInstance()->supportsShareableVAO())
     {
@@ -154,6 +176,69 @@ void DrawNode::ensureCapacity(int count)
 	}
 }
 
+void DrawNode::ensureIndexCapacity(int count)
+{
+    CCASSERT(count>=0, "capacity must be >= 0");
+
+    if(_indexCount + count > _indexCapacity)
+    {
+        _indexCapacity += MAX(_indexCapacity, count);
+        _indices = (GLushort*)realloc(_indices, _indexCapacity*sizeof(GLushort));
+    }
+}
+
+GLushort DrawNode::beginPrimitive(int vertexCount, int indexCount)
+{
+    CCASSERT(vertexCount <= MAX_CHUNK_VERTICES, "DrawNode: primitives bigger than a chunk must be split");
+
+    ensureCapacity(vertexCount);
+    ensureIndexCapacity(indexCount);
+
+    if (_bufferCount == 0)
+    {
+        // the first primitive, drawPolygon() tells whether it is a rectangle
+        _rectangleBufferCount = 0;
+    }
+
+    // a primitive never spans two chunks
+    if (_bufferCount + vertexCount - _chunks.back().firstVertex > MAX_CHUNK_VERTICES)
+    {
+        Chunk chunk = {_bufferCount, _indexCount};
+        _chunks.push_back(chunk);
+    }
+
+    _dirty = true;
+
+    return static_cast<GLushort>(_bufferCount - _chunks.back().firstVertex);
+}
+
+void DrawNode::appendFan(const V2F_C4B_T2F *fan, int count)
+{
+    // a fan that doesn't fit in a chunk is split in several fans around the same center
+    for (int first = 1; first < count - 1; )
+    {
+        int last = MIN(count - 1, first + MAX_CHUNK_VERTICES - 2);
+        int vertexCount = last - first + 2;
+        int indexCount = (last - first) * 3;
+        GLushort base = beginPrimitive(vertexCount, indexCount);
+
+        V2F_C4B_T2F *vertices = _buffer + _bufferCount;
+        GLushort *indices = _indices + _indexCount;
+        vertices[0] = fan[0];
+        memcpy(vertices + 1, fan + first, sizeof(V2F_C4B_T2F) * (last - first + 1));
+        for (int i = 0; i < last - first; i++)
+        {
+            indices[i * 3 + 0] = base;
+            indices[i * 3 + 1] = base + i + 1;
+            indices[i * 3 + 2] = base + i + 2;
+        }
+
+        _bufferCount += vertexCount;
+        _indexCount += indexCount;
+        first = last;
+    }
+}
+
 bool DrawNode::init()
 {
     _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
@@ -161,7 +246,25 @@ bool DrawNode::init()
     setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_LENGTH_TEXTURE_COLOR));
     
     ensureCapacity(512);
+    ensureIndexCapacity(768);
+
+    setupBuffers();
+    
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // Need to listen the event only when not use batchnode, because it will use VBO
+    auto listener = EventListenerCustom::create(EVENT_COME_TO_FOREGROUND, [this](EventCustom* event){
+    /** listen the event that coming to foreground on Android */
+        this->setupBuffers();
+    });
+
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+#endif
     
+    return true;
+}
+
+void DrawNode::setupBuffers()
+{
     if (Configuration::getInstance()->supportsShareableVAO())
     {
         glGenVertexArrays(1, &_vao);
@@ -170,7 +273,7 @@ bool DrawNode::init()
     
     glGenBuffers(1, &_vbo);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(V2F_C4B_T2F)* _bufferCapacity, _buffer, GL_STREAM_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(V2F_C4B_T2F)* _bufferCapacity, nullptr, GL_DYNAMIC_DRAW);
     
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, vertices));
@@ -180,33 +283,78 @@ bool DrawNode::init()
     
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORDS);
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, texCoords));
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, &_ibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * _indexCapacity, nullptr, GL_DYNAMIC_DRAW);
     
     if (Configuration::getInstance()->supportsShareableVAO())
     {
         GL::bindVAO(0);
     }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     
     CHECK_GL_ERROR_DEBUG();
-    
+
+    // the new buffers hold nothing yet
+    _vboCapacity = _bufferCapacity;
+    _iboCapacity = _indexCapacity;
+    _uploadedBufferCount = 0;
+    _uploadedIndexCount = 0;
     _dirty = true;
-    
-#if CC_ENABLE_CACHE_TEXTURE_DATA
-    // Need to listen the event only when not use batchnode, because it will use VBO
-    auto listener = EventListenerCustom::create(EVENT_COME_TO_FOREGROUND, [this](EventCustom* event){
-    /** listen the event that coming to foreground on Android */
-        this->init();
-    });
+}
 
-    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
-#endif
-    
-    return true;
+void DrawNode::uploadBuffers()
+{
+    // Avoid changing the element buffer for whatever VAO might be bound.
+    GL::bindVAO(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    if (_vboCapacity < _bufferCapacity)
+    {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(V2F_C4B_T2F) * _bufferCapacity, nullptr, GL_DYNAMIC_DRAW);
+        _vboCapacity = _bufferCapacity;
+        _uploadedBufferCount = 0;
+    }
+    // only the vertices drawn since the last upload, the static ones are already there
+    if (_bufferCount > _uploadedBufferCount)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(V2F_C4B_T2F) * _uploadedBufferCount,
+                        sizeof(V2F_C4B_T2F) * (_bufferCount - _uploadedBufferCount), _buffer + _uploadedBufferCount);
+        CC_INCREMENT_GL_UPLOADED_BYTES(sizeof(V2F_C4B_T2F) * (_bufferCount - _uploadedBufferCount));
+    }
+    _uploadedBufferCount = _bufferCount;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo);
+    if (_iboCapacity < _indexCapacity)
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * _indexCapacity, nullptr, GL_DYNAMIC_DRAW);
+        _iboCapacity = _indexCapacity;
+        _uploadedIndexCount = 0;
+    }
+    if (_indexCount > _uploadedIndexCount)
+    {
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * _uploadedIndexCount,
+                        sizeof(GLushort) * (_indexCount - _uploadedIndexCount), _indices + _uploadedIndexCount);
+        CC_INCREMENT_GL_UPLOADED_BYTES(sizeof(GLushort) * (_indexCount - _uploadedIndexCount));
+    }
+    _uploadedIndexCount = _indexCount;
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    _dirty = false;
 }
 
 void DrawNode::draw(Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
 {
+    if (_indexCount == 0)
+    {
+        return;
+    }
+
     _customCommand.init(_globalZOrder);
     _customCommand.func = CC_CALLBACK_0(DrawNode::onDraw, this, transform, transformUpdated);
     renderer->addCommand(&_customCommand);
@@ -221,324 +369,409 @@ void DrawNode::onDraw(const kmMat4 &transform, bool transformUpdated)
 
     if (_dirty)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(V2F_C4B_T2F)*_bufferCapacity, _buffer, GL_STREAM_DRAW);
-        _dirty = false;
+        uploadBuffers();
     }
-    if (Configuration::getInstance()->supportsShareableVAO())
+
+    bool useVAO = Configuration::getInstance()->supportsShareableVAO();
+    if (useVAO)
     {
         GL::bindVAO(_vao);
     }
     else
     {
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
 
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-        // vertex
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, vertices));
+    for (size_t i = 0; i < _chunks.size(); ++i)
+    {
+        const Chunk& chunk = _chunks[i];
+        GLsizei indexCount = (i + 1 < _chunks.size() ? _chunks[i + 1].firstIndex : _indexCount) - chunk.firstIndex;
+        if (indexCount == 0)
+        {
+            continue;
+        }
 
-        // color
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, colors));
+        // the VAO keeps pointing at the first chunk, the other ones need their own pointers
+        if (! useVAO || chunk.firstVertex != 0)
+        {
+            size_t offset = sizeof(V2F_C4B_T2F) * chunk.firstVertex;
+            // vertex
+            glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)(offset + offsetof(V2F_C4B_T2F, vertices)));
+
+            // color
+            glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V2F_C4B_T2F), (GLvoid *)(offset + offsetof(V2F_C4B_T2F, colors)));
+
+            // texcood
+            glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)(offset + offsetof(V2F_C4B_T2F, texCoords)));
+        }
+
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, (GLvoid *)(sizeof(GLushort) * chunk.firstIndex));
+    }
 
-        // texcood
+    if (useVAO && _chunks.size() > 1)
+    {
+        // restore the pointers of the first chunk
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, vertices));
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, colors));
         glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, sizeof(V2F_C4B_T2F), (GLvoid *)offsetof(V2F_C4B_T2F, texCoords));
     }
 
-    glDrawArrays(GL_TRIANGLES, 0, _bufferCount);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (! useVAO)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
 
-    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1,_bufferCount);
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(_chunks.size(), _indexCount);
     CHECK_GL_ERROR_DEBUG();
 }
 
 void DrawNode::drawDot(const Point &pos, float radius, const Color4F &color)
 {
-    unsigned int vertex_count = 2*3;
-    ensureCapacity(vertex_count);
-	
-	V2F_C4B_T2F a = {Vertex2F(pos.x - radius, pos.y - radius), Color4B(color), Tex2F(-1.0, -1.0) };
-	V2F_C4B_T2F b = {Vertex2F(pos.x - radius, pos.y + radius), Color4B(color), Tex2F(-1.0,  1.0) };
-	V2F_C4B_T2F c = {Vertex2F(pos.x + radius, pos.y + radius), Color4B(color), Tex2F( 1.0,  1.0) };
-	V2F_C4B_T2F d = {Vertex2F(pos.x + radius, pos.y - radius), Color4B(color), Tex2F( 1.0, -1.0) };
-	
-	V2F_C4B_T2F_Triangle *triangles = (V2F_C4B_T2F_Triangle *)(_buffer + _bufferCount);
-    V2F_C4B_T2F_Triangle triangle0 = {a, b, c};
-    V2F_C4B_T2F_Triangle triangle1 = {a, c, d};
-	triangles[0] = triangle0;
-	triangles[1] = triangle1;
-	
-	_bufferCount += vertex_count;
-	
-	_dirty = true;
+    GLushort base = beginPrimitive(4, 6);
+    Color4B col = Color4B(color);
+
+    V2F_C4B_T2F *vertices = _buffer + _bufferCount;
+    V2F_C4B_T2F a = {Vertex2F(pos.x - radius, pos.y - radius), col, Tex2F(-1.0, -1.0) };
+    V2F_C4B_T2F b = {Vertex2F(pos.x - radius, pos.y + radius), col, Tex2F(-1.0,  1.0) };
+    V2F_C4B_T2F c = {Vertex2F(pos.x + radius, pos.y + radius), col, Tex2F( 1.0,  1.0) };
+    V2F_C4B_T2F d = {Vertex2F(pos.x + radius, pos.y - radius), col, Tex2F( 1.0, -1.0) };
+    vertices[0] = a;
+    vertices[1] = b;
+    vertices[2] = c;
+    vertices[3] = d;
+
+    static const GLushort QUAD_INDICES[] = {0, 1, 2, 0, 2, 3};
+    GLushort *indices = _indices + _indexCount;
+    for (int i = 0; i < 6; ++i)
+    {
+        indices[i] = base + QUAD_INDICES[i];
+    }
+
+    _bufferCount += 4;
+    _indexCount += 6;
 }
 
 void DrawNode::drawSegment(const Point &from, const Point &to, float radius, const Color4F &color)
 {
-    unsigned int vertex_count = 6*3;
-    ensureCapacity(vertex_count);
-	
+    GLushort base = beginPrimitive(8, 18);
+    Color4B col = Color4B(color);
+
 	Vertex2F a = __v2f(from);
 	Vertex2F b = __v2f(to);
 	
-	
 	Vertex2F n = v2fnormalize(v2fperp(v2fsub(b, a)));
 	Vertex2F t = v2fperp(n);
 	
 	Vertex2F nw = v2fmult(n, radius);
 	Vertex2F tw = v2fmult(t, radius);
-	Vertex2F v0 = v2fsub(b, v2fadd(nw, tw));
-	Vertex2F v1 = v2fadd(b, v2fsub(nw, tw));
-	Vertex2F v2 = v2fsub(b, nw);
-	Vertex2F v3 = v2fadd(b, nw);
-	Vertex2F v4 = v2fsub(a, nw);
-	Vertex2F v5 = v2fadd(a, nw);
-	Vertex2F v6 = v2fsub(a, v2fsub(nw, tw));
-	Vertex2F v7 = v2fadd(a, v2fadd(nw, tw));
-	
-	
-	V2F_C4B_T2F_Triangle *triangles = (V2F_C4B_T2F_Triangle *)(_buffer + _bufferCount);
-	
-    V2F_C4B_T2F_Triangle triangles0 = {
-        {v0, Color4B(color), __t(v2fneg(v2fadd(n, t)))},
-        {v1, Color4B(color), __t(v2fsub(n, t))},
-        {v2, Color4B(color), __t(v2fneg(n))},
-    };
-	triangles[0] = triangles0;
-	
-    V2F_C4B_T2F_Triangle triangles1 = {
-        {v3, Color4B(color), __t(n)},
-        {v1, Color4B(color), __t(v2fsub(n, t))},
-        {v2, Color4B(color), __t(v2fneg(n))},
-    };
-	triangles[1] = triangles1;
-	
-    V2F_C4B_T2F_Triangle triangles2 = {
-        {v3, Color4B(color), __t(n)},
-        {v4, Color4B(color), __t(v2fneg(n))},
-        {v2, Color4B(color), __t(v2fneg(n))},
-    };
-	triangles[2] = triangles2;
-
-    V2F_C4B_T2F_Triangle triangles3 = {
-        {v3, Color4B(color), __t(n)},
-        {v4, Color4B(color), __t(v2fneg(n))},
-        {v5, Color4B(color), __t(n) },
-    };
-    triangles[3] = triangles3;
 
-    V2F_C4B_T2F_Triangle triangles4 = {
-        {v6, Color4B(color), __t(v2fsub(t, n))},
-        {v4, Color4B(color), __t(v2fneg(n)) },
-        {v5, Color4B(color), __t(n)},
+    // the rounded caps are drawn by the shader from the texture coordinates
+    V2F_C4B_T2F *vertices = _buffer + _bufferCount;
+    V2F_C4B_T2F v0 = {v2fsub(b, v2fadd(nw, tw)), col, __t(v2fneg(v2fadd(n, t)))};
+    V2F_C4B_T2F v1 = {v2fadd(b, v2fsub(nw, tw)), col, __t(v2fsub(n, t))};
+    V2F_C4B_T2F v2 = {v2fsub(b, nw), col, __t(v2fneg(n))};
+    V2F_C4B_T2F v3 = {v2fadd(b, nw), col, __t(n)};
+    V2F_C4B_T2F v4 = {v2fsub(a, nw), col, __t(v2fneg(n))};
+    V2F_C4B_T2F v5 = {v2fadd(a, nw), col, __t(n)};
+    V2F_C4B_T2F v6 = {v2fsub(a, v2fsub(nw, tw)), col, __t(v2fsub(t, n))};
+    V2F_C4B_T2F v7 = {v2fadd(a, v2fadd(nw, tw)), col, __t(v2fadd(n, t))};
+    vertices[0] = v0;
+    vertices[1] = v1;
+    vertices[2] = v2;
+    vertices[3] = v3;
+    vertices[4] = v4;
+    vertices[5] = v5;
+    vertices[6] = v6;
+    vertices[7] = v7;
+
+    static const GLushort SEGMENT_INDICES[] = {
+        0, 1, 2,
+        3, 1, 2,
+        3, 4, 2,
+        3, 4, 5,
+        6, 4, 5,
+        6, 7, 5,
     };
-	triangles[4] = triangles4;
+    GLushort *indices = _indices + _indexCount;
+    for (int i = 0; i < 18; ++i)
+    {
+        indices[i] = base + SEGMENT_INDICES[i];
+    }
 
-    V2F_C4B_T2F_Triangle triangles5 = {
-        {v6, Color4B(color), __t(v2fsub(t, n))},
-        {v7, Color4B(color), __t(v2fadd(n, t))},
-        {v5, Color4B(color), __t(n)},
-    };
-	triangles[5] = triangles5;
-	
-	_bufferCount += vertex_count;
-	
-	_dirty = true;
+    _bufferCount += 8;
+    _indexCount += 18;
 }
 
 void DrawNode::drawPolygon(Point *verts, int count, const Color4F &fillColor, float borderWidth, const Color4F &borderColor)
 {
     CCASSERT(count >= 0, "invalid count value");
 
-    struct ExtrudeVerts {Vertex2F offset, n;};
-	struct ExtrudeVerts* extrude = (struct ExtrudeVerts*)malloc(sizeof(struct ExtrudeVerts)*count);
-	memset(extrude, 0, sizeof(struct ExtrudeVerts)*count);
-	
-	for (int i = 0; i < count; i++)
-    {
-		Vertex2F v0 = __v2f(verts[(i-1+count)%count]);
-		Vertex2F v1 = __v2f(verts[i]);
-		Vertex2F v2 = __v2f(verts[(i+1)%count]);
-        
-		Vertex2F n1 = v2fnormalize(v2fperp(v2fsub(v1, v0)));
-		Vertex2F n2 = v2fnormalize(v2fperp(v2fsub(v2, v1)));
-		
-		Vertex2F offset = v2fmult(v2fadd(n1, n2), 1.0/(v2fdot(n1, n2) + 1.0));
-        struct ExtrudeVerts tmp = {offset, n2};
-		extrude[i] = tmp;
-	}
-	
 	bool outline = (borderColor.a > 0.0 && borderWidth > 0.0);
-	
-	auto triangle_count = 3*count - 2;
-	auto vertex_count = 3*triangle_count;
-    ensureCapacity(vertex_count);
-	
-	V2F_C4B_T2F_Triangle *triangles = (V2F_C4B_T2F_Triangle *)(_buffer + _bufferCount);
-	V2F_C4B_T2F_Triangle *cursor = triangles;
-	
-	float inset = (outline == false ? 0.5 : 0.0);
-	for (int i = 0; i < count-2; i++)
-    {
-		Vertex2F v0 = v2fsub(__v2f(verts[0  ]), v2fmult(extrude[0  ].offset, inset));
-		Vertex2F v1 = v2fsub(__v2f(verts[i+1]), v2fmult(extrude[i+1].offset, inset));
-		Vertex2F v2 = v2fsub(__v2f(verts[i+2]), v2fmult(extrude[i+2].offset, inset));
-		
-        V2F_C4B_T2F_Triangle tmp = {
-            {v0, Color4B(fillColor), __t(v2fzero)},
-            {v1, Color4B(fillColor), __t(v2fzero)},
-            {v2, Color4B(fillColor), __t(v2fzero)},
-        };
-
-		*cursor++ = tmp;
-	}
-	
-	for(int i = 0; i < count; i++)
-    {
-		int j = (i+1)%count;
-		Vertex2F v0 = __v2f(verts[i]);
-		Vertex2F v1 = __v2f(verts[j]);
-		
-		Vertex2F n0 = extrude[i].n;
-		
-		Vertex2F offset0 = extrude[i].offset;
-		Vertex2F offset1 = extrude[j].offset;
-		
-		if(outline)
+    float inset = (outline == false ? 0.5f : 0.0f);
+    float width = (outline ? borderWidth : 0.5f);
+
+    // too few points to cover an area: only the border is drawn, as a dot or a segment
+    if (count < 3)
+    {
+        if (count == 1)
         {
-			Vertex2F inner0 = v2fsub(v0, v2fmult(offset0, borderWidth));
-			Vertex2F inner1 = v2fsub(v1, v2fmult(offset1, borderWidth));
-			Vertex2F outer0 = v2fadd(v0, v2fmult(offset0, borderWidth));
-			Vertex2F outer1 = v2fadd(v1, v2fmult(offset1, borderWidth));
-			
-            V2F_C4B_T2F_Triangle tmp1 = {
-                {inner0, Color4B(borderColor), __t(v2fneg(n0))},
-                {inner1, Color4B(borderColor), __t(v2fneg(n0))},
-                {outer1, Color4B(borderColor), __t(n0)}
-            };
-			*cursor++ = tmp1;
-
-            V2F_C4B_T2F_Triangle tmp2 = {
-                {inner0, Color4B(borderColor), __t(v2fneg(n0))},
-                {outer0, Color4B(borderColor), __t(n0)},
-                {outer1, Color4B(borderColor), __t(n0)}
-            };
-			*cursor++ = tmp2;
-		}
-        else {
-			Vertex2F inner0 = v2fsub(v0, v2fmult(offset0, 0.5));
-			Vertex2F inner1 = v2fsub(v1, v2fmult(offset1, 0.5));
-			Vertex2F outer0 = v2fadd(v0, v2fmult(offset0, 0.5));
-			Vertex2F outer1 = v2fadd(v1, v2fmult(offset1, 0.5));
-			
-            V2F_C4B_T2F_Triangle tmp1 = {
-                {inner0, Color4B(fillColor), __t(v2fzero)},
-                {inner1, Color4B(fillColor), __t(v2fzero)},
-                {outer1, Color4B(fillColor), __t(n0)}
-            };
-			*cursor++ = tmp1;
-
-            V2F_C4B_T2F_Triangle tmp2 = {
-                {inner0, Color4B(fillColor), __t(v2fzero)},
-                {outer0, Color4B(fillColor), __t(n0)},
-                {outer1, Color4B(fillColor), __t(n0)}
-            };
-			*cursor++ = tmp2;
-		}
-	}
-	
-	_bufferCount += vertex_count;
-	
-	_dirty = true;
+            drawDot(verts[0], width, outline ? borderColor : fillColor);
+        }
+        else if (count == 2)
+        {
+            drawSegment(verts[0], verts[1], width, outline ? borderColor : fillColor);
+        }
+        return;
+    }
+
+    // edge normals and vertex extrusions in separate arrays, so that the loops below can be vectorized
+    _extrude.resize(count * 6);
+    float *px = &_extrude[0];
+    float *py = px + count;
+    float *nx = py + count;
+    float *ny = nx + count;
+    float *ox = ny + count;
+    float *oy = ox + count;
 
-    free(extrude);
+    for (int i = 0; i < count; i++)
+    {
+        px[i] = verts[i].x;
+        py[i] = verts[i].y;
+    }
+
+    // normal of the edge from vertex i to vertex i+1
+    for (int i = 0; i < count - 1; i++)
+    {
+        float dx = px[i + 1] - px[i];
+        float dy = py[i + 1] - py[i];
+        float length = sqrtf(dx * dx + dy * dy);
+        // a zero length edge (repeated point) gets the (1, 0) normal, as Point::normalize() gives
+        float invLength = length > 0 ? 1.0f / length : 0.0f;
+        nx[i] = length > 0 ? -dy * invLength : 1.0f;
+        ny[i] = dx * invLength;
+    }
+    {
+        float dx = px[0] - px[count - 1];
+        float dy = py[0] - py[count - 1];
+        float length = sqrtf(dx * dx + dy * dy);
+        float invLength = length > 0 ? 1.0f / length : 0.0f;
+        nx[count - 1] = length > 0 ? -dy * invLength : 1.0f;
+        ny[count - 1] = dx * invLength;
+    }
+
+    // extrusion of vertex i, along the normals of the edges around it
+    {
+        float dot = nx[count - 1] * nx[0] + ny[count - 1] * ny[0];
+        float scale = 1.0f / (dot + 1.0f);
+        ox[0] = (nx[count - 1] + nx[0]) * scale;
+        oy[0] = (ny[count - 1] + ny[0]) * scale;
+    }
+    for (int i = 1; i < count; i++)
+    {
+        float dot = nx[i - 1] * nx[i] + ny[i - 1] * ny[i];
+        float scale = 1.0f / (dot + 1.0f);
+        ox[i] = (nx[i - 1] + nx[i]) * scale;
+        oy[i] = (ny[i - 1] + ny[i]) * scale;
+    }
+
+    Color4B fill = Color4B(fillColor);
+    Color4B border = outline ? Color4B(borderColor) : fill;
+    bool firstPrimitive = (_bufferCount == 0);
+
+    // the fill, a fan around the first vertex
+    _fanVertices.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        V2F_C4B_T2F tmp = {Vertex2F(px[i] - ox[i] * inset, py[i] - oy[i] * inset), fill, __t(v2fzero)};
+        _fanVertices[i] = tmp;
+    }
+    appendFan(&_fanVertices[0], count);
+
+    // 4 vertices per edge for the border or the antialiasing, in as many chunks as needed
+    const int edgesPerChunk = MAX_CHUNK_VERTICES / 4;
+    for (int firstEdge = 0; firstEdge < count; firstEdge += edgesPerChunk)
+    {
+        int edges = MIN(count - firstEdge, edgesPerChunk);
+        GLushort base = beginPrimitive(edges * 4, edges * 6);
+
+        V2F_C4B_T2F *vertices = _buffer + _bufferCount;
+        GLushort *indices = _indices + _indexCount;
+        for (int e = 0; e < edges; e++)
+        {
+            int i = firstEdge + e;
+            int j = (i + 1 == count ? 0 : i + 1);
+            Vertex2F n0 = Vertex2F(nx[i], ny[i]);
+            // without a border, the inner side keeps the fill color and no fading
+            Tex2F innerTex = outline ? __t(v2fneg(n0)) : __t(v2fzero);
+
+            V2F_C4B_T2F inner0 = {Vertex2F(px[i] - ox[i] * width, py[i] - oy[i] * width), border, innerTex};
+            V2F_C4B_T2F inner1 = {Vertex2F(px[j] - ox[j] * width, py[j] - oy[j] * width), border, innerTex};
+            V2F_C4B_T2F outer0 = {Vertex2F(px[i] + ox[i] * width, py[i] + oy[i] * width), border, __t(n0)};
+            V2F_C4B_T2F outer1 = {Vertex2F(px[j] + ox[j] * width, py[j] + oy[j] * width), border, __t(n0)};
+            vertices[e * 4 + 0] = inner0;
+            vertices[e * 4 + 1] = inner1;
+            vertices[e * 4 + 2] = outer0;
+            vertices[e * 4 + 3] = outer1;
+
+            GLushort first = base + e * 4;
+            indices[e * 6 + 0] = first;
+            indices[e * 6 + 1] = first + 1;
+            indices[e * 6 + 2] = first + 3;
+            indices[e * 6 + 3] = first;
+            indices[e * 6 + 4] = first + 2;
+            indices[e * 6 + 5] = first + 3;
+        }
+
+        _bufferCount += edges * 4;
+        _indexCount += edges * 6;
+    }
+
+    if (firstPrimitive && count == 4)
+    {
+        // axis aligned when each edge is either horizontal or vertical
+        bool rectangle = true;
+        for (int i = 0; i < count && rectangle; i++)
+        {
+            int j = (i + 1 == count ? 0 : i + 1);
+            rectangle = (px[i] == px[j]) != (py[i] == py[j]);
+        }
+        if (rectangle)
+        {
+            float minX = MIN(MIN(px[0], px[1]), px[2]);
+            float minY = MIN(MIN(py[0], py[1]), py[2]);
+            float maxX = MAX(MAX(px[0], px[1]), px[2]);
+            float maxY = MAX(MAX(py[0], py[1]), py[2]);
+            // the corners are extruded by width along both axes
+            _rectangle.setRect(minX - width, minY - width, maxX - minX + width * 2, maxY - minY + width * 2);
+            _rectangleBufferCount = _bufferCount;
+        }
+    }
 }
 
 void DrawNode::drawTriangle(const Point &p1, const Point &p2, const Point &p3, const Color4F &color)
 {
-    unsigned int vertex_count = 2*3;
-    ensureCapacity(vertex_count);
+    GLushort base = beginPrimitive(3, 3);
 
     Color4B col = Color4B(color);
     V2F_C4B_T2F a = {Vertex2F(p1.x, p1.y), col, Tex2F(0.0, 0.0) };
     V2F_C4B_T2F b = {Vertex2F(p2.x, p2.y), col, Tex2F(0.0,  0.0) };
     V2F_C4B_T2F c = {Vertex2F(p3.x, p3.y), col, Tex2F(0.0,  0.0) };
 
-    V2F_C4B_T2F_Triangle *triangles = (V2F_C4B_T2F_Triangle *)(_buffer + _bufferCount);
-    V2F_C4B_T2F_Triangle triangle = {a, b, c};
-    triangles[0] = triangle;
+    V2F_C4B_T2F *vertices = _buffer + _bufferCount;
+    vertices[0] = a;
+    vertices[1] = b;
+    vertices[2] = c;
 
-    _bufferCount += vertex_count;
-    _dirty = true;
+    GLushort *indices = _indices + _indexCount;
+    indices[0] = base;
+    indices[1] = base + 1;
+    indices[2] = base + 2;
+
+    _bufferCount += 3;
+    _indexCount += 3;
 }
 
 void DrawNode::drawCubicBezier(const Point& from, const Point& control1, const Point& control2, const Point& to, unsigned int segments, const Color4F &color)
 {
-    unsigned int vertex_count = (segments + 1) * 3;
-    ensureCapacity(vertex_count);
+    // a fan around the first point: the first point, the last one, then the points of the curve
+    _fanVertices.resize(segments + 3);
 
     Tex2F texCoord = Tex2F(0.0, 0.0);
     Color4B col = Color4B(color);
-    Vertex2F vertex;
-    Vertex2F firstVertex = Vertex2F(from.x, from.y);
-    Vertex2F lastVertex = Vertex2F(to.x, to.y);
+
+    V2F_C4B_T2F first = {Vertex2F(from.x, from.y), col, texCoord};
+    V2F_C4B_T2F last = {Vertex2F(to.x, to.y), col, texCoord};
+    _fanVertices[0] = first;
+    _fanVertices[1] = last;
 
     float t = 0;
-    for(unsigned int i = segments + 1; i > 0; i--)
+    for(unsigned int i = 0; i <= segments; i++)
     {
         float x = powf(1 - t, 3) * from.x + 3.0f * powf(1 - t, 2) * t * control1.x + 3.0f * (1 - t) * t * t * control2.x + t * t * t * to.x;
         float y = powf(1 - t, 3) * from.y + 3.0f * powf(1 - t, 2) * t * control1.y + 3.0f * (1 - t) * t * t * control2.y + t * t * t * to.y;
-        vertex = Vertex2F(x, y);
-
-        V2F_C4B_T2F a = {firstVertex, col, texCoord };
-        V2F_C4B_T2F b = {lastVertex, col, texCoord };
-        V2F_C4B_T2F c = {vertex, col, texCoord };
-        V2F_C4B_T2F_Triangle triangle = {a, b, c};
-        ((V2F_C4B_T2F_Triangle *)(_buffer + _bufferCount))[0] = triangle;
+        V2F_C4B_T2F vertex = {Vertex2F(x, y), col, texCoord};
+        _fanVertices[i + 2] = vertex;
 
-        lastVertex = vertex;
         t += 1.0f / segments;
-        _bufferCount += 3;
     }
-    _dirty = true;
+
+    appendFan(&_fanVertices[0], segments + 3);
 }
 
 void DrawNode::drawQuadraticBezier(const Point& from, const Point& control, const Point& to, unsigned int segments, const Color4F &color)
 {
-    unsigned int vertex_count = (segments + 1) * 3;
-    ensureCapacity(vertex_count);
+    // a fan around the first point: the first point, the last one, then the points of the curve
+    _fanVertices.resize(segments + 3);
 
     Tex2F texCoord = Tex2F(0.0, 0.0);
     Color4B col = Color4B(color);
-    Vertex2F vertex;
-    Vertex2F firstVertex = Vertex2F(from.x, from.y);
-    Vertex2F lastVertex = Vertex2F(to.x, to.y);
+
+    V2F_C4B_T2F first = {Vertex2F(from.x, from.y), col, texCoord};
+    V2F_C4B_T2F last = {Vertex2F(to.x, to.y), col, texCoord};
+    _fanVertices[0] = first;
+    _fanVertices[1] = last;
 
     float t = 0;
-    for(unsigned int i = segments + 1; i > 0; i--)
+    for(unsigned int i = 0; i <= segments; i++)
     {
         float x = powf(1 - t, 2) * from.x + 2.0f * (1 - t) * t * control.x + t * t * to.x;
         float y = powf(1 - t, 2) * from.y + 2.0f * (1 - t) * t * control.y + t * t * to.y;
-        vertex = Vertex2F(x, y);
+        V2F_C4B_T2F vertex = {Vertex2F(x, y), col, texCoord};
+        _fanVertices[i + 2] = vertex;
 
-        V2F_C4B_T2F a = {firstVertex, col, texCoord };
-        V2F_C4B_T2F b = {lastVertex, col, texCoord };
-        V2F_C4B_T2F c = {vertex, col, texCoord };
-        V2F_C4B_T2F_Triangle triangle = {a, b, c};
-        ((V2F_C4B_T2F_Triangle *)(_buffer + _bufferCount))[0] = triangle;
-
-        lastVertex = vertex;
         t += 1.0f / segments;
-        _bufferCount += 3;
     }
-    _dirty = true;
+
+    appendFan(&_fanVertices[0], segments + 3);
 }
 
 void DrawNode::clear()
 {
-    _bufferCount = 0;
+    _bufferCount = _staticBufferCount;
+    _indexCount = _staticIndexCount;
+    _chunks.resize(_staticChunksCount);
+
+    // the static geometry is still in the GPU buffers
+    _uploadedBufferCount = MIN(_uploadedBufferCount, _bufferCount);
+    _uploadedIndexCount = MIN(_uploadedIndexCount, _indexCount);
+
     _dirty = true;
 }
 
+void DrawNode::commitStaticGeometry()
+{
+    _staticBufferCount = _bufferCount;
+    _staticIndexCount = _indexCount;
+    _staticChunksCount = _chunks.size();
+}
+
+void DrawNode::clearStaticGeometry()
+{
+    _staticBufferCount = 0;
+    _staticIndexCount = 0;
+    _staticChunksCount = 1;
+
+    clear();
+}
+
+bool DrawNode::isRectangle(Rect* rect) const
+{
+    // anything drawn after the rectangle changes the vertex count
+    if (_rectangleBufferCount == 0 || _rectangleBufferCount != _bufferCount)
+    {
+        return false;
+    }
+
+    if (rect)
+    {
+        *rect = _rectangle;
+    }
+    return true;
+}
+
 const BlendFunc& DrawNode::getBlendFunc() const
 {
     return _blendFunc;
@@ -34,6 +34,7 @@
 #include "CCNode.h"
 #include "ccTypes.h"
 #include "renderer/CCCustomCommand.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -73,8 +74,23 @@ public:
     /** draw a quadratic bezier curve with color and number of segments */
     void drawQuadraticBezier(const Point& from, const Point& control, const Point& to, unsigned int segments, const Color4F &color);
     
-    /** Clear the geometry in the node's buffer. */
+    /** Clear the geometry in the node's buffer. The static geometry is kept, see commitStaticGeometry(). */
     void clear();
+
+    /** Makes everything drawn so far static: clear() keeps it, and it is uploaded to the GPU only once.
+     Useful when the node has a fixed background (the frame of a minimap, a grid...) and an overlay
+     that is cleared and drawn again every frame.
+     */
+    void commitStaticGeometry();
+
+    /** Clears all the geometry, the static one included */
+    void clearStaticGeometry();
+
+    /** Whether the only thing drawn is an axis aligned rectangle, with drawPolygon().
+     In that case rect is set to the area it covers, border included.
+     ClippingNode uses it to clip with a scissor instead of the stencil buffer.
+     */
+    bool isRectangle(Rect* rect) const;
     /**
     * @js NA
     * @lua NA
@@ -100,15 +116,55 @@ CC_CONSTRUCTOR_ACCESS:
     virtual bool init();
 
 protected:
+    /** The vertices of a chunk are indexed with GLushort, relative to its first vertex */
+    struct Chunk
+    {
+        GLsizei firstVertex;
+        GLsizei firstIndex;
+    };
+
     void ensureCapacity(int count);
+    void ensureIndexCapacity(int count);
+    /** reserves room for a primitive, returns the index of its first vertex in the current chunk */
+    GLushort beginPrimitive(int vertexCount, int indexCount);
+    /** appends the triangles (fan[0], fan[i], fan[i + 1]), over as many chunks as needed */
+    void appendFan(const V2F_C4B_T2F *fan, int count);
+    void setupBuffers();
+    void uploadBuffers();
 
     GLuint      _vao;
     GLuint      _vbo;
+    GLuint      _ibo;
 
     int         _bufferCapacity;
     GLsizei     _bufferCount;
     V2F_C4B_T2F *_buffer;
 
+    int         _indexCapacity;
+    GLsizei     _indexCount;
+    GLushort    *_indices;
+
+    std::vector<Chunk> _chunks;
+
+    //! vertices, indices and chunks kept by clear()
+    GLsizei     _staticBufferCount;
+    GLsizei     _staticIndexCount;
+    size_t      _staticChunksCount;
+
+    //! sizes of the GPU buffers, and how many vertices and indices they hold
+    int         _vboCapacity;
+    int         _iboCapacity;
+    GLsizei     _uploadedBufferCount;
+    GLsizei     _uploadedIndexCount;
+
+    //! number of vertices when the only primitive is the rectangle _rect, 0 otherwise
+    GLsizei     _rectangleBufferCount;
+    Rect        _rectangle;
+
+    //! scratch buffers of drawPolygon() and of the bezier curves
+    std::vector<float> _extrude;
+    std::vector<V2F_C4B_T2F> _fanVertices;
+
     BlendFunc   _blendFunc;
     CustomCommand _customCommand;
 
@@ -26,11 +26,13 @@
 #define __cocos2d_libs__CCCustomEvent__
 
 #include "CCEvent.h"
+#include "CCSlabAllocator.h"
 
 NS_CC_BEGIN
 
 class EventCustom : public Event
 {
+    CC_SLAB_ALLOCATED
 public:
     /** Constructor */
     EventCustom(const std::string& eventName);
@@ -39,4 +39,9 @@
 // This message is posted in cocos2dx/platform/android/jni/MessageJni.cpp.
 #define EVENT_COME_TO_BACKGROUND    "event_come_to_background"
 
+// A texture was removed from the TextureCache to stay in its memory budget.
+// The user data of the EventCustom is the key of the texture, a const std::string*.
+// This message is posted in CCTextureCache.cpp.
+#define EVENT_TEXTURE_EVICTED       "event_texture_evicted"
+
 #endif // __CCEVENT_TYPE_H__
@@ -87,6 +87,7 @@ public:
     static const char* SHADER_NAME_POSITION_COLOR;
     static const char* SHADER_NAME_POSITION_COLOR_NO_MVP;
     static const char* SHADER_NAME_POSITION_TEXTURE;
+    static const char* SHADER_NAME_POSITION_TEXTURE_GRID;
     static const char* SHADER_NAME_POSITION_TEXTURE_U_COLOR;
     static const char* SHADER_NAME_POSITION_TEXTURE_A8_COLOR;
     static const char* SHADER_NAME_POSITION_U_COLOR;
@@ -114,6 +115,7 @@ public:
     static const char* ATTRIBUTE_NAME_COLOR;
     static const char* ATTRIBUTE_NAME_POSITION;
     static const char* ATTRIBUTE_NAME_TEX_COORD;
+    static const char* ATTRIBUTE_NAME_GRID_COORD;
     /**
      * @js ctor
      */
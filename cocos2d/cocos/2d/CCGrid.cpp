@@ -34,6 +34,9 @@ THE SOFTWARE.
 #include "CCGL.h"
 #include "renderer/CCRenderer.h"
 #include "TransformUtils.h"
+#include "CCEventType.h"
+#include "CCEventDispatcher.h"
+#include "CCEventListenerCustom.h"
 
 #include "kazmath/kazmath.h"
 #include "kazmath/GL/matrix.h"
@@ -302,8 +305,14 @@ Grid3D::Grid3D()
     , _vertices(nullptr)
     , _originalVertices(nullptr)
     , _indices(nullptr)
+    , _vertexEffect(VertexEffect::NONE)
+    , _vertexEffectBuffersDirty(true)
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    , _backToForegroundlistener(nullptr)
+#endif
 {
-
+    memset(_vertexEffectUniforms, 0, sizeof(_vertexEffectUniforms));
+    memset(_vertexEffectBuffers, 0, sizeof(_vertexEffectBuffers));
 }
 
 Grid3D::~Grid3D(void)
@@ -312,10 +321,140 @@ Grid3D::~Grid3D(void)
     CC_SAFE_FREE(_vertices);
     CC_SAFE_FREE(_indices);
     CC_SAFE_FREE(_originalVertices);
+
+    if (_vertexEffectBuffers[0])
+    {
+        glDeleteBuffers(2, _vertexEffectBuffers);
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    if (_backToForegroundlistener)
+    {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundlistener);
+    }
+#endif
+}
+
+void Grid3D::setVertexEffect(VertexEffect effect, float phase, float amplitude, float param0, float param1, float param2)
+{
+    _vertexEffect = effect;
+
+    _vertexEffectUniforms[0] = (GLfloat)effect;
+    _vertexEffectUniforms[1] = phase;
+    _vertexEffectUniforms[2] = amplitude;
+    _vertexEffectUniforms[3] = 0;
+    _vertexEffectUniforms[4] = param0;
+    _vertexEffectUniforms[5] = param1;
+    _vertexEffectUniforms[6] = param2;
+    _vertexEffectUniforms[7] = 0;
+}
+
+bool Grid3D::isVertexEffectSupported() const
+{
+    return _shaderProgram == ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE);
+}
+
+void Grid3D::setupVertexEffectBuffers()
+{
+    if (!_vertexEffectBuffers[0])
+    {
+        glGenBuffers(2, _vertexEffectBuffers);
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+        if (!_backToForegroundlistener)
+        {
+            // the buffers are lost with the context, create them again when they are needed
+            _backToForegroundlistener = EventListenerCustom::create(EVENT_COME_TO_FOREGROUND, [this](EventCustom* event){
+                memset(_vertexEffectBuffers, 0, sizeof(_vertexEffectBuffers));
+                _vertexEffectBuffersDirty = true;
+            });
+            Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundlistener, -1);
+        }
+#endif
+    }
+
+    // original position, texCoords and grid coordinates of each vertex, interleaved.
+    // They only change with calculateVertexPoints() or reuse(), not every frame.
+    int width = _gridSize.width + 1;
+    int height = _gridSize.height + 1;
+    unsigned int numOfPoints = width * height;
+    std::vector<GLfloat> vertices(numOfPoints * 7);
+
+    const GLfloat *vertArray = (GLfloat*)_originalVertices;
+    const GLfloat *texArray = (GLfloat*)_texCoordinates;
+    GLfloat *dst = vertices.data();
+    for (int x = 0; x < width; ++x)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            memcpy(dst, vertArray, 3 * sizeof(GLfloat));
+            memcpy(dst + 3, texArray, 2 * sizeof(GLfloat));
+            dst[5] = (GLfloat)x;
+            dst[6] = (GLfloat)y;
+
+            dst += 7;
+            vertArray += 3;
+            texArray += 2;
+        }
+    }
+
+    GLsizeiptr indicesSize = _gridSize.width * _gridSize.height * 6 * sizeof(GLushort);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexEffectBuffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vertexEffectBuffers[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, _indices, GL_STATIC_DRAW);
+    CC_INCREMENT_GL_UPLOADED_BYTES(vertices.size() * sizeof(GLfloat) + indicesSize);
+
+    _vertexEffectBuffersDirty = false;
+}
+
+void Grid3D::blitVertexEffect()
+{
+    int n = _gridSize.width * _gridSize.height;
+
+    GLProgram *program = ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_GRID);
+    program->use();
+    program->setUniformsForBuiltins();
+    program->setUniformLocationWith4fv(program->getUniformLocationForName("CC_GridEffect"), _vertexEffectUniforms, 1);
+    program->setUniformLocationWith4fv(program->getUniformLocationForName("CC_GridEffectParams"), _vertexEffectUniforms + 4, 1);
+    program->setUniformLocationWith2f(program->getUniformLocationForName("CC_GridSize"), _gridSize.width, _gridSize.height);
+
+    // unbinds the VAO first, the index buffer binding would be stored in it otherwise.
+    // The grid coordinates use the color attribute
+    GL::enableVertexAttribs( GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX );
+
+    if (_vertexEffectBuffersDirty || !_vertexEffectBuffers[0])
+    {
+        setupVertexEffectBuffers();
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _vertexEffectBuffers[0]);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vertexEffectBuffers[1]);
+    }
+
+    const GLsizei stride = 7 * sizeof(GLfloat);
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)0);
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(3 * sizeof(GLfloat)));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(5 * sizeof(GLfloat)));
+
+    glDrawElements(GL_TRIANGLES, (GLsizei) n*6, GL_UNSIGNED_SHORT, (GLvoid*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1,n*6);
 }
 
 void Grid3D::blit(void)
 {
+    if (_vertexEffect != VertexEffect::NONE)
+    {
+        blitVertexEffect();
+        return;
+    }
+
     int n = _gridSize.width * _gridSize.height;
 
     GL::enableVertexAttribs( GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_TEX_COORDS );
@@ -425,6 +564,7 @@ void Grid3D::calculateVertexPoints(void)
     }
 
     memcpy(_originalVertices, _vertices, (_gridSize.width+1) * (_gridSize.height+1) * sizeof(Vertex3F));
+    _vertexEffectBuffersDirty = true;
 }
 
 Vertex3F Grid3D::getVertex(const Point& pos) const
@@ -466,6 +606,7 @@ void Grid3D::reuse(void)
     if (_reuseGrid > 0)
     {
         memcpy(_originalVertices, _vertices, (_gridSize.width+1) * (_gridSize.height+1) * sizeof(Vertex3F));
+        _vertexEffectBuffersDirty = true;
         --_reuseGrid;
     }
 }
@@ -41,6 +41,7 @@ NS_CC_BEGIN
 class Texture2D;
 class Grabber;
 class GLProgram;
+class EventListenerCustom;
 
 /**
  * @addtogroup effects
@@ -114,6 +115,19 @@ class CC_DLL Grid3D : public GridBase
 #endif // EMSCRIPTEN
 {
 public:
+    /** Effects that the grid can apply to its original vertices in the vertex shader,
+     instead of having the actions rewrite every vertex on the CPU.
+     */
+    enum class VertexEffect
+    {
+        NONE,
+        WAVES_3D,   // params: -
+        RIPPLE_3D,  // params: center x, center y, radius
+        LIQUID,     // params: -
+        WAVES,      // params: vertical (0 or 1), horizontal (0 or 1)
+        TWIRL,      // params: center x, center y
+    };
+
     /** create one Grid */
     static Grid3D* create(const Size& gridSize, Texture2D *texture, bool flipped);
     /** create one Grid */
@@ -155,16 +169,40 @@ public:
      */
     void setVertex(const Point& pos, const Vertex3F& vertex);
 
+    /** Sets the effect that is applied to the original vertices when the grid is drawn.
+     While an effect is set, the vertices set with setVertex() are ignored.
+     The meaning of the params depends on the effect. Use VertexEffect::NONE to draw the vertices again.
+     @since v3.0
+     */
+    void setVertexEffect(VertexEffect effect, float phase = 0, float amplitude = 0, float param0 = 0, float param1 = 0, float param2 = 0);
+    /** returns the effect that is applied to the original vertices */
+    inline VertexEffect getVertexEffect() const { return _vertexEffect; }
+    /** Whether the effects can be applied in the vertex shader. False when the grid draws with its own shader program:
+     the actions then move the vertices on the CPU.
+     */
+    bool isVertexEffectSupported() const;
+
     // Overrides
     virtual void blit() override;
     virtual void reuse() override;
     virtual void calculateVertexPoints() override;
 
 protected:
+    void blitVertexEffect();
+    void setupVertexEffectBuffers();
+
     GLvoid *_texCoordinates;
     GLvoid *_vertices;
     GLvoid *_originalVertices;
     GLushort *_indices;
+
+    VertexEffect _vertexEffect;
+    GLfloat _vertexEffectUniforms[8];   // CC_GridEffect, CC_GridEffectParams
+    GLuint _vertexEffectBuffers[2];     // 0: vertex  1: indices
+    bool _vertexEffectBuffersDirty;
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    EventListenerCustom* _backToForegroundlistener;
+#endif
 };
 
 /**
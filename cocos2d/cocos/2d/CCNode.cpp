@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "CCNode.h"
 
 #include <algorithm>
+#include <unordered_map>
 
 #include "deprecated/CCString.h"
 #include "ccCArray.h"
@@ -71,6 +72,99 @@ bool nodeComparisonLess(Node* n1, Node* n2)
            );
 }
 
+// Hash index over the children of a node. See Node::setChildIndexEnabled()
+struct Node::ChildIndex
+{
+    ChildIndex()
+    : validPositions(0)
+    {}
+
+    void addKeys(Node* child)
+    {
+        // untagged and unnamed children can't be looked up, don't pile them up in one bucket
+        if (child->_tag != Node::INVALID_TAG)
+            byTag.insert(std::make_pair(child->_tag, child));
+        if (!child->_name.empty())
+            byName.insert(std::make_pair(child->_name, child));
+    }
+
+    void removeKeys(Node* child)
+    {
+        if (child->_tag != Node::INVALID_TAG)
+            eraseEntry(byTag, child->_tag, child);
+        if (!child->_name.empty())
+            eraseEntry(byName, child->_name, child);
+    }
+
+    void remove(Node* child)
+    {
+        removeKeys(child);
+        positions.erase(child);
+    }
+
+    void clear()
+    {
+        byTag.clear();
+        byName.clear();
+        positions.clear();
+        validPositions = 0;
+    }
+
+    void refreshPositions(const Vector<Node*>& children)
+    {
+        for (ssize_t i = validPositions, size = children.size(); i < size; ++i)
+        {
+            positions[children.at(i)] = i;
+        }
+        validPositions = children.size();
+    }
+
+    template <typename K>
+    static void eraseEntry(std::unordered_multimap<K, Node*>& map, const K& key, Node* child)
+    {
+        auto range = map.equal_range(key);
+        for (auto iter = range.first; iter != range.second; ++iter)
+        {
+            if (iter->second == child)
+            {
+                map.erase(iter);
+                return;
+            }
+        }
+    }
+
+    // returns the child that comes first in the children array, like a linear scan would
+    template <typename K>
+    static Node* findFirst(const std::unordered_multimap<K, Node*>& map, const K& key, Node* parent)
+    {
+        auto range = map.equal_range(key);
+        if (range.first == range.second)
+            return nullptr;
+
+        Node* found = range.first->second;
+        if (std::next(range.first) == range.second)
+            return found;
+
+        ssize_t foundIndex = parent->getIndexOfChild(found);
+        for (auto iter = std::next(range.first); iter != range.second; ++iter)
+        {
+            ssize_t index = parent->getIndexOfChild(iter->second);
+            if (index < foundIndex)
+            {
+                found = iter->second;
+                foundIndex = index;
+            }
+        }
+        return found;
+    }
+
+    std::unordered_multimap<int, Node*> byTag;
+    std::unordered_multimap<std::string, Node*> byName;
+    std::unordered_map<Node*, ssize_t> positions;
+    // positions of the children at or after this index are stale and get refreshed on demand
+    ssize_t validPositions;
+};
+
 // XXX: Yes, nodes might have a sort problem once every 15 days if the game runs at 60 FPS and each frame sprites are reordered.
 int Node::s_globalOrderOfArrival = 1;
 
@@ -109,6 +203,9 @@ Node::Node(void)
 , _visible(true)
 , _ignoreAnchorPointForPosition(false)
 , _reorderChildDirty(false)
+, _unorderedChildren(false)
+, _childIndex(nullptr)
+, _removingChildren(false)
 , _isTransitionFinished(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _updateScriptHandler(0)
@@ -166,6 +263,8 @@ Node::~Node()
         child->_parent = nullptr;
     }
 
+    CC_SAFE_DELETE(_childIndex);
+
     removeAllComponents();
     
     CC_SAFE_DELETE(_componentContainer);
@@ -605,7 +704,35 @@ int Node::getTag() const
 /// tag setter
 void Node::setTag(int var)
 {
-    _tag = var;
+    if (_parent && _parent->_childIndex)
+    {
+        _parent->_childIndex->removeKeys(this);
+        _tag = var;
+        _parent->_childIndex->addKeys(this);
+    }
+    else
+    {
+        _tag = var;
+    }
+}
+
+const std::string& Node::getName() const
+{
+    return _name;
+}
+
+void Node::setName(const std::string& name)
+{
+    if (_parent && _parent->_childIndex)
+    {
+        _parent->_childIndex->removeKeys(this);
+        _name = name;
+        _parent->_childIndex->addKeys(this);
+    }
+    else
+    {
+        _name = name;
+    }
 }
 
 /// userData setter
@@ -704,6 +831,11 @@ Node* Node::getChildByTag(int tag)
 {
     CCASSERT( tag != Node::INVALID_TAG, "Invalid tag");
 
+    if (_childIndex)
+    {
+        return ChildIndex::findFirst(_childIndex->byTag, tag, this);
+    }
+
     for (auto& child : _children)
     {
         if(child && child->_tag == tag)
@@ -712,6 +844,76 @@ Node* Node::getChildByTag(int tag)
     return nullptr;
 }
 
+Node* Node::getChildByName(const std::string& name)
+{
+    CCASSERT(!name.empty(), "Invalid name");
+
+    if (_childIndex)
+    {
+        return ChildIndex::findFirst(_childIndex->byName, name, this);
+    }
+
+    for (auto& child : _children)
+    {
+        if (child && child->_name == name)
+            return child;
+    }
+    return nullptr;
+}
+
+ssize_t Node::getIndexOfChild(Node* child)
+{
+    if (_childIndex == nullptr)
+    {
+        return _children.getIndex(child);
+    }
+
+    auto& positions = _childIndex->positions;
+    auto iter = positions.find(child);
+    if (iter != positions.end() && iter->second < _childIndex->validPositions)
+    {
+        if (iter->second < _children.size() && _children.at(iter->second) == child)
+            return iter->second;
+
+        // the children array was modified behind our back, forget every position
+        _childIndex->validPositions = 0;
+    }
+
+    if (child == nullptr || child->_parent != this)
+    {
+        return CC_INVALID_INDEX;
+    }
+
+    _childIndex->refreshPositions(_children);
+    iter = positions.find(child);
+    return iter != positions.end() ? iter->second : CC_INVALID_INDEX;
+}
+
+void Node::setChildIndexEnabled(bool enabled)
+{
+    if (enabled == (_childIndex != nullptr))
+        return;
+
+    if (enabled)
+    {
+        _childIndex = new ChildIndex();
+        for (const auto& child : _children)
+        {
+            _childIndex->addKeys(child);
+        }
+        _childIndex->refreshPositions(_children);
+    }
+    else
+    {
+        CC_SAFE_DELETE(_childIndex);
+    }
+}
+
+void Node::setUnorderedChildrenEnabled(bool unordered)
+{
+    _unorderedChildren = unordered;
+}
+
 /* "add" logic MUST only be on this method
 * If a class want's to extend the 'addChild' behavior it only needs
 * to override this method
@@ -746,6 +948,11 @@ void Node::addChild(Node *child, int zOrder, int tag)
 
     child->_tag = tag;
 
+    if (_childIndex)
+    {
+        _childIndex->addKeys(child);
+    }
+
     child->setParent(this);
     child->setOrderOfArrival(s_globalOrderOfArrival++);
 
@@ -806,7 +1013,21 @@ void Node::removeChild(Node* child, bool cleanup /* = true */)
         return;
     }
 
-    ssize_t index = _children.getIndex(child);
+    if (_removingChildren)
+    {
+        // removeChildren() drops the detached children from the array in one pass
+        if (child != nullptr && child->_parent == this)
+        {
+            if (_childIndex)
+            {
+                _childIndex->remove(child);
+            }
+            this->detachChildBeforeRemoval(child, cleanup);
+        }
+        return;
+    }
+
+    ssize_t index = this->getIndexOfChild(child);
     if( index != CC_INVALID_INDEX )
         this->detachChild( child, index, cleanup );
 }
@@ -862,9 +1083,100 @@ void Node::removeAllChildrenWithCleanup(bool cleanup)
     }
     
     _children.clear();
+
+    if (_childIndex)
+    {
+        _childIndex->clear();
+    }
+}
+
+void Node::removeChildren(const std::function<bool(Node*)>& predicate, bool cleanup/* = true */)
+{
+    // collect first: onExit() and cleanup() may run user code.
+    // getChildren() because some subclasses keep their children in another node
+    std::vector<Node*> removed;
+    for (const auto& child : getChildren())
+    {
+        if (predicate(child))
+            removed.push_back(child);
+    }
+
+    if (removed.empty())
+    {
+        return;
+    }
+
+    // go through the virtual removeChild() for the bookkeeping of subclasses (atlas quads, item lists...),
+    // Node::removeChild() only detaches while _removingChildren is set
+    bool removing = _removingChildren;
+    _removingChildren = true;
+    for (const auto& child : removed)
+    {
+        this->removeChild(child, cleanup);
+    }
+    _removingChildren = removing;
+    if (removing)
+    {
+        return;
+    }
+
+    // move the survivors to the front keeping their order
+    ssize_t kept = 0;
+    for (ssize_t i = 0, size = _children.size(); i < size; ++i)
+    {
+        if (_children.at(i)->_parent == this)
+        {
+            if (kept != i)
+                _children.swap(kept, i);
+            ++kept;
+        }
+    }
+    if (kept == _children.size())
+    {
+        return;
+    }
+    _children.erase(_children.begin() + kept, _children.end());
+
+    if (_childIndex)
+    {
+        _childIndex->validPositions = 0;
+    }
 }
 
 void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
+{
+    this->detachChildBeforeRemoval(child, doCleanup);
+
+    if (_childIndex == nullptr)
+    {
+        _children.erase(childIndex);
+        return;
+    }
+
+    _childIndex->remove(child);
+
+    ssize_t last = _children.size() - 1;
+    if (_unorderedChildren && childIndex != last)
+    {
+        // swap-remove: the children stay sorted as long as the moved child has the same z order
+        Node* moved = _children.at(last);
+        if (moved->_localZOrder != child->_localZOrder)
+        {
+            _reorderChildDirty = true;
+        }
+        _children.swap(childIndex, last);
+        _children.popBack();
+        _childIndex->positions[moved] = childIndex;
+    }
+    else
+    {
+        _children.erase(childIndex);
+        _childIndex->validPositions = std::min(_childIndex->validPositions, childIndex);
+    }
+    _childIndex->validPositions = std::min(_childIndex->validPositions, _children.size());
+}
+
+void Node::detachChildBeforeRemoval(Node *child, bool doCleanup)
 {
     // IMPORTANT:
     //  -1st do onExit
@@ -892,15 +1204,28 @@ void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
 
     // set parent nil at the end
     child->setParent(nullptr);
-
-    _children.erase(childIndex);
 }
 
 
 // helper used by reorderChild & add
 void Node::insertChild(Node* child, int z)
 {
-    _reorderChildDirty = true;
+    if (_childIndex == nullptr)
+    {
+        _reorderChildDirty = true;
+    }
+    else
+    {
+        // appended children arrive last, so the array only needs sorting if they break the z order
+        if (!_children.empty() && _children.back()->_localZOrder > z)
+        {
+            _reorderChildDirty = true;
+        }
+        if (_childIndex->validPositions == _children.size())
+        {
+            _childIndex->positions[child] = _childIndex->validPositions++;
+        }
+    }
     _children.pushBack(child);
     child->_setLocalZOrder(z);
 }
@@ -918,6 +1243,11 @@ void Node::sortAllChildren()
     if( _reorderChildDirty ) {
         std::sort( std::begin(_children), std::end(_children), nodeComparisonLess );
         _reorderChildDirty = false;
+
+        if (_childIndex)
+        {
+            _childIndex->validPositions = 0;
+        }
     }
 }
 
@@ -644,6 +644,14 @@ public:
      * @return a Node object whose tag equals to the input parameter
      */
     virtual Node * getChildByTag(int tag);
+    /**
+     * Gets a child from the container with its name
+     *
+     * @param name   An identifier to find the child node.
+     *
+     * @return a Node object whose name equals to the input parameter
+     */
+    virtual Node* getChildByName(const std::string& name);
     /**
      * Returns the array of the node's children
      *
@@ -722,6 +730,17 @@ public:
      * @lua removeAllChildren
      */
     virtual void removeAllChildrenWithCleanup(bool cleanup);
+    /**
+     * Removes every child for which the predicate returns true, compacting the children array only once.
+     * Prefer it over calling `removeChild` in a loop when many children go away at the same time.
+     * Every child is still removed through `removeChild`, so subclasses keep their bookkeeping.
+     *
+     * @param predicate A function that returns true if the child passed in should be removed.
+     * @param cleanup   true if all running actions and callbacks on the removed children will be cleanup, false otherwise.
+     * @js NA
+     * @lua NA
+     */
+    virtual void removeChildren(const std::function<bool(Node*)>& predicate, bool cleanup = true);
 
     /**
      * Reorders a child according to a new z value.
@@ -738,6 +757,41 @@ public:
      */
     virtual void sortAllChildren();
 
+    /**
+     * Enables a hash index over the children, keyed by tag, name and position in the children array.
+     *
+     * With the index enabled `getChildByTag`, `getChildByName` and `removeChild` don't scan the children array anymore.
+     * It is meant for containers with thousands of children, like bullet pools or tile decorations.
+     * The index is not allocated until it is enabled.
+     *
+     * @param enabled   true to build the index, false to release it.
+     */
+    void setChildIndexEnabled(bool enabled);
+    /**
+     * Returns whether the children are indexed.
+     *
+     * @see `setChildIndexEnabled(bool)`
+     */
+    bool isChildIndexEnabled() const { return _childIndex != nullptr; }
+
+    /**
+     * Sets whether children with the same local z order may be visited in any order.
+     *
+     * When enabled (and the child index is enabled), removing a child moves the last child into its slot
+     * instead of shifting the tail of the children array, which makes `removeFromParent` O(1).
+     * Children with different local z orders are still drawn in z order.
+     * The default value is false.
+     *
+     * @param unordered true if the order of arrival of children with the same local z order doesn't matter.
+     */
+    void setUnorderedChildrenEnabled(bool unordered);
+    /**
+     * Returns whether children with the same local z order may be visited in any order.
+     *
+     * @see `setUnorderedChildrenEnabled(bool)`
+     */
+    bool isUnorderedChildrenEnabled() const { return _unorderedChildren; }
+
     /// @} end of Children and Parent
     
     /// @{
@@ -758,6 +812,19 @@ public:
      */
     virtual void setTag(int tag);
 
+    /**
+     * Returns a string that is used to identify the node.
+     *
+     * @return A string that identifies the node.
+     */
+    const std::string& getName() const;
+    /**
+     * Changes the name that is used to identify the node easily.
+     *
+     * @param name  A string that identifies the node.
+     */
+    void setName(const std::string& name);
+
     
     /**
      * Returns a custom user data pointer
@@ -1354,6 +1421,14 @@ protected:
     /// Removes a child, call child->onExit(), do cleanup, remove it from children array.
     void detachChild(Node *child, ssize_t index, bool doCleanup);
 
+    /// Calls child->onExit(), do cleanup and clears its parent, without touching the children array.
+    void detachChildBeforeRemoval(Node *child, bool doCleanup);
+
+    /// Returns the position of a child in the children array, or CC_INVALID_INDEX.
+    ssize_t getIndexOfChild(Node* child);
+
+    struct ChildIndex;
+
     /// Convert cocos2d coordinates to UI windows coordinate.
     Point convertToWindowSpace(const Point& nodePoint) const;
 
@@ -1429,6 +1504,9 @@ protected:
                                           ///< Used by Layer and Scene.
 
     bool _reorderChildDirty;          ///< children order dirty flag
+    bool _unorderedChildren;          ///< true if children with the same local z order can be visited in any order
+    ChildIndex* _childIndex;          ///< tag/name/position index of the children, nullptr unless enabled
+    bool _removingChildren;           ///< true while removeChildren() lets removeChild() leave the children array to it
     bool _isTransitionFinished;       ///< flag to indicate whether the transition was finished
 
 #if CC_ENABLE_SCRIPT_BINDING
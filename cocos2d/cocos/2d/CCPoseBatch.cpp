@@ -0,0 +1,143 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCPoseBatch.h"
+#include "CCRef.h"
+#include "CCJobPool.h"
+#include "ccConfig.h"
+#include "ccMacros.h"
+
+NS_CC_BEGIN
+
+static PoseBatch* s_sharedPoseBatch = nullptr;
+
+PoseBatch* PoseBatch::getInstance()
+{
+    if (! s_sharedPoseBatch)
+    {
+        s_sharedPoseBatch = new PoseBatch();
+    }
+    return s_sharedPoseBatch;
+}
+
+void PoseBatch::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedPoseBatch);
+}
+
+PoseBatch::PoseBatch()
+: _enabled(CC_ENABLE_PARALLEL_POSE_EVALUATION != 0)
+, _flushing(false)
+, _lastBatchSize(0)
+, _lastParallelJobs(0)
+{
+}
+
+PoseBatch::~PoseBatch()
+{
+    clear();
+}
+
+void PoseBatch::clear()
+{
+    for (auto& queued : _jobs)
+    {
+        queued.job->_poseQueued = false;
+        queued.owner->release();
+    }
+    _jobs.clear();
+}
+
+void PoseBatch::setEnabled(bool enabled)
+{
+    if (_enabled && ! enabled)
+    {
+        flush();
+    }
+    _enabled = enabled;
+}
+
+bool PoseBatch::addJob(Ref* owner, PoseJob* job)
+{
+    CCASSERT(owner && job, "Invalid pose job");
+
+    if (! _enabled || _flushing)
+        return false;
+
+    // updated twice in the same step: the first pose has to be done before the second one is queued
+    if (job->_poseQueued)
+    {
+        flush();
+    }
+
+    owner->retain();
+    job->_poseQueued = true;
+    _jobs.push_back({owner, job});
+    return true;
+}
+
+void PoseBatch::flush()
+{
+    if (_jobs.empty() || _flushing)
+        return;
+
+    CC_PROFILER_ZONE("PoseBatch - flush");
+
+    _flushing = true;
+
+    _parallelJobs.clear();
+    for (auto& queued : _jobs)
+    {
+        if (queued.job->isPoseThreadSafe())
+        {
+            _parallelJobs.push_back(queued.job);
+        }
+        else
+        {
+            queued.job->evaluatePose();
+        }
+    }
+
+    JobPool::getInstance()->parallelFor(_parallelJobs.size(), [this](ssize_t index) {
+        _parallelJobs[index]->evaluatePose();
+    });
+
+    for (auto& queued : _jobs)
+    {
+        queued.job->_poseQueued = false;
+        queued.job->mergePose();
+    }
+
+    _lastBatchSize = _jobs.size();
+    _lastParallelJobs = _parallelJobs.size();
+    _parallelJobs.clear();
+
+    // owners are released once every job was merged: a merge callback may remove the other nodes
+    clear();
+
+    _flushing = false;
+}
+
+NS_CC_END
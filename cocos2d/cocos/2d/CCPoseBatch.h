@@ -0,0 +1,131 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCPOSEBATCH_H__
+#define __CCPOSEBATCH_H__
+
+#include <vector>
+#include "CCPlatformMacros.h"
+#include "CCStdC.h" // for ssize_t on window
+
+NS_CC_BEGIN
+
+class Ref;
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** @brief Pose evaluation of an animated node that can be deferred to the end of the update phase.
+
+ Implemented by the skeletal animation nodes (spine::SkeletonAnimation, cocostudio::Armature).
+ */
+class CC_DLL PoseJob
+{
+public:
+    PoseJob() : _poseQueued(false) {}
+    virtual ~PoseJob() {}
+
+    /** Whether evaluatePose() only touches state owned by this job, so it can run on a worker thread.
+     Checked on the main thread, right before the batch is evaluated.
+     */
+    virtual bool isPoseThreadSafe() const { return true; }
+    /** Computes the pose. Runs on a worker thread when isPoseThreadSafe() returned true */
+    virtual void evaluatePose() = 0;
+    /** Runs on the main thread once every pose of the batch was evaluated, e.g. to fire the events collected by evaluatePose() */
+    virtual void mergePose() {}
+
+private:
+    friend class PoseBatch;
+    bool _poseQueued;
+};
+
+/** @brief Evaluates the poses queued during the update phase in parallel.
+
+ Skeletal animation nodes queue their pose in update() instead of computing it right away.
+ The Director calls flush() after every update of the scheduler, before the scene is visited:
+ the queued poses are evaluated on the JobPool, then merged on the main thread in the order they were queued,
+ so the result does not depend on the number of threads.
+
+ Until then, the bones of a queued node still hold the pose of the previous update.
+ Code that needs the new pose right away can call flush() itself.
+ */
+class CC_DLL PoseBatch
+{
+public:
+    /** returns the shared pose batch */
+    static PoseBatch* getInstance();
+
+    /** releases the queued owners, without evaluating them, and destroys the shared pose batch */
+    static void destroyInstance();
+
+    /** Queues `job` until the next flush(). `owner` is the node implementing it and is retained until then.
+     Returns false, and queues nothing, when the batch is disabled or being flushed:
+     the caller has to evaluate the pose itself. Must be called from the main thread.
+     */
+    bool addJob(Ref* owner, PoseJob* job);
+
+    /** Evaluates and merges the queued poses. Called by the Director after every update of the scheduler */
+    void flush();
+
+    /** Enables or disables the batching. Disabled, nodes evaluate their pose in update() as before.
+     Disabled by default, see CC_ENABLE_PARALLEL_POSE_EVALUATION.
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    /** returns the number of poses evaluated by the last flush() */
+    ssize_t getLastBatchSize() const { return _lastBatchSize; }
+    /** returns how many poses of the last flush() were evaluated on the JobPool */
+    ssize_t getLastParallelJobs() const { return _lastParallelJobs; }
+
+private:
+    PoseBatch();
+    ~PoseBatch();
+
+    void clear();
+
+    struct QueuedJob
+    {
+        Ref* owner;
+        PoseJob* job;
+    };
+
+    std::vector<QueuedJob> _jobs;
+    std::vector<PoseJob*> _parallelJobs;
+    bool _enabled;
+    bool _flushing;
+    ssize_t _lastBatchSize;
+    ssize_t _lastParallelJobs;
+
+    CC_DISALLOW_COPY_AND_ASSIGN(PoseBatch);
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __CCPOSEBATCH_H__
@@ -26,11 +26,160 @@ THE SOFTWARE.
 #include "CCProfiling.h"
 
 #include <chrono>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32) && (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+#include <pthread.h>
+#define CC_PROFILER_USE_PTHREAD_KEY 1
+#else
+#define CC_PROFILER_USE_PTHREAD_KEY 0
+#endif
 
 using namespace std;
 
 NS_CC_BEGIN
 
+static_assert((CC_PROFILER_TRACE_BUFFER_SIZE & (CC_PROFILER_TRACE_BUFFER_SIZE - 1)) == 0, "CC_PROFILER_TRACE_BUFFER_SIZE must be a power of 2");
+
+namespace
+{
+    struct TraceEvent
+    {
+        long long timestamp;    // nanoseconds since the trace epoch
+        unsigned int zoneId;
+        char phase;             // 'B' or 'E'
+    };
+
+    // Relaxed atomics, so that a reader copying a slot while its thread overwrites it doesn't race
+    struct TraceSlot
+    {
+        std::atomic<long long> timestamp;
+        std::atomic<unsigned int> zoneId;
+        std::atomic<char> phase;
+    };
+
+    // Written by its own thread only. Readers copy the events and drop the ones that
+    // may have been overwritten while copying.
+    struct ThreadTraceBuffer
+    {
+        explicit ThreadTraceBuffer(unsigned int index)
+        : threadIndex(index)
+        , events(new TraceSlot[CC_PROFILER_TRACE_BUFFER_SIZE])
+        , head(0)
+        , first(0)
+        {
+        }
+
+        ~ThreadTraceBuffer()
+        {
+            delete [] events;
+        }
+
+        unsigned int threadIndex;
+        TraceSlot* events;
+        std::atomic<unsigned long long> head;   // number of events ever written
+        std::atomic<unsigned long long> first;  // events before it were cleared
+    };
+
+    struct TraceRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::string> zoneNames;
+        std::unordered_map<std::string, unsigned int> zoneIds;
+        std::vector<ThreadTraceBuffer*> buffers;
+        unsigned int nextThreadIndex = 0;
+    };
+
+    // never destroyed: zones may still be closed by other threads while the process exits
+    TraceRegistry& getTraceRegistry()
+    {
+        static TraceRegistry* registry = new TraceRegistry();
+        return *registry;
+    }
+
+    const chrono::steady_clock::time_point s_traceEpoch = chrono::steady_clock::now();
+
+#if CC_PROFILER_USE_PTHREAD_KEY
+    pthread_key_t s_bufferKey;
+    pthread_once_t s_bufferKeyOnce = PTHREAD_ONCE_INIT;
+
+    // the events of an exited thread are dropped with its buffer
+    void releaseThreadBuffer(void* data)
+    {
+        auto buffer = static_cast<ThreadTraceBuffer*>(data);
+        TraceRegistry& registry = getTraceRegistry();
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.buffers.erase(std::find(registry.buffers.begin(), registry.buffers.end(), buffer));
+        }
+        delete buffer;
+    }
+
+    void createBufferKey()
+    {
+        pthread_key_create(&s_bufferKey, releaseThreadBuffer);
+    }
+#else
+    // there is no thread exit hook here: the buffers of exited threads are kept until the process exits
+    __declspec(thread) ThreadTraceBuffer* s_threadBuffer = nullptr;
+#endif
+
+    ThreadTraceBuffer* getThreadBuffer()
+    {
+#if CC_PROFILER_USE_PTHREAD_KEY
+        pthread_once(&s_bufferKeyOnce, createBufferKey);
+        auto buffer = static_cast<ThreadTraceBuffer*>(pthread_getspecific(s_bufferKey));
+#else
+        auto buffer = s_threadBuffer;
+#endif
+        if (buffer == nullptr)
+        {
+            // first event of this thread, the only time the lock is taken
+            TraceRegistry& registry = getTraceRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            buffer = new ThreadTraceBuffer(registry.nextThreadIndex++);
+            registry.buffers.push_back(buffer);
+#if CC_PROFILER_USE_PTHREAD_KEY
+            pthread_setspecific(s_bufferKey, buffer);
+#else
+            s_threadBuffer = buffer;
+#endif
+        }
+        return buffer;
+    }
+
+    inline void recordEvent(unsigned int zoneId, char phase)
+    {
+        auto now = chrono::steady_clock::now();
+
+        ThreadTraceBuffer* buffer = getThreadBuffer();
+        unsigned long long head = buffer->head.load(std::memory_order_relaxed);
+        TraceSlot& slot = buffer->events[head & (CC_PROFILER_TRACE_BUFFER_SIZE - 1)];
+        // a reader that sees any of the stores below then sees head, and drops the slot
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timestamp.store(chrono::duration_cast<chrono::nanoseconds>(now - s_traceEpoch).count(), std::memory_order_relaxed);
+        slot.zoneId.store(zoneId, std::memory_order_relaxed);
+        slot.phase.store(phase, std::memory_order_relaxed);
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+    void appendEscaped(std::string& out, const std::string& str)
+    {
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+            }
+            out += c;
+        }
+    }
+}
+
 // Profiling Categories
 /* set to false the categories that you don't want to profile */
 bool kProfilerCategorySprite = false;
@@ -40,6 +189,8 @@ bool kProfilerCategoryParticles = false;
 
 static Profiler* g_sSharedProfiler = nullptr;
 
+std::atomic<bool> Profiler::s_tracing(false);
+
 Profiler* Profiler::getInstance()
 {
     if (! g_sSharedProfiler)
@@ -95,6 +246,138 @@ void Profiler::displayTimers()
     }
 }
 
+void Profiler::startTracing()
+{
+    s_tracing.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stopTracing()
+{
+    s_tracing.store(false, std::memory_order_relaxed);
+}
+
+void Profiler::clearTrace()
+{
+    TraceRegistry& registry = getTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto buffer : registry.buffers)
+    {
+        buffer->first.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+unsigned int Profiler::registerZone(const char* zoneName)
+{
+    TraceRegistry& registry = getTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto iter = registry.zoneIds.find(zoneName);
+    if (iter != registry.zoneIds.end())
+    {
+        return iter->second;
+    }
+
+    unsigned int zoneId = static_cast<unsigned int>(registry.zoneNames.size());
+    registry.zoneNames.push_back(zoneName);
+    registry.zoneIds.insert(std::make_pair(registry.zoneNames.back(), zoneId));
+    return zoneId;
+}
+
+void Profiler::beginZone(unsigned int zoneId)
+{
+    recordEvent(zoneId, 'B');
+}
+
+void Profiler::endZone(unsigned int zoneId)
+{
+    recordEvent(zoneId, 'E');
+}
+
+std::string Profiler::getChromeTrace() const
+{
+    TraceRegistry& registry = getTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool firstEvent = true;
+    char buffer[128];
+    std::vector<TraceEvent> events;
+
+    for (auto threadBuffer : registry.buffers)
+    {
+        unsigned long long head = threadBuffer->head.load(std::memory_order_acquire);
+        unsigned long long begin = threadBuffer->first.load(std::memory_order_relaxed);
+        if (head > CC_PROFILER_TRACE_BUFFER_SIZE)
+        {
+            begin = MAX(begin, head - CC_PROFILER_TRACE_BUFFER_SIZE);
+        }
+
+        events.clear();
+        for (unsigned long long i = begin; i < head; ++i)
+        {
+            const TraceSlot& slot = threadBuffer->events[i & (CC_PROFILER_TRACE_BUFFER_SIZE - 1)];
+            TraceEvent event;
+            event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            event.zoneId = slot.zoneId.load(std::memory_order_relaxed);
+            event.phase = slot.phase.load(std::memory_order_relaxed);
+            events.push_back(event);
+        }
+
+        // the owner thread kept recording while copying: skip the slots it may have overwritten,
+        // including the one of event newHead, which may be half written
+        std::atomic_thread_fence(std::memory_order_acquire);
+        unsigned long long newHead = threadBuffer->head.load(std::memory_order_relaxed);
+        size_t skipped = 0;
+        if (newHead >= CC_PROFILER_TRACE_BUFFER_SIZE && newHead - CC_PROFILER_TRACE_BUFFER_SIZE + 1 > begin)
+        {
+            skipped = static_cast<size_t>(MIN(newHead - CC_PROFILER_TRACE_BUFFER_SIZE + 1 - begin, (unsigned long long)events.size()));
+        }
+
+        if (!firstEvent)
+        {
+            json += ',';
+        }
+        firstEvent = false;
+        sprintf(buffer, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                threadBuffer->threadIndex, threadBuffer->threadIndex);
+        json += buffer;
+
+        for (size_t i = skipped; i < events.size(); ++i)
+        {
+            const TraceEvent& event = events[i];
+            if (event.zoneId >= registry.zoneNames.size())
+            {
+                continue;
+            }
+
+            json += ",{\"name\":\"";
+            appendEscaped(json, registry.zoneNames[event.zoneId]);
+            sprintf(buffer, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}",
+                    event.phase, event.timestamp / 1000.0, threadBuffer->threadIndex);
+            json += buffer;
+        }
+    }
+
+    json += "]}";
+    return json;
+}
+
+bool Profiler::saveChromeTrace(const std::string& filename) const
+{
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        CCLOG("cocos2d: Profiler: can not open %s", filename.c_str());
+        return false;
+    }
+
+    std::string json = getChromeTrace();
+    bool ret = fwrite(json.data(), 1, json.size(), file) == json.size();
+    fclose(file);
+
+    return ret;
+}
+
 // implementation of ProfilingTimer
 
 ProfilingTimer::ProfilingTimer()
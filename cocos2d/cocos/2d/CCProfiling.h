@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include <string>
 #include <chrono>
+#include <atomic>
 #include "ccConfig.h"
 #include "CCRef.h"
 #include "CCMap.h"
@@ -45,6 +46,13 @@ class ProfilingTimer;
  cocos2d builtin profiler.
 
  To use it, enable set the CC_ENABLE_PROFILERS=1 in the ccConfig.h file
+
+ Besides the named timers, the profiler records a trace of nested zones.
+ A zone is opened with CC_PROFILER_ZONE("name") and closed at the end of the enclosing scope.
+ Its name is registered once, every later begin/end only stores an id and a steady_clock timestamp
+ in a ring buffer owned by the calling thread, without any lock.
+ Recording starts with startTracing() and the result can be saved as a Chrome trace
+ (open it with chrome://tracing).
  */
 
 class CC_DLL Profiler : public Ref
@@ -95,7 +103,86 @@ public:
      */
     void releaseAllTimers();
 
+    /** Starts recording zones in the trace
+     * @js NA
+     * @lua NA
+     */
+    void startTracing();
+    /** Stops recording zones. The events recorded so far are kept
+     * @js NA
+     * @lua NA
+     */
+    void stopTracing();
+    /** Whether or not zones are being recorded
+     * @js NA
+     * @lua NA
+     */
+    static inline bool isTracing() { return s_tracing.load(std::memory_order_relaxed); }
+    /** Forgets the recorded events
+     * @js NA
+     * @lua NA
+     */
+    void clearTrace();
+    /** Returns the recorded events in the Chrome trace event JSON format
+     * @js NA
+     * @lua NA
+     */
+    std::string getChromeTrace() const;
+    /** Saves the recorded events in the Chrome trace event JSON format
+     * @js NA
+     * @lua NA
+     */
+    bool saveChromeTrace(const std::string& filename) const;
+
+    /** Registers a zone name and returns its id. Registering the same name twice returns the same id.
+     * @js NA
+     * @lua NA
+     */
+    static unsigned int registerZone(const char* zoneName);
+    /** Records the beginning / end of a zone for the calling thread.
+     Use CC_PROFILER_ZONE instead of calling them directly.
+     * @js NA
+     * @lua NA
+     */
+    static void beginZone(unsigned int zoneId);
+    static void endZone(unsigned int zoneId);
+
     Map<std::string, ProfilingTimer*> _activeTimers;
+
+protected:
+    static std::atomic<bool> s_tracing;
+};
+
+/** Records a zone from its construction to its destruction.
+ The zone is only closed when it was opened, even if tracing is started or stopped in between.
+ */
+class CC_DLL ProfilingZone
+{
+public:
+    explicit ProfilingZone(unsigned int zoneId)
+    : _zoneId(zoneId)
+    , _recording(Profiler::isTracing())
+    {
+        if (_recording)
+        {
+            Profiler::beginZone(_zoneId);
+        }
+    }
+
+    ~ProfilingZone()
+    {
+        if (_recording)
+        {
+            Profiler::endZone(_zoneId);
+        }
+    }
+
+private:
+    ProfilingZone(const ProfilingZone&);
+    ProfilingZone& operator=(const ProfilingZone&);
+
+    unsigned int _zoneId;
+    bool _recording;
 };
 
 class ProfilingTimer : public Ref
@@ -46,6 +46,9 @@ THE SOFTWARE.
 #include "kazmath/GL/matrix.h"
 #include "CCEventListenerCustom.h"
 #include "CCEventDispatcher.h"
+#include "CCScheduler.h"
+
+#include <thread>
 
 NS_CC_BEGIN
 
@@ -439,6 +442,173 @@ void RenderTexture::onSaveToFile(const std::string& filename)
     CC_SAFE_DELETE(image);
 }
 
+struct RenderTexture::AsyncSave
+{
+    RenderTexture* renderTexture;
+    std::string fullPath;
+    Image::Format format;
+    std::function<void(bool, const std::string&)> callback;
+    int width;
+    int height;
+    GLuint pbo;
+    unsigned int frame;
+    GLubyte* pixels;
+};
+
+void RenderTexture::saveToFileAsync(const std::string& fileName, Image::Format format, const std::function<void(bool, const std::string&)>& callback)
+{
+    CCASSERT(format == Image::Format::JPG || format == Image::Format::PNG,
+             "the image can only be saved as JPG or PNG format");
+    CCASSERT(_pixelFormat == Texture2D::PixelFormat::RGBA8888, "only RGBA8888 can be saved as image");
+
+    AsyncSave* save = new AsyncSave();
+    save->renderTexture = this;
+    save->fullPath = FileUtils::getInstance()->getWritablePath() + fileName;
+    save->format = format;
+    save->callback = callback;
+    save->width = 0;
+    save->height = 0;
+    save->pbo = 0;
+    save->frame = 0;
+    save->pixels = nullptr;
+
+    // released once the callback has been called
+    retain();
+
+    // one command reads the pixels of all the requests of this frame
+    _asyncSaves.push_back(save);
+    if (_asyncSaves.size() == 1)
+    {
+        _saveToFileAsyncCommand.init(_globalZOrder);
+        _saveToFileAsyncCommand.func = CC_CALLBACK_0(RenderTexture::onSaveToFileAsync, this);
+
+        Director::getInstance()->getRenderer()->addCommand(&_saveToFileAsyncCommand);
+    }
+}
+
+void RenderTexture::onSaveToFileAsync()
+{
+    const Size& s = _texture->getContentSizeInPixels();
+    bool usePBO = Configuration::getInstance()->supportsPixelBufferObject();
+
+    for (auto save : _asyncSaves)
+    {
+        save->width = (int)s.width;
+        save->height = (int)s.height;
+
+#ifdef GL_PIXEL_PACK_BUFFER
+        if (usePBO)
+        {
+            // glReadPixels returns as soon as the copy is queued, the buffer is mapped a few frames later
+            glGenBuffers(1, &save->pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, save->pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, save->width * save->height * 4, nullptr, GL_STREAM_READ);
+            readPixels(nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            save->frame = Director::getInstance()->getTotalFrames();
+            // keyed on the request, so that cleaning up the node doesn't unschedule it
+            Director::getInstance()->getScheduler()->schedule([this, save](float dt){
+                this->mapAsyncSave(save);
+            }, save, 0, false, "RenderTexture::mapAsyncSave");
+            continue;
+        }
+#endif
+        // OpenGL ES 2.0 can't read pixels asynchronously, only the encoding is moved off this thread
+        save->pixels = new GLubyte[save->width * save->height * 4];
+        readPixels(save->pixels);
+        encodeAsyncSave(save);
+    }
+
+    _asyncSaves.clear();
+}
+
+void RenderTexture::mapAsyncSave(AsyncSave* save)
+{
+#ifdef GL_PIXEL_PACK_BUFFER
+    if (Director::getInstance()->getTotalFrames() - save->frame < CC_RENDER_TEXTURE_READBACK_FRAMES)
+    {
+        return;
+    }
+
+    Director::getInstance()->getScheduler()->unschedule("RenderTexture::mapAsyncSave", save);
+
+    size_t size = save->width * save->height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, save->pbo);
+    GLubyte* mapped = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (mapped)
+    {
+        save->pixels = new GLubyte[size];
+        memcpy(save->pixels, mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glDeleteBuffers(1, &save->pbo);
+    save->pbo = 0;
+
+    CHECK_GL_ERROR_DEBUG();
+#endif
+    encodeAsyncSave(save);
+}
+
+void RenderTexture::encodeAsyncSave(AsyncSave* save)
+{
+    std::thread thread([save](){
+        bool succeeded = false;
+        if (save->pixels)
+        {
+            int rowSize = save->width * 4;
+            GLubyte* flipped = new GLubyte[rowSize * save->height];
+            for (int i = 0; i < save->height; ++i)
+            {
+                memcpy(&flipped[i * rowSize], &save->pixels[(save->height - i - 1) * rowSize], rowSize);
+            }
+            CC_SAFE_DELETE_ARRAY(save->pixels);
+
+            Image* image = new Image();
+            if (image->initWithRawData(flipped, rowSize * save->height, save->width, save->height, 8))
+            {
+                succeeded = image->saveToFile(save->fullPath, true);
+            }
+            CC_SAFE_DELETE(image);
+            delete[] flipped;
+        }
+
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread([save, succeeded](){
+            if (save->callback)
+            {
+                save->callback(succeeded, save->fullPath);
+            }
+            save->renderTexture->release();
+            delete save;
+        });
+    });
+    thread.detach();
+}
+
+void RenderTexture::readPixels(GLvoid* pixels)
+{
+    const Size& s = _texture->getContentSizeInPixels();
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_oldFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, _FBO);
+
+    //TODO move this to configration, so we don't check it every time
+    /*  Certain Qualcomm Andreno gpu's will retain data in memory after a frame buffer switch which corrupts the render to the texture. The solution is to clear the frame buffer before rendering to the texture. However, calling glClear has the unintended result of clearing the current texture. Create a temporary texture to overcome this. At the end of RenderTexture::begin(), switch the attached texture to the second one, call glClear, and then switch back to the original texture. This solution is unnecessary for other devices as they don't have the same issue with switching frame buffers.
+     */
+    if (Configuration::getInstance()->checkForGLExtension("GL_QCOM"))
+    {
+        // -- bind a temporary texture so we can clear the render buffer without losing our texture
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _textureCopy->getName(), 0);
+        CHECK_GL_ERROR_DEBUG();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture->getName(), 0);
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0,0,(int)s.width, (int)s.height,GL_RGBA,GL_UNSIGNED_BYTE, pixels);
+    glBindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
+}
+
 /* get buffer as Image */
 Image* RenderTexture::newImage(bool fliimage)
 {
@@ -472,23 +642,7 @@ Image* RenderTexture::newImage(bool fliimage)
             break;
         }
 
-        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_oldFBO);
-        glBindFramebuffer(GL_FRAMEBUFFER, _FBO);
-
-        //TODO move this to configration, so we don't check it every time
-        /*  Certain Qualcomm Andreno gpu's will retain data in memory after a frame buffer switch which corrupts the render to the texture. The solution is to clear the frame buffer before rendering to the texture. However, calling glClear has the unintended result of clearing the current texture. Create a temporary texture to overcome this. At the end of RenderTexture::begin(), switch the attached texture to the second one, call glClear, and then switch back to the original texture. This solution is unnecessary for other devices as they don't have the same issue with switching frame buffers.
-         */
-        if (Configuration::getInstance()->checkForGLExtension("GL_QCOM"))
-        {
-            // -- bind a temporary texture so we can clear the render buffer without losing our texture
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _textureCopy->getName(), 0);
-            CHECK_GL_ERROR_DEBUG();
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture->getName(), 0);
-        }
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glReadPixels(0,0,savedBufferWidth, savedBufferHeight,GL_RGBA,GL_UNSIGNED_BYTE, tempData);
-        glBindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
+        readPixels(tempData);
 
         if ( fliimage ) // -- flip is only required when saving image to file
         {
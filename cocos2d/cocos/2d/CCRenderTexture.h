@@ -110,6 +110,14 @@ public:
         Returns true if the operation is successful.
      */
     bool saveToFile(const std::string& filename, Image::Format format);
+
+    /** saves the texture into a file without stalling the render thread. The format could be JPG or PNG. The file will be saved in the Documents folder.
+     When pixel buffer objects are supported, the pixels are read into one and only mapped a few frames later, once the GPU is done with them.
+     Flipping and encoding the image happen on a worker thread, and the callback is called on the main thread with
+     whether the file could be written and its full path.
+     @since v3.0
+     */
+    void saveToFileAsync(const std::string& filename, Image::Format format, const std::function<void(bool, const std::string&)>& callback = nullptr);
     
     /** Listen "come to background" message, and save render texture.
      It only has effect on Android.
@@ -215,6 +223,11 @@ protected:
     CustomCommand _beginCommand;
     CustomCommand _endCommand;
     CustomCommand _saveToFileCommand;
+    CustomCommand _saveToFileAsyncCommand;
+
+    /** a saveToFileAsync request, from the read back of its pixels to the end of its encoding */
+    struct AsyncSave;
+    std::vector<AsyncSave*> _asyncSaves;
 protected:
     //renderer caches and callbacks
     void onBegin();
@@ -224,6 +237,12 @@ protected:
     void onClearDepth();
 
     void onSaveToFile(const std::string& fileName);
+    void onSaveToFileAsync();
+
+    /** reads the pixels of the texture into pixels, or at this offset of the bound pixel pack buffer */
+    void readPixels(GLvoid* pixels);
+    void mapAsyncSave(AsyncSave* save);
+    void encodeAsyncSave(AsyncSave* save);
     
     kmMat4 _oldTransMatrix, _oldProjMatrix;
     kmMat4 _transformMatrix, _projectionMatrix;
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "utlist.h"
 #include "ccCArray.h"
 #include "CCScriptSupport.h"
+#include "CCProfiling.h"
 
 NS_CC_BEGIN
 
@@ -814,6 +815,8 @@ void Scheduler::performFunctionInCocosThread(const std::function<void ()> &funct
 // main loop
 void Scheduler::update(float dt)
 {
+    CC_PROFILER_ZONE("Scheduler - update");
+
     _updateHashLocked = true;
 
     if (_timeScale != 1.0f)
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <set>
 
 #include "CCRef.h"
+#include "CCSlabAllocator.h"
 #include "CCVector.h"
 #include "uthash.h"
 
@@ -53,6 +54,7 @@ typedef std::function<void(float)> ccSchedulerFunc;
 //
 class CC_DLL Timer : public Ref
 {
+    CC_SLAB_ALLOCATED
 protected:
     Timer();
 public:
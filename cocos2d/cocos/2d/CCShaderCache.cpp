@@ -40,6 +40,7 @@ enum {
     kShaderType_PositionColor,
     kShaderType_PositionColor_noMVP,
     kShaderType_PositionTexture,
+    kShaderType_PositionTextureGrid,
     kShaderType_PositionTexture_uColor,
     kShaderType_PositionTextureA8Color,
     kShaderType_Position_uColor,
@@ -145,6 +146,13 @@ void ShaderCache::loadDefaultShaders()
     loadDefaultShader(p, kShaderType_PositionTexture);
     _programs.insert( std::make_pair( GLProgram::SHADER_NAME_POSITION_TEXTURE, p) );
 
+    //
+    // Position Texture shader of the grid effects
+    //
+    p = new GLProgram();
+    loadDefaultShader(p, kShaderType_PositionTextureGrid);
+    _programs.insert( std::make_pair( GLProgram::SHADER_NAME_POSITION_TEXTURE_GRID, p) );
+
     //
     // Position, Texture attribs, 1 Color as uniform shader
     //
@@ -232,6 +240,13 @@ void ShaderCache::reloadDefaultShaders()
     p = getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE);
     p->reset();
     loadDefaultShader(p, kShaderType_PositionTexture);
+
+    //
+    // Position Texture shader of the grid effects
+    //
+    p = getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_GRID);
+    p->reset();
+    loadDefaultShader(p, kShaderType_PositionTextureGrid);
     
     //
     // Position, Texture attribs, 1 Color as uniform shader
@@ -334,6 +349,15 @@ void ShaderCache::loadDefaultShader(GLProgram *p, int type)
             p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_POSITION, GLProgram::VERTEX_ATTRIB_POSITION);
             p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
 
+            break;
+        case kShaderType_PositionTextureGrid:
+            p->initWithByteArrays(ccPositionTextureGrid_vert ,ccPositionTexture_frag);
+            
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_POSITION, GLProgram::VERTEX_ATTRIB_POSITION);
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
+            // the grid coordinates take the slot of the color, which the grid doesn't have
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_GRID_COORD, GLProgram::VERTEX_ATTRIB_COLOR);
+
             break;
         case kShaderType_PositionTexture_uColor:
             p->initWithByteArrays(ccPositionTexture_uColor_vert, ccPositionTexture_uColor_frag);
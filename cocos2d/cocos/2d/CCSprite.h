@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __SPRITE_NODE_CCSPRITE_H__
 
 #include "CCNode.h"
+#include "CCSlabAllocator.h"
 #include "CCProtocols.h"
 #include "CCTextureAtlas.h"
 #include "ccTypes.h"
@@ -80,6 +81,7 @@ struct transformValues_;
  */
 class CC_DLL Sprite : public Node, public TextureProtocol
 {
+    CC_SLAB_ALLOCATED
 public:
 
     static const int INDEX_NOT_INITIALIZED = -1; /// Sprite invalid index on the SpriteBatchNode
@@ -335,8 +335,7 @@ void SpriteBatchNode::swap(ssize_t oldIndex, ssize_t newIndex)
 {
     CCASSERT(oldIndex>=0 && oldIndex < (int)_descendants.size() && newIndex >=0 && newIndex < (int)_descendants.size(), "Invalid index");
 
-    V3F_C4B_T2F_Quad* quads = _textureAtlas->getQuads();
-    std::swap( quads[oldIndex], quads[newIndex] );
+    _textureAtlas->swapQuads(oldIndex, newIndex);
 
     //update the index of other swapped item
 
@@ -38,6 +38,8 @@ THE SOFTWARE.
 #include "deprecated/CCString.h"
 #include "CCDirector.h"
 #include <vector>
+#include <algorithm>
+#include <memory>
 
 using namespace std;
 
@@ -45,6 +47,13 @@ NS_CC_BEGIN
 
 static SpriteFrameCache *_sharedSpriteFrameCache = nullptr;
 
+// unlike operator[], doesn't insert the key in the dictionary when it is missing
+static const Value& findValue(const ValueFlatMap& dict, const char* key)
+{
+    auto iter = dict.find(key);
+    return iter != dict.end() ? iter->second : Value::Null;
+}
+
 SpriteFrameCache* SpriteFrameCache::getInstance()
 {
     if (! _sharedSpriteFrameCache)
@@ -74,7 +83,7 @@ SpriteFrameCache::~SpriteFrameCache(void)
     CC_SAFE_DELETE(_loadedFileNames);
 }
 
-void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Texture2D* texture)
+void SpriteFrameCache::addSpriteFramesWithDictionary(const ValueFlatMap& dictionary, Texture2D* texture, std::vector<std::string>* frameNames)
 {
     /*
     Supported Zwoptex Formats:
@@ -86,14 +95,14 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
     */
 
     
-    ValueMap& framesDict = dictionary["frames"].asValueMap();
+    const ValueFlatMap& framesDict = findValue(dictionary, "frames").asValueFlatMap();
     int format = 0;
 
     // get the format
-    if (dictionary.find("metadata") != dictionary.end())
+    auto metadata = dictionary.find("metadata");
+    if (metadata != dictionary.end())
     {
-        ValueMap& metadataDict = dictionary["metadata"].asValueMap();
-        format = metadataDict["format"].asInt();
+        format = findValue(metadata->second.asValueFlatMap(), "format").asInt();
     }
 
     // check the format
@@ -101,8 +110,8 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
 
     for (auto iter = framesDict.begin(); iter != framesDict.end(); ++iter)
     {
-        ValueMap& frameDict = iter->second.asValueMap();
-        std::string spriteFrameName = iter->first;
+        const ValueFlatMap& frameDict = iter->second.asValueFlatMap();
+        const std::string& spriteFrameName = iter->first;
         SpriteFrame* spriteFrame = _spriteFrames.at(spriteFrameName);
         if (spriteFrame)
         {
@@ -111,14 +120,14 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
         
         if(format == 0) 
         {
-            float x = frameDict["x"].asFloat();
-            float y = frameDict["y"].asFloat();
-            float w = frameDict["width"].asFloat();
-            float h = frameDict["height"].asFloat();
-            float ox = frameDict["offsetX"].asFloat();
-            float oy = frameDict["offsetY"].asFloat();
-            int ow = frameDict["originalWidth"].asInt();
-            int oh = frameDict["originalHeight"].asInt();
+            float x = findValue(frameDict, "x").asFloat();
+            float y = findValue(frameDict, "y").asFloat();
+            float w = findValue(frameDict, "width").asFloat();
+            float h = findValue(frameDict, "height").asFloat();
+            float ox = findValue(frameDict, "offsetX").asFloat();
+            float oy = findValue(frameDict, "offsetY").asFloat();
+            int ow = findValue(frameDict, "originalWidth").asInt();
+            int oh = findValue(frameDict, "originalHeight").asInt();
             // check ow/oh
             if(!ow || !oh)
             {
@@ -138,17 +147,17 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
         } 
         else if(format == 1 || format == 2) 
         {
-            Rect frame = RectFromString(frameDict["frame"].asString());
+            Rect frame = RectFromString(findValue(frameDict, "frame").asString());
             bool rotated = false;
 
             // rotation
             if (format == 2)
             {
-                rotated = frameDict["rotated"].asBool();
+                rotated = findValue(frameDict, "rotated").asBool();
             }
 
-            Point offset = PointFromString(frameDict["offset"].asString());
-            Size sourceSize = SizeFromString(frameDict["sourceSize"].asString());
+            Point offset = PointFromString(findValue(frameDict, "offset").asString());
+            Size sourceSize = SizeFromString(findValue(frameDict, "sourceSize").asString());
 
             // create frame
             spriteFrame = new SpriteFrame();
@@ -162,14 +171,14 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
         else if (format == 3)
         {
             // get values
-            Size spriteSize = SizeFromString(frameDict["spriteSize"].asString());
-            Point spriteOffset = PointFromString(frameDict["spriteOffset"].asString());
-            Size spriteSourceSize = SizeFromString(frameDict["spriteSourceSize"].asString());
-            Rect textureRect = RectFromString(frameDict["textureRect"].asString());
-            bool textureRotated = frameDict["textureRotated"].asBool();
+            Size spriteSize = SizeFromString(findValue(frameDict, "spriteSize").asString());
+            Point spriteOffset = PointFromString(findValue(frameDict, "spriteOffset").asString());
+            Size spriteSourceSize = SizeFromString(findValue(frameDict, "spriteSourceSize").asString());
+            Rect textureRect = RectFromString(findValue(frameDict, "textureRect").asString());
+            bool textureRotated = findValue(frameDict, "textureRotated").asBool();
 
             // get aliases
-            ValueVector& aliases = frameDict["aliases"].asValueVector();
+            const ValueVector& aliases = findValue(frameDict, "aliases").asValueVector();
 
             for(const auto &value : aliases) {
                 std::string oneAlias = value.asString();
@@ -178,7 +187,7 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
                     CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", oneAlias.c_str());
                 }
 
-                _spriteFramesAliases[oneAlias] = Value(spriteFrameName);
+                _spriteFramesAliases[oneAlias] = spriteFrameName;
             }
             
             // create frame
@@ -193,13 +202,18 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
         // add sprite frame
         _spriteFrames.insert(spriteFrameName, spriteFrame);
         spriteFrame->release();
+
+        if (frameNames)
+        {
+            frameNames->push_back(spriteFrameName);
+        }
     }
 }
 
 void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist, Texture2D *pobTexture)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(pszPlist);
-    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+    ValueFlatMap dict = FileUtils::getInstance()->getValueFlatMapFromFile(fullPath);
 
     addSpriteFramesWithDictionary(dict, pobTexture);
 }
@@ -219,6 +233,40 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, const s
     }
 }
 
+std::string SpriteFrameCache::getTexturePathForSheet(const std::string& plist, const ValueFlatMap& dict) const
+{
+    string texturePath("");
+
+    auto metadata = dict.find("metadata");
+    if (metadata != dict.end())
+    {
+        // try to read  texture file name from meta data
+        texturePath = findValue(metadata->second.asValueFlatMap(), "textureFileName").asString();
+    }
+
+    if (!texturePath.empty())
+    {
+        // build texture path relative to plist file
+        texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath.c_str(), plist);
+    }
+    else
+    {
+        // build texture path by replacing file extension
+        texturePath = plist;
+
+        // remove .xxx
+        size_t startPos = texturePath.find_last_of(".");
+        texturePath = texturePath.erase(startPos);
+
+        // append .png
+        texturePath = texturePath.append(".png");
+
+        CCLOG("cocos2d: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
+    }
+
+    return texturePath;
+}
+
 void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist)
 {
     CCASSERT(pszPlist.size()>0, "plist filename should not be nullptr");
@@ -226,49 +274,311 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist)
     if (_loadedFileNames->find(pszPlist) == _loadedFileNames->end())
     {
         std::string fullPath = FileUtils::getInstance()->fullPathForFilename(pszPlist);
-        ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+        ValueFlatMap dict = FileUtils::getInstance()->getValueFlatMapFromFile(fullPath);
 
-        string texturePath("");
+        std::string texturePath = getTexturePathForSheet(pszPlist, dict);
+        Texture2D *texture = Director::getInstance()->getTextureCache()->addImage(texturePath.c_str());
 
-        if (dict.find("metadata") != dict.end())
+        if (texture)
+        {
+            addSheet(pszPlist, dict, texture);
+        }
+        else
         {
-            ValueMap& metadataDict = dict["metadata"].asValueMap();
-            // try to read  texture file name from meta data
-            texturePath = metadataDict["textureFileName"].asString();
+            CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
         }
+    }
+}
+
+void SpriteFrameCache::addSpriteFramesWithFileAsync(const std::string& plist, const std::function<void(bool)>& callback)
+{
+    CCASSERT(plist.size()>0, "plist filename should not be nullptr");
 
-        if (!texturePath.empty())
+    if (_loadedFileNames->find(plist) != _loadedFileNames->end())
+    {
+        if (callback)
         {
-            // build texture path relative to plist file
-            texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath.c_str(), pszPlist);
+            callback(true);
         }
-        else
+        return;
+    }
+
+    // the plist is small, only the texture is loaded in the thread of the TextureCache
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+    auto dict = std::make_shared<ValueFlatMap>(FileUtils::getInstance()->getValueFlatMapFromFile(fullPath));
+    std::string texturePath = getTexturePathForSheet(plist, *dict);
+
+    Director::getInstance()->getTextureCache()->addImageAsync(texturePath, [this, plist, dict, callback](Texture2D* texture){
+        // the same sheet might have been requested twice, or loaded synchronously in the meantime
+        if (texture && _loadedFileNames->find(plist) == _loadedFileNames->end())
         {
-            // build texture path by replacing file extension
-            texturePath = pszPlist;
+            addSheet(plist, *dict, texture);
+        }
+        else if (!texture)
+        {
+            CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+        }
 
-            // remove .xxx
-            size_t startPos = texturePath.find_last_of("."); 
-            texturePath = texturePath.erase(startPos);
+        if (callback)
+        {
+            callback(texture != nullptr);
+        }
+    });
+}
+
+void SpriteFrameCache::addSheet(const std::string& plist, const ValueFlatMap& dictionary, Texture2D *texture)
+{
+    SheetInfo& sheet = _sheets[plist];
 
-            // append .png
-            texturePath = texturePath.append(".png");
+    std::vector<std::string> frameNames;
+    addSpriteFramesWithDictionary(dictionary, texture, &frameNames);
+
+    if (sheet.frameNames.empty())
+    {
+        sheet.frameNames.swap(frameNames);
+    }
+    else
+    {
+        // reloaded after some of its frames were removed
+        for (auto& name : frameNames)
+        {
+            if (std::find(sheet.frameNames.begin(), sheet.frameNames.end(), name) == sheet.frameNames.end())
+            {
+                sheet.frameNames.push_back(name);
+            }
+        }
+    }
 
-            CCLOG("cocos2d: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
+    if (!sheet.resident)
+    {
+        sheet.bytes = texture->getMemoryBytes();
+        sheet.texture = texture;
+        sheet.resident = true;
+        // a texture shared by several sheets is counted once
+        if (++_residentSheetsPerTexture[texture] == 1)
+        {
+            _residentBytes += sheet.bytes;
         }
+    }
+    sheet.lastUse = ++_sheetUseCounter;
 
-        Texture2D *texture = Director::getInstance()->getTextureCache()->addImage(texturePath.c_str());
+    _loadedFileNames->insert(plist);
+
+    trimToMemoryBudget();
+}
+
+void SpriteFrameCache::evictSheet(const std::string& plist)
+{
+    _loadedFileNames->erase(plist);
+
+    auto iter = _sheets.find(plist);
+    if (iter == _sheets.end())
+    {
+        return;
+    }
+
+    SheetInfo& sheet = iter->second;
+    if (sheet.resident)
+    {
+        auto texture = _residentSheetsPerTexture.find(sheet.texture);
+        if (texture != _residentSheetsPerTexture.end() && --texture->second == 0)
+        {
+            _residentSheetsPerTexture.erase(texture);
+            _residentBytes -= sheet.bytes;
+        }
+        sheet.texture = nullptr;
+        sheet.resident = false;
+    }
+
+    if (sheet.refCount == 0)
+    {
+        _sheets.erase(iter);
+    }
+}
+
+void SpriteFrameCache::evictSheetsWithFrames(const std::vector<std::string>& frameNames)
+{
+    if (frameNames.empty())
+    {
+        return;
+    }
 
+    std::set<std::string> names(frameNames.begin(), frameNames.end());
+    std::vector<std::string> sheetsToEvict;
+
+    for (auto& entry : _sheets)
+    {
+        for (auto& name : entry.second.frameNames)
+        {
+            if (names.find(name) != names.end())
+            {
+                sheetsToEvict.push_back(entry.first);
+                break;
+            }
+        }
+    }
+
+    for (auto& plist : sheetsToEvict)
+    {
+        evictSheet(plist);
+    }
+}
+
+void SpriteFrameCache::retainSpriteSheet(const std::string& plist)
+{
+    addSpriteFramesWithFile(plist);
+
+    SheetInfo& sheet = _sheets[plist];
+    ++sheet.refCount;
+    sheet.released = false;
+}
+
+void SpriteFrameCache::releaseSpriteSheet(const std::string& plist)
+{
+    auto iter = _sheets.find(plist);
+    CCASSERT(iter != _sheets.end() && iter->second.refCount > 0, "releaseSpriteSheet: the sheet wasn't retained");
+    if (iter == _sheets.end() || iter->second.refCount <= 0)
+    {
+        return;
+    }
+
+    SheetInfo& sheet = iter->second;
+    if (--sheet.refCount == 0)
+    {
+        sheet.released = true;
+        sheet.lastUse = ++_sheetUseCounter;
+
+        if (!sheet.resident)
+        {
+            _sheets.erase(iter);
+        }
+        trimToMemoryBudget();
+    }
+}
+
+void SpriteFrameCache::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    trimToMemoryBudget();
+}
+
+void SpriteFrameCache::trimToMemoryBudget()
+{
+    if (_memoryBudget == 0 || _residentBytes <= _memoryBudget)
+    {
+        return;
+    }
+
+    std::vector<std::pair<unsigned int, std::string>> candidates;
+    for (auto& entry : _sheets)
+    {
+        const SheetInfo& sheet = entry.second;
+        if (sheet.resident && sheet.released && sheet.refCount == 0)
+        {
+            candidates.push_back(std::make_pair(sheet.lastUse, entry.first));
+        }
+    }
+
+    // least recently released first
+    std::sort(candidates.begin(), candidates.end());
+
+    TextureCache *textureCache = Director::getInstance()->getTextureCache();
+
+    for (auto& candidate : candidates)
+    {
+        if (_residentBytes <= _memoryBudget)
+        {
+            break;
+        }
+
+        const SheetInfo& sheet = _sheets[candidate.second];
+        Texture2D *texture = sheet.texture;
+
+        // Sprites don't retain their frame but they retain its texture: besides the texture cache,
+        // the texture must only be referenced by the frames of the cache
+        bool used = false;
         if (texture)
         {
-            addSpriteFramesWithDictionary(dict, texture);
-            _loadedFileNames->insert(pszPlist);
+            unsigned int framesWithTexture = 0;
+            for (auto& entry : _spriteFrames)
+            {
+                if (entry.second->getTexture() == texture)
+                {
+                    ++framesWithTexture;
+                    // an animation keeps the frame
+                    used = used || entry.second->getReferenceCount() > 1;
+                }
+            }
+            used = used || texture->getReferenceCount() > 1 + framesWithTexture;
+        }
+
+        if (used)
+        {
+            continue;
         }
-        else
+
+        CCLOG("cocos2d: SpriteFrameCache: unloading sheet %s to stay in the memory budget", candidate.second.c_str());
+
+        std::set<std::string> names(sheet.frameNames.begin(), sheet.frameNames.end());
+        for (auto iter = _spriteFramesAliases.begin(); iter != _spriteFramesAliases.end(); )
         {
-            CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+            if (names.find(iter->second.asString()) != names.end())
+            {
+                iter = _spriteFramesAliases.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        _spriteFrames.erase(sheet.frameNames);
+
+        // another sheet might share the texture
+        auto sheetsWithTexture = _residentSheetsPerTexture.find(texture);
+        bool shared = sheetsWithTexture != _residentSheetsPerTexture.end() && sheetsWithTexture->second > 1;
+        evictSheet(candidate.second);
+        if (texture && !shared && texture->getReferenceCount() == 1)
+        {
+            textureCache->removeTexture(texture);
+        }
+        ++_unloadedSheets;
+    }
+}
+
+std::string SpriteFrameCache::getCachedSheetsInfo() const
+{
+    std::string buffer;
+    char buftmp[4096];
+
+    unsigned int retained = 0;
+
+    for (auto& entry : _sheets)
+    {
+        const SheetInfo& sheet = entry.second;
+        if (sheet.refCount > 0)
+        {
+            ++retained;
         }
+
+        snprintf(buftmp, sizeof(buftmp)-1, "\"%s\" rc=%ld frames=%ld %s => %lu KB\n",
+                 entry.first.c_str(),
+                 (long)sheet.refCount,
+                 (long)sheet.frameNames.size(),
+                 sheet.resident ? "loaded" : "unloaded",
+                 (unsigned long)sheet.bytes / 1024);
+        buffer += buftmp;
     }
+
+    snprintf(buftmp, sizeof(buftmp)-1, "SpriteFrameCache: %ld sheets (%ld retained), %ld frames, %lu KB loaded, budget %lu KB, %ld sheets unloaded\n",
+             (long)_sheets.size(),
+             (long)retained,
+             (long)_spriteFrames.size(),
+             (unsigned long)_residentBytes / 1024,
+             (unsigned long)_memoryBudget / 1024,
+             (long)_unloadedSheets);
+    buffer += buftmp;
+
+    return buffer;
 }
 
 void SpriteFrameCache::addSpriteFrame(SpriteFrame* frame, const std::string& frameName)
@@ -281,11 +591,27 @@ void SpriteFrameCache::removeSpriteFrames()
     _spriteFrames.clear();
     _spriteFramesAliases.clear();
     _loadedFileNames->clear();
+
+    // the retained sheets keep their reference count, and are loaded again by retainSpriteSheet()
+    for (auto iter = _sheets.begin(); iter != _sheets.end(); )
+    {
+        if (iter->second.refCount == 0)
+        {
+            iter = _sheets.erase(iter);
+        }
+        else
+        {
+            iter->second.resident = false;
+            iter->second.texture = nullptr;
+            ++iter;
+        }
+    }
+    _residentSheetsPerTexture.clear();
+    _residentBytes = 0;
 }
 
 void SpriteFrameCache::removeUnusedSpriteFrames()
 {
-    bool removed = false;
     std::vector<std::string> toRemoveFrames;
     
     for (auto iter = _spriteFrames.begin(); iter != _spriteFrames.end(); ++iter)
@@ -295,17 +621,13 @@ void SpriteFrameCache::removeUnusedSpriteFrames()
         {
             toRemoveFrames.push_back(iter->first);
             CCLOG("cocos2d: SpriteFrameCache: removing unused frame: %s", iter->first.c_str());
-            removed = true;
         }
     }
 
     _spriteFrames.erase(toRemoveFrames);
     
-    // XXX. Since we don't know the .plist file that originated the frame, we must remove all .plist from the cache
-    if( removed )
-    {
-        _loadedFileNames->clear();
-    }
+    // the .plist files that originated the frames have to be loaded again
+    evictSheetsWithFrames(toRemoveFrames);
 }
 
 
@@ -316,7 +638,8 @@ void SpriteFrameCache::removeSpriteFrameByName(const std::string& name)
         return;
 
     // Is this an alias ?
-    std::string key = _spriteFramesAliases[name].asString();
+    auto alias = _spriteFramesAliases.find(name);
+    std::string key = alias != _spriteFramesAliases.end() ? alias->second.asString() : "";
 
     if (!key.empty())
     {
@@ -328,14 +651,14 @@ void SpriteFrameCache::removeSpriteFrameByName(const std::string& name)
         _spriteFrames.erase(name);
     }
 
-    // XXX. Since we don't know the .plist file that originated the frame, we must remove all .plist from the cache
-    _loadedFileNames->clear();
+    // the .plist file that originated the frame has to be loaded again
+    evictSheetsWithFrames(std::vector<std::string>(1, key.empty() ? name : key));
 }
 
 void SpriteFrameCache::removeSpriteFramesFromFile(const std::string& plist)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
-    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+    ValueFlatMap dict = FileUtils::getInstance()->getValueFlatMapFromFile(fullPath);
     if (dict.empty())
     {
         CCLOG("cocos2d:SpriteFrameCache:removeSpriteFramesFromFile: create dict by %s fail.",plist.c_str());
@@ -344,19 +667,15 @@ void SpriteFrameCache::removeSpriteFramesFromFile(const std::string& plist)
     removeSpriteFramesFromDictionary(dict);
 
     // remove it from the cache
-    set<string>::iterator ret = _loadedFileNames->find(plist);
-    if (ret != _loadedFileNames->end())
-    {
-        _loadedFileNames->erase(ret);
-    }
+    evictSheet(plist);
 }
 
-void SpriteFrameCache::removeSpriteFramesFromDictionary(ValueMap& dictionary)
+void SpriteFrameCache::removeSpriteFramesFromDictionary(const ValueFlatMap& dictionary)
 {
-    ValueMap framesDict = dictionary["frames"].asValueMap();
+    const ValueFlatMap& framesDict = findValue(dictionary, "frames").asValueFlatMap();
     std::vector<std::string> keysToRemove;
 
-    for (auto iter = framesDict.cbegin(); iter != framesDict.cend(); ++iter)
+    for (auto iter = framesDict.begin(); iter != framesDict.end(); ++iter)
     {
         if (_spriteFrames.at(iter->first))
         {
@@ -382,6 +701,7 @@ void SpriteFrameCache::removeSpriteFramesFromTexture(Texture2D* texture)
     }
 
     _spriteFrames.erase(keysToRemove);
+    evictSheetsWithFrames(keysToRemove);
 }
 
 SpriteFrame* SpriteFrameCache::getSpriteFrameByName(const std::string& name)
@@ -390,10 +710,10 @@ SpriteFrame* SpriteFrameCache::getSpriteFrameByName(const std::string& name)
     if (!frame)
     {
         // try alias dictionary
-        std::string key = _spriteFramesAliases[name].asString();
-        if (!key.empty())
+        auto alias = _spriteFramesAliases.find(name);
+        if (alias != _spriteFramesAliases.end() && !alias->second.isNull())
         {
-            frame = _spriteFrames.at(key);
+            frame = _spriteFrames.at(alias->second.asString());
             if (!frame)
             {
                 CCLOG("cocos2d: SpriteFrameCache: Frame '%s' not found", name.c_str());
@@ -39,10 +39,14 @@ THE SOFTWARE.
 #include "CCTexture2D.h"
 #include "CCRef.h"
 #include "CCValue.h"
+#include "CCValueFlatMap.h"
 #include "CCMap.h"
 
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include <functional>
 
 NS_CC_BEGIN
 
@@ -74,7 +78,13 @@ public:
 
 protected:
     // MARMALADE: Made this protected not private, as deriving from this class is pretty useful
-    SpriteFrameCache(){}
+    SpriteFrameCache()
+    : _loadedFileNames(nullptr)
+    , _memoryBudget(0)
+    , _residentBytes(0)
+    , _sheetUseCounter(0)
+    , _unloadedSheets(0)
+    {}
 
 public:
     /**
@@ -106,6 +116,40 @@ public:
      */
     void addSpriteFramesWithFile(const std::string&plist, Texture2D *texture);
 
+    /** Adds multiple Sprite Frames from a plist file, loading its texture in another thread.
+     The callback is called in the cocos2d thread once the frames are in the cache, or couldn't be loaded.
+     If the file is already loaded, the callback is called immediately.
+     @since v3.0
+     */
+    void addSpriteFramesWithFileAsync(const std::string& plist, const std::function<void(bool)>& callback);
+
+    /** Increases the reference count of a sheet, loading it with addSpriteFramesWithFile() if it isn't in the cache.
+     While a sheet is retained, its frames and its texture are never unloaded to honor the memory budget.
+     @since v3.0
+     */
+    void retainSpriteSheet(const std::string& plist);
+
+    /** Decreases the reference count of a sheet retained with retainSpriteSheet().
+     Once it reaches 0 the sheet stays in the cache, but it can be unloaded, least recently released first,
+     when the sheets use more texture memory than the budget.
+     @since v3.0
+     */
+    void releaseSpriteSheet(const std::string& plist);
+
+    /** Sets the number of bytes of texture memory that the loaded sheets may use. 0, the default, means no limit.
+     Only the released sheets whose frames are not used anymore are unloaded to honor it,
+     so the memory in use can be higher than the budget.
+     @since v3.0
+     */
+    void setMemoryBudget(size_t bytes);
+    /** returns the number of bytes of texture memory that the loaded sheets may use */
+    size_t getMemoryBudget() const { return _memoryBudget; }
+    /** returns the number of bytes of texture memory used by the loaded sheets */
+    size_t getResidentBytes() const { return _residentBytes; }
+
+    /** Returns the sheets in the cache, with their reference count and size */
+    std::string getCachedSheetsInfo() const;
+
     /** Adds an sprite frame with a given name.
      If the name already exists, then the contents of the old name will be replaced with the new one.
      */
@@ -154,18 +198,63 @@ public:
 
 private:
     /*Adds multiple Sprite Frames with a dictionary. The texture will be associated with the created sprite frames.
+     The names of the frames that were created are appended to frameNames, when it is not null.
      */
-    void addSpriteFramesWithDictionary(ValueMap& dictionary, Texture2D *texture);
+    void addSpriteFramesWithDictionary(const ValueFlatMap& dictionary, Texture2D *texture, std::vector<std::string>* frameNames = nullptr);
+
+    /** returns the path of the texture used by the sheet, read from its metadata or built from its name */
+    std::string getTexturePathForSheet(const std::string& plist, const ValueFlatMap& dictionary) const;
+
+    /** adds the frames of a sheet and keeps track of them */
+    void addSheet(const std::string& plist, const ValueFlatMap& dictionary, Texture2D *texture);
+
+    /** forgets the frames of a sheet, without removing them */
+    void evictSheet(const std::string& plist);
+
+    /** forgets the sheets that created some of the frames, which were removed from the cache */
+    void evictSheetsWithFrames(const std::vector<std::string>& frameNames);
+
+    /** unloads the least recently released sheets until the loaded sheets fit in the budget */
+    void trimToMemoryBudget();
 
     /** Removes multiple Sprite Frames from Dictionary.
     * @since v0.99.5
     */
-    void removeSpriteFramesFromDictionary(ValueMap& dictionary);
+    void removeSpriteFramesFromDictionary(const ValueFlatMap& dictionary);
 
 protected:
+    /** A plist file whose frames are in the cache */
+    struct SheetInfo
+    {
+        SheetInfo() : refCount(0), lastUse(0), bytes(0), texture(nullptr), resident(false), released(false) {}
+
+        // the frames that were created by the sheet
+        std::vector<std::string> frameNames;
+        // number of retainSpriteSheet() calls without a releaseSpriteSheet()
+        int refCount;
+        // value of _sheetUseCounter when the sheet was last loaded or released
+        unsigned int lastUse;
+        // texture memory used by the sheet
+        size_t bytes;
+        // texture of the frames while the sheet is resident, they keep it alive
+        Texture2D* texture;
+        // false when some of its frames were removed from the cache
+        bool resident;
+        // true once its reference count went back to 0. Only those sheets can be unloaded for the budget
+        bool released;
+    };
+
     Map<std::string, SpriteFrame*> _spriteFrames;
-    ValueMap _spriteFramesAliases;
+    ValueFlatMap _spriteFramesAliases;
     std::set<std::string>*  _loadedFileNames;
+
+    std::unordered_map<std::string, SheetInfo> _sheets;
+    size_t _memoryBudget;
+    size_t _residentBytes;
+    // number of resident sheets using each texture, a texture is counted once in _residentBytes
+    std::unordered_map<Texture2D*, unsigned int> _residentSheetsPerTexture;
+    unsigned int _sheetUseCounter;
+    unsigned int _unloadedSheets;
 };
 
 // end of sprite_nodes group
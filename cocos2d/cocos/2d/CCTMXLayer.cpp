@@ -33,11 +33,39 @@ THE SOFTWARE.
 #include "CCGLProgram.h"
 #include "ccCArray.h"
 #include "CCDirector.h"
+#include "CCTextureAtlas.h"
+#include "renderer/CCRenderer.h"
 
 #include "deprecated/CCString.h" // For StringUtils::format
 
 NS_CC_BEGIN
 
+// a square group of tiles of a chunked layer, rendered with its own vertex buffer
+struct TMXLayerChunk
+{
+    TMXLayerChunk()
+    : x(0), y(0), width(0), height(0)
+    , atlas(nullptr)
+    , built(false)
+    , dirty(false)
+    {}
+
+    ~TMXLayerChunk()
+    {
+        CC_SAFE_RELEASE(atlas);
+    }
+
+    // tiles covered by the chunk
+    int x, y, width, height;
+    // in points, in the layer space
+    Rect boundingBox;
+    // nullptr when the chunk is not built or has no tile
+    TextureAtlas* atlas;
+    BatchCommand command;
+    bool built;
+    bool dirty;
+};
+
 
 // TMXLayer - init & alloc & dealloc
 
@@ -58,6 +86,24 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
     float totalNumberOfTiles = size.width * size.height;
     float capacity = totalNumberOfTiles * 0.35f + 1; // 35 percent is occupied ?
 
+    // chunked layers only create quads for the chunks around the screen
+    int chunkSize = 0;
+    auto chunkSizeIter = layerInfo->getProperties().find("cc_chunk_size");
+    if (chunkSizeIter != layerInfo->getProperties().end())
+    {
+        chunkSize = chunkSizeIter->second.asInt();
+    }
+    else if (CC_TMX_CHUNKED_LAYER_THRESHOLD > 0 && totalNumberOfTiles >= CC_TMX_CHUNKED_LAYER_THRESHOLD)
+    {
+        chunkSize = CC_TMX_CHUNK_SIZE;
+    }
+
+    if (chunkSize > 0)
+    {
+        // only the tiles turned into sprites use the batch node atlas
+        capacity = 29;
+    }
+
     Texture2D *texture = nullptr;
     if( tilesetInfo )
     {
@@ -86,7 +132,11 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
         Point offset = this->calculateLayerOffset(layerInfo->_offset);
         this->setPosition(CC_POINT_PIXELS_TO_POINTS(offset));
 
-        _atlasIndexArray = ccCArrayNew(totalNumberOfTiles);
+        _chunkSize = MAX(chunkSize, 0);
+        if (_chunkSize == 0)
+        {
+            _atlasIndexArray = ccCArrayNew(totalNumberOfTiles);
+        }
 
         this->setContentSize(CC_SIZE_PIXELS_TO_POINTS(Size(_layerSize.width * _mapTileSize.width, _layerSize.height * _mapTileSize.height)));
 
@@ -111,6 +161,9 @@ TMXLayer::TMXLayer()
 ,_tiles(nullptr)
 ,_tileSet(nullptr)
 ,_layerOrientation(TMXOrientationOrtho)
+,_chunkSize(0)
+,_chunksPerRow(0)
+,_chunkMargin(0)
 {}
 
 TMXLayer::~TMXLayer()
@@ -124,11 +177,24 @@ TMXLayer::~TMXLayer()
         _atlasIndexArray = nullptr;
     }
 
+    for (auto chunk : _chunks)
+    {
+        delete chunk;
+    }
+    _chunks.clear();
+
     CC_SAFE_DELETE_ARRAY(_tiles);
 }
 
 void TMXLayer::releaseMap()
 {
+    if (_chunkSize > 0)
+    {
+        // the chunks are rebuilt from the tiles when they get close to the screen again
+        CCLOG("cocos2d: TMXLayer: the map of a chunked layer can't be released");
+        return;
+    }
+
     if (_tiles)
     {
         delete [] _tiles;
@@ -160,6 +226,13 @@ void TMXLayer::setupTiles()
     // Parse cocos2d properties
     this->parseInternalProperties();
 
+    if (_chunkSize > 0)
+    {
+        // the quads are created lazily, by draw()
+        setupChunks();
+        return;
+    }
+
     for (int y=0; y < _layerSize.height; y++)
     {
         for (int x=0; x < _layerSize.width; x++)
@@ -308,7 +381,7 @@ Sprite* TMXLayer::reusedTileWithRect(Rect rect)
 Sprite * TMXLayer::getTileAt(const Point& pos)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
-    CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
+    CCASSERT(_tiles && (_atlasIndexArray || _chunkSize > 0), "TMXLayer: the tiles map has been released");
 
     Sprite *tile = nullptr;
     int gid = this->getTileGIDAt(pos);
@@ -332,8 +405,18 @@ Sprite * TMXLayer::getTileAt(const Point& pos)
             tile->setAnchorPoint(Point::ZERO);
             tile->setOpacity(_opacity);
 
-            ssize_t indexForZ = atlasIndexForExistantZ(z);
-            this->addSpriteWithoutQuad(tile, static_cast<int>(indexForZ), z);
+            if (_chunkSize > 0)
+            {
+                // from now on the sprite draws the tile, not its chunk
+                SpriteBatchNode::addChild(tile, z, z);
+                _tileSprites.insert(z);
+                setChunkDirtyAt(pos);
+            }
+            else
+            {
+                ssize_t indexForZ = atlasIndexForExistantZ(z);
+                this->addSpriteWithoutQuad(tile, static_cast<int>(indexForZ), z);
+            }
         }
     }
     
@@ -343,7 +426,7 @@ Sprite * TMXLayer::getTileAt(const Point& pos)
 uint32_t TMXLayer::getTileGIDAt(const Point& pos, TMXTileFlags* flags/* = nullptr*/)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
-    CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
+    CCASSERT(_tiles && (_atlasIndexArray || _chunkSize > 0), "TMXLayer: the tiles map has been released");
 
     ssize_t idx = static_cast<int>((pos.x + pos.y * _layerSize.width));
     // Bits on the far end of the 32-bit global tile ID are used for tile flags
@@ -493,7 +576,7 @@ void TMXLayer::setTileGID(uint32_t gid, const Point& pos)
 void TMXLayer::setTileGID(uint32_t gid, const Point& pos, TMXTileFlags flags)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
-    CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
+    CCASSERT(_tiles && (_atlasIndexArray || _chunkSize > 0), "TMXLayer: the tiles map has been released");
     CCASSERT(gid == 0 || (int)gid >= _tileSet->_firstGid, "TMXLayer: invalid gid" );
 
     TMXTileFlags currentFlags;
@@ -508,6 +591,12 @@ void TMXLayer::setTileGID(uint32_t gid, const Point& pos, TMXTileFlags flags)
         {
             removeTileAt(pos);
         }
+        // chunked layer: only the chunk holding the tile is rebuilt
+        else if (_chunkSize > 0 && _tileSprites.find(static_cast<int>(pos.x + pos.y * _layerSize.width)) == _tileSprites.end())
+        {
+            _tiles[static_cast<int>(pos.x + pos.y * _layerSize.width)] = gidAndFlags;
+            setChunkDirtyAt(pos);
+        }
         // empty tile. create a new one
         else if (currentGID == 0)
         {
@@ -557,6 +646,16 @@ void TMXLayer::removeChild(Node* node, bool cleanup)
 
     CCASSERT(_children.contains(sprite), "Tile does not belong to TMXLayer");
 
+    if (_chunkSize > 0)
+    {
+        // the tile sprites of a chunked layer are tagged with their position
+        int z = sprite->getTag();
+        _tiles[z] = 0;
+        _tileSprites.erase(z);
+        SpriteBatchNode::removeChild(sprite, cleanup);
+        return;
+    }
+
     ssize_t atlasIndex = sprite->getAtlasIndex();
     ssize_t zz = (ssize_t)_atlasIndexArray->arr[atlasIndex];
     _tiles[zz] = 0;
@@ -567,11 +666,26 @@ void TMXLayer::removeChild(Node* node, bool cleanup)
 void TMXLayer::removeTileAt(const Point& pos)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
-    CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
+    CCASSERT(_tiles && (_atlasIndexArray || _chunkSize > 0), "TMXLayer: the tiles map has been released");
 
     int gid = getTileGIDAt(pos);
 
-    if (gid) 
+    if (gid && _chunkSize > 0)
+    {
+        int z = pos.x + pos.y * _layerSize.width;
+        _tiles[z] = 0;
+
+        if (_tileSprites.find(z) != _tileSprites.end())
+        {
+            _tileSprites.erase(z);
+            SpriteBatchNode::removeChild(getChildByTag(z), true);
+        }
+        else
+        {
+            setChunkDirtyAt(pos);
+        }
+    }
+    else if (gid)
     {
         int z = pos.x + pos.y * _layerSize.width;
         ssize_t atlasIndex = atlasIndexForExistantZ(z);
@@ -700,6 +814,317 @@ int TMXLayer::getVertexZForPos(const Point& pos)
     return ret;
 }
 
+// TMXLayer - chunks
+void TMXLayer::setupChunks()
+{
+    int layerWidth = static_cast<int>(_layerSize.width);
+    int layerHeight = static_cast<int>(_layerSize.height);
+
+    // tiles may be bigger than the map tiles, and rotated
+    Size tileSize = CC_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
+    float tileExtent = MAX(tileSize.width, tileSize.height);
+
+    _chunksPerRow = (layerWidth + _chunkSize - 1) / _chunkSize;
+    _chunks.reserve(_chunksPerRow * ((layerHeight + _chunkSize - 1) / _chunkSize));
+    _chunkMargin = 0;
+
+    for (int y = 0; y < layerHeight; y += _chunkSize)
+    {
+        for (int x = 0; x < layerWidth; x += _chunkSize)
+        {
+            TMXLayerChunk* chunk = new TMXLayerChunk();
+            chunk->x = x;
+            chunk->y = y;
+            chunk->width = MIN(_chunkSize, layerWidth - x);
+            chunk->height = MIN(_chunkSize, layerHeight - y);
+
+            // the corners of the chunk are enough to bound it, whatever the orientation
+            const Point corners[4] = {
+                getPositionAt(Point(x, y)),
+                getPositionAt(Point(x + chunk->width - 1, y)),
+                getPositionAt(Point(x, y + chunk->height - 1)),
+                getPositionAt(Point(x + chunk->width - 1, y + chunk->height - 1))
+            };
+
+            float minX = corners[0].x, maxX = corners[0].x;
+            float minY = corners[0].y, maxY = corners[0].y;
+            for (int i = 1; i < 4; ++i)
+            {
+                minX = MIN(minX, corners[i].x);
+                maxX = MAX(maxX, corners[i].x);
+                minY = MIN(minY, corners[i].y);
+                maxY = MAX(maxY, corners[i].y);
+            }
+
+            chunk->boundingBox = Rect(minX - tileExtent, minY - tileExtent, maxX - minX + tileExtent * 3, maxY - minY + tileExtent * 3);
+            _chunkMargin = MAX(_chunkMargin, MAX(chunk->boundingBox.size.width, chunk->boundingBox.size.height));
+
+            _chunks.push_back(chunk);
+        }
+    }
+}
+
+bool TMXLayer::isTileInChunk(int z) const
+{
+    uint32_t gid = _tiles[z] & kTMXFlippedMask;
+    return gid != 0 && static_cast<int>(gid) >= _tileSet->_firstGid && _tileSprites.find(z) == _tileSprites.end();
+}
+
+void TMXLayer::buildChunk(TMXLayerChunk* chunk)
+{
+    CC_SAFE_RELEASE_NULL(chunk->atlas);
+    chunk->built = true;
+    chunk->dirty = false;
+
+    int layerWidth = static_cast<int>(_layerSize.width);
+
+    ssize_t count = 0;
+    for (int y = chunk->y; y < chunk->y + chunk->height; ++y)
+    {
+        for (int x = chunk->x; x < chunk->x + chunk->width; ++x)
+        {
+            if (isTileInChunk(x + y * layerWidth))
+            {
+                ++count;
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    chunk->atlas = new TextureAtlas();
+    chunk->atlas->initWithTexture(_textureAtlas->getTexture(), count);
+
+    // same order as the non chunked layers: row by row
+    V3F_C4B_T2F_Quad quad;
+    ssize_t index = 0;
+    for (int y = chunk->y; y < chunk->y + chunk->height; ++y)
+    {
+        for (int x = chunk->x; x < chunk->x + chunk->width; ++x)
+        {
+            int z = x + y * layerWidth;
+            if (isTileInChunk(z))
+            {
+                setupTileQuad(&quad, Point(x, y), _tiles[z]);
+                chunk->atlas->updateQuad(&quad, index++);
+            }
+        }
+    }
+}
+
+void TMXLayer::setChunkDirtyAt(const Point& pos)
+{
+    int chunkX = static_cast<int>(pos.x) / _chunkSize;
+    int chunkY = static_cast<int>(pos.y) / _chunkSize;
+    _chunks[chunkX + chunkY * _chunksPerRow]->dirty = true;
+}
+
+ssize_t TMXLayer::getBuiltChunksCount() const
+{
+    ssize_t count = 0;
+    for (const auto chunk : _chunks)
+    {
+        if (chunk->built)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void TMXLayer::setupTileQuad(V3F_C4B_T2F_Quad* quad, const Point& pos, uint32_t gid)
+{
+    // same result as setupTileSprite(), without going through a sprite
+    Rect rect = _tileSet->getRectForGID(gid);
+    Texture2D *texture = _textureAtlas->getTexture();
+
+    float atlasWidth = (float)texture->getPixelsWide();
+    float atlasHeight = (float)texture->getPixelsHigh();
+
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+    float left      = (2*rect.origin.x+1)/(2*atlasWidth);
+    float right     = left + (rect.size.width*2-2)/(2*atlasWidth);
+    float top       = (2*rect.origin.y+1)/(2*atlasHeight);
+    float bottom    = top + (rect.size.height*2-2)/(2*atlasHeight);
+#else
+    float left      = rect.origin.x/atlasWidth;
+    float right     = (rect.origin.x + rect.size.width) / atlasWidth;
+    float top       = rect.origin.y/atlasHeight;
+    float bottom    = (rect.origin.y + rect.size.height) / atlasHeight;
+#endif // ! CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+    Tex2F bl(left, bottom), br(right, bottom), tl(left, top), tr(right, top);
+
+    bool flippedX = false;
+    bool flippedY = false;
+    float rotation = 0;
+
+    // Rotation in tiled is achieved using 3 flipped states, flipping across the horizontal, vertical, and diagonal axes of the tiles.
+    if (gid & kTMXTileDiagonalFlag)
+    {
+        int flag = gid & (kTMXTileHorizontalFlag | kTMXTileVerticalFlag );
+
+        // handle the 4 diagonally flipped states.
+        if (flag == kTMXTileHorizontalFlag)
+        {
+            rotation = 90;
+        }
+        else if (flag == kTMXTileVerticalFlag)
+        {
+            rotation = 270;
+        }
+        else if (flag == (kTMXTileVerticalFlag | kTMXTileHorizontalFlag) )
+        {
+            rotation = 90;
+            flippedX = true;
+        }
+        else
+        {
+            rotation = 270;
+            flippedX = true;
+        }
+    }
+    else
+    {
+        flippedX = (gid & kTMXTileHorizontalFlag) != 0;
+        flippedY = (gid & kTMXTileVerticalFlag) != 0;
+    }
+
+    if (flippedX)
+    {
+        std::swap(bl, br);
+        std::swap(tl, tr);
+    }
+
+    if (flippedY)
+    {
+        std::swap(bl, tl);
+        std::swap(br, tr);
+    }
+
+    Size size = CC_SIZE_PIXELS_TO_POINTS(rect.size);
+
+    // rotating clockwise moves each corner of the texture to the next corner of the quad
+    if (rotation == 90)
+    {
+        Tex2F temp = bl;
+        bl = br;
+        br = tr;
+        tr = tl;
+        tl = temp;
+        std::swap(size.width, size.height);
+    }
+    else if (rotation == 270)
+    {
+        Tex2F temp = bl;
+        bl = tl;
+        tl = tr;
+        tr = br;
+        br = temp;
+        std::swap(size.width, size.height);
+    }
+
+    Point origin = getPositionAt(pos);
+    float vertexZ = (float)getVertexZForPos(pos);
+
+    quad->bl.vertices = Vertex3F(origin.x, origin.y, vertexZ);
+    quad->br.vertices = Vertex3F(origin.x + size.width, origin.y, vertexZ);
+    quad->tl.vertices = Vertex3F(origin.x, origin.y + size.height, vertexZ);
+    quad->tr.vertices = Vertex3F(origin.x + size.width, origin.y + size.height, vertexZ);
+
+    quad->bl.texCoords = bl;
+    quad->br.texCoords = br;
+    quad->tl.texCoords = tl;
+    quad->tr.texCoords = tr;
+
+    Color4B color(255, 255, 255, _opacity);
+    // special opacity for premultiplied textures
+    if (texture->hasPremultipliedAlpha())
+    {
+        color.r = color.g = color.b = _opacity;
+    }
+
+    quad->bl.colors = color;
+    quad->br.colors = color;
+    quad->tl.colors = color;
+    quad->tr.colors = color;
+}
+
+void TMXLayer::draw(Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
+{
+    if (_chunkSize > 0)
+    {
+        drawChunks(renderer, transform);
+    }
+
+    // tile sprites
+    SpriteBatchNode::draw(renderer, transform, transformUpdated);
+}
+
+void TMXLayer::drawChunks(Renderer *renderer, const kmMat4 &transform)
+{
+    kmMat4 inverse;
+    if (kmMat4Inverse(&inverse, &transform) == nullptr)
+    {
+        return;
+    }
+
+    // the screen, in the layer space
+    Director* director = Director::getInstance();
+    Point origin = director->getVisibleOrigin();
+    Size size = director->getVisibleSize();
+
+    const kmVec3 corners[4] = {
+        { origin.x, origin.y, 0 },
+        { origin.x + size.width, origin.y, 0 },
+        { origin.x, origin.y + size.height, 0 },
+        { origin.x + size.width, origin.y + size.height, 0 }
+    };
+
+    kmVec3 corner;
+    kmVec3Transform(&corner, &corners[0], &inverse);
+    float minX = corner.x, maxX = corner.x;
+    float minY = corner.y, maxY = corner.y;
+    for (int i = 1; i < 4; ++i)
+    {
+        kmVec3Transform(&corner, &corners[i], &inverse);
+        minX = MIN(minX, corner.x);
+        maxX = MAX(maxX, corner.x);
+        minY = MIN(minY, corner.y);
+        maxY = MAX(maxY, corner.y);
+    }
+
+    Rect visibleRect(minX, minY, maxX - minX, maxY - minY);
+    // chunks are built one chunk ahead, and only released two chunks away, so that they don't flicker in and out
+    Rect nearRect(minX - _chunkMargin, minY - _chunkMargin, visibleRect.size.width + _chunkMargin * 2, visibleRect.size.height + _chunkMargin * 2);
+    Rect farRect(minX - _chunkMargin * 2, minY - _chunkMargin * 2, visibleRect.size.width + _chunkMargin * 4, visibleRect.size.height + _chunkMargin * 4);
+
+    for (auto chunk : _chunks)
+    {
+        if (chunk->boundingBox.intersectsRect(nearRect))
+        {
+            if (! chunk->built || chunk->dirty)
+            {
+                buildChunk(chunk);
+            }
+
+            if (chunk->atlas && chunk->boundingBox.intersectsRect(visibleRect))
+            {
+                chunk->command.init(_globalZOrder, _shaderProgram, _blendFunc, chunk->atlas, transform);
+                renderer->addCommand(&chunk->command);
+            }
+        }
+        else if (chunk->built && ! chunk->boundingBox.intersectsRect(farRect))
+        {
+            CC_SAFE_RELEASE_NULL(chunk->atlas);
+            chunk->built = false;
+        }
+    }
+}
+
 std::string TMXLayer::getDescription() const
 {
     return StringUtils::format("<TMXLayer | tag = %d, size = %d,%d>", _tag, (int)_mapTileSize.width, (int)_mapTileSize.height);
@@ -32,12 +32,17 @@ THE SOFTWARE.
 #include "CCSpriteBatchNode.h"
 #include "CCTMXXMLParser.h"
 #include "ccCArray.h"
+
+#include <vector>
+#include <unordered_set>
+
 NS_CC_BEGIN
 
 class TMXMapInfo;
 class TMXLayerInfo;
 class TMXTilesetInfo;
 struct _ccCArray;
+struct TMXLayerChunk;
 
 /**
  * @addtogroup tilemap_parallax_nodes
@@ -71,6 +76,14 @@ http://www.cocos2d-iphone.org/wiki/doku.php/prog_guide:tiled_maps
 Tiles can have tile flags for additional properties. At the moment only flip horizontal and flip vertical are used. These bit flags are defined in TMXXMLParser.h.
 
 @since 1.1
+
+Very large layers can be rendered in chunks: square groups of tiles that own their vertex buffer.
+A chunk is only built when it gets close to the screen, and is released when it goes far away,
+so the memory and the setup time don't depend on the size of the layer anymore.
+Changing or removing a tile only rebuilds the chunk that holds it.
+A layer is chunked when it has a "cc_chunk_size" property (the number of tiles on each side of a chunk),
+or when it has at least CC_TMX_CHUNKED_LAYER_THRESHOLD tiles (see ccConfig.h).
+Tiles returned by getTileAt() are drawn above the chunks, and releaseMap() has no effect on chunked layers.
 */
 
 class CC_DLL TMXLayer : public SpriteBatchNode
@@ -180,6 +193,12 @@ public:
     inline void setProperties(const ValueMap& properties) {
         _properties = properties;
     };
+
+    /** number of tiles on each side of a chunk, 0 when the layer is not rendered in chunks */
+    inline int getChunkSize() const { return _chunkSize; };
+
+    /** number of chunks currently holding their vertices */
+    ssize_t getBuiltChunksCount() const;
     //
     // Override
     //
@@ -190,6 +209,7 @@ public:
     virtual void addChild(Node * child, int zOrder, int tag) override;
     // super method
     void removeChild(Node* child, bool cleanup) override;
+    virtual void draw(Renderer *renderer, const kmMat4 &transform, bool transformUpdated) override;
     virtual std::string getDescription() const override;
 
 private:
@@ -213,6 +233,14 @@ private:
     // index
     ssize_t atlasIndexForExistantZ(int z);
     ssize_t atlasIndexForNewZ(int z);
+
+    /* chunked rendering */
+    void setupChunks();
+    void buildChunk(TMXLayerChunk* chunk);
+    void drawChunks(Renderer *renderer, const kmMat4 &transform);
+    void setupTileQuad(V3F_C4B_T2F_Quad* quad, const Point& pos, uint32_t gid);
+    bool isTileInChunk(int z) const;
+    void setChunkDirtyAt(const Point& pos);
     
 protected:
     //! name of the layer
@@ -243,6 +271,15 @@ protected:
     int _layerOrientation;
     /** properties from the layer. They can be added using Tiled */
     ValueMap _properties;
+
+    //! number of tiles on each side of a chunk, 0 when the layer is not chunked
+    int _chunkSize;
+    int _chunksPerRow;
+    std::vector<TMXLayerChunk*> _chunks;
+    //! distance from the screen, in points, under which the chunks are built
+    float _chunkMargin;
+    //! tiles of a chunked layer that were turned into sprites by getTileAt()
+    std::unordered_set<int> _tileSprites;
 };
 
 // end of tilemap_parallax_nodes group
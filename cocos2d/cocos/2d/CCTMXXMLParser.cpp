@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "CCTMXTiledMap.h"
 #include "ccMacros.h"
 #include "platform/CCFileUtils.h"
+#include "platform/CCBinaryValueCache.h"
 #include "ZipUtils.h"
 #include "base64.h"
 #include "CCDirector.h"
@@ -420,7 +421,16 @@ void TMXMapInfo::startElement(void *ctx, const char *name, const char **atts)
         {
             int layerAttribs = tmxMapInfo->getLayerAttribs();
             tmxMapInfo->setLayerAttribs(layerAttribs | TMXLayerAttribBase64);
-            tmxMapInfo->setStoringCharacters(true);
+
+            // a baked layer doesn't need its characters to be stored, decoded and inflated
+            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
+            BinaryValueCache* cache = BinaryValueCache::getInstance();
+            if (cache->isEnabled() && !_TMXFileName.empty())
+            {
+                layer->_tiles = cache->loadTiles(_TMXFileName, static_cast<int>(tmxMapInfo->getLayers().size()) - 1,
+                                                 static_cast<ssize_t>(layer->_layerSize.width * layer->_layerSize.height));
+            }
+            tmxMapInfo->setStoringCharacters(layer->_tiles == nullptr);
 
             if( compression == "gzip" )
             {
@@ -633,6 +643,12 @@ void TMXMapInfo::endElement(void *ctx, const char *name)
             tmxMapInfo->setStoringCharacters(false);
             
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
+            if (layer->_tiles)
+            {
+                // loaded from the BinaryValueCache
+                tmxMapInfo->setCurrentString("");
+                return;
+            }
             
             std::string currentString = tmxMapInfo->getCurrentString();
             unsigned char *buffer;
@@ -668,6 +684,13 @@ void TMXMapInfo::endElement(void *ctx, const char *name)
             {
                 layer->_tiles = reinterpret_cast<uint32_t*>(buffer);
             }
+
+            BinaryValueCache* cache = BinaryValueCache::getInstance();
+            if (cache->isEnabled() && !_TMXFileName.empty())
+            {
+                cache->saveTiles(_TMXFileName, static_cast<int>(tmxMapInfo->getLayers().size()) - 1, layer->_tiles,
+                                 static_cast<ssize_t>(layer->_layerSize.width * layer->_layerSize.height));
+            }
             
             tmxMapInfo->setCurrentString("");
         }
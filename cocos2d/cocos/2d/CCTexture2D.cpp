@@ -432,6 +432,7 @@ Texture2D::Texture2D()
 , _maxT(0.0)
 , _hasPremultipliedAlpha(false)
 , _hasMipmaps(false)
+, _memoryBytes(0)
 , _shaderProgram(nullptr)
 , _antialiasEnabled(true)
 {
@@ -651,6 +652,7 @@ bool Texture2D::initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, PixelFormat
     // Specify OpenGL texture image
     int width = pixelsWide;
     int height = pixelsHigh;
+    _memoryBytes = 0;
     
     for (int i = 0; i < mipmapsNum; ++i)
     {
@@ -660,10 +662,12 @@ bool Texture2D::initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, PixelFormat
         if (info.compressed)
         {
             glCompressedTexImage2D(GL_TEXTURE_2D, i, info.internalFormat, (GLsizei)width, (GLsizei)height, 0, datalen, data);
+            _memoryBytes += datalen;
         }
         else
         {
             glTexImage2D(GL_TEXTURE_2D, i, info.internalFormat, (GLsizei)width, (GLsizei)height, 0, info.format, info.type, data);
+            _memoryBytes += (size_t)width * height * info.bpp / 8;
         }
 
         if (i > 0 && (width != height || ccNextPOT(width) != width ))
@@ -1237,6 +1241,16 @@ void Texture2D::generateMipmap()
     CCASSERT(_pixelsWide == ccNextPOT(_pixelsWide) && _pixelsHigh == ccNextPOT(_pixelsHigh), "Mipmap texture only works in POT textures");
     GL::bindTexture2D( _name );
     glGenerateMipmap(GL_TEXTURE_2D);
+
+    if (!_hasMipmaps)
+    {
+        // the levels below the first one
+        unsigned int bpp = getBitsPerPixelForFormat();
+        for (int width = _pixelsWide >> 1, height = _pixelsHigh >> 1; width > 0 || height > 0; width >>= 1, height >>= 1)
+        {
+            _memoryBytes += (size_t)MAX(width, 1) * MAX(height, 1) * bpp / 8;
+        }
+    }
     _hasMipmaps = true;
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     VolatileTextureMgr::setHasMipmaps(this, _hasMipmaps);
@@ -1331,8 +1345,16 @@ void Texture2D::setAntiAliasTexParameters()
 
 const char* Texture2D::getStringForFormat() const
 {
-	switch (_pixelFormat) 
+    return getStringForFormat(_pixelFormat);
+}
+
+const char* Texture2D::getStringForFormat(Texture2D::PixelFormat format)
+{
+	switch (format)
 	{
+		case Texture2D::PixelFormat::BGRA8888:
+			return  "BGRA8888";
+
 		case Texture2D::PixelFormat::RGBA8888:
 			return  "RGBA8888";
 
@@ -1363,9 +1385,36 @@ const char* Texture2D::getStringForFormat() const
 		case Texture2D::PixelFormat::PVRTC2:
 			return  "PVRTC2";
 
+		case Texture2D::PixelFormat::PVRTC4A:
+			return  "PVRTC4A";
+
+		case Texture2D::PixelFormat::PVRTC2A:
+			return  "PVRTC2A";
+
+		case Texture2D::PixelFormat::ETC:
+			return  "ETC";
+
+		case Texture2D::PixelFormat::S3TC_DXT1:
+			return  "S3TC_DXT1";
+
+		case Texture2D::PixelFormat::S3TC_DXT3:
+			return  "S3TC_DXT3";
+
+		case Texture2D::PixelFormat::S3TC_DXT5:
+			return  "S3TC_DXT5";
+
+		case Texture2D::PixelFormat::ATC_RGB:
+			return  "ATC_RGB";
+
+		case Texture2D::PixelFormat::ATC_EXPLICIT_ALPHA:
+			return  "ATC_EXPLICIT_ALPHA";
+
+		case Texture2D::PixelFormat::ATC_INTERPOLATED_ALPHA:
+			return  "ATC_INTERPOLATED_ALPHA";
+
 		default:
 			CCASSERT(false , "unrecognized pixel format");
-			CCLOG("stringForFormat: %ld, cannot give useful result", (long)_pixelFormat);
+			CCLOG("stringForFormat: %ld, cannot give useful result", (long)format);
 			break;
 	}
 
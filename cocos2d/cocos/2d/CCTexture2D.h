@@ -308,6 +308,11 @@ public:
     const char* getStringForFormat() const;
     CC_DEPRECATED_ATTRIBUTE const char* stringForFormat() const { return getStringForFormat(); };
 
+    /** returns the name of a pixel format
+     @since v3.0
+     */
+    static const char* getStringForFormat(Texture2D::PixelFormat format);
+
     /** returns the bits-per-pixel of the in-memory OpenGL texture
     @since v1.0
     */
@@ -326,6 +331,12 @@ public:
     bool hasPremultipliedAlpha() const;
     bool hasMipmaps() const;
 
+    /** Gets the number of bytes of GPU memory used by the texture and its mipmaps.
+     The compressed textures count the size of their compressed data.
+     @since v3.0
+     */
+    size_t getMemoryBytes() const { return _memoryBytes; }
+
     /** Gets the pixel format of the texture */
     Texture2D::PixelFormat getPixelFormat() const;
     
@@ -432,6 +443,9 @@ protected:
 
     bool _hasMipmaps;
 
+    /** bytes used by all the mipmap levels */
+    size_t _memoryBytes;
+
     /** shader program used by drawAtPoint and drawInRect */
     GLProgram* _shaderProgram;
 
@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include "CCTexture2D.h"
 #include "deprecated/CCString.h"
 #include <stdlib.h>
+#include <algorithm>
 #include "CCEventDispatcher.h"
 #include "CCEventListenerCustom.h"
 
@@ -53,6 +54,8 @@ NS_CC_BEGIN
 TextureAtlas::TextureAtlas()
     :_indices(nullptr)
     ,_dirty(false)
+    ,_dirtyStart(0)
+    ,_dirtyEnd(0)
     ,_texture(nullptr)
     ,_quads(nullptr)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -106,7 +109,7 @@ void TextureAtlas::setTexture(Texture2D * var)
 V3F_C4B_T2F_Quad* TextureAtlas::getQuads()
 {
     //if someone accesses the quads directly, presume that changes will be made
-    _dirty = true;
+    setDirty(true);
     return _quads;
 }
 
@@ -207,7 +210,7 @@ bool TextureAtlas::initWithTexture(Texture2D *texture, ssize_t capacity)
         setupVBO();
     }
 
-    _dirty = true;
+    setDirty(true);
 
     return true;
 }
@@ -224,7 +227,7 @@ void TextureAtlas::listenBackToForeground(EventCustom* event)
     }
     
     // set _dirty to true to force it rebinding buffer
-    _dirty = true;
+    setDirty(true);
 }
 
 std::string TextureAtlas::getDescription() const
@@ -321,9 +324,7 @@ void TextureAtlas::updateQuad(V3F_C4B_T2F_Quad *quad, ssize_t index)
 
     _quads[index] = *quad;    
 
-
-    _dirty = true;
-
+    setDirtyRange(index, 1);
 }
 
 void TextureAtlas::insertQuad(V3F_C4B_T2F_Quad *quad, ssize_t index)
@@ -345,9 +346,8 @@ void TextureAtlas::insertQuad(V3F_C4B_T2F_Quad *quad, ssize_t index)
 
     _quads[index] = *quad;
 
-
-    _dirty = true;
-
+    // the following quads moved too
+    setDirtyRange(index, _totalQuads - index);
 }
 
 void TextureAtlas::insertQuads(V3F_C4B_T2F_Quad* quads, ssize_t index, ssize_t amount)
@@ -378,7 +378,8 @@ void TextureAtlas::insertQuads(V3F_C4B_T2F_Quad* quads, ssize_t index, ssize_t a
         j++;
     }
 
-    _dirty = true;
+    // the following quads moved too
+    setDirtyRange(max - amount, _totalQuads - (max - amount));
 }
 
 void TextureAtlas::insertQuadFromIndex(ssize_t oldIndex, ssize_t newIndex)
@@ -406,8 +407,19 @@ void TextureAtlas::insertQuadFromIndex(ssize_t oldIndex, ssize_t newIndex)
     memmove( &_quads[dst],&_quads[src], sizeof(_quads[0]) * howMany );
     _quads[newIndex] = quadsBackup;
 
+    // only the quads between the two indexes moved
+    setDirtyRange(MIN(oldIndex, newIndex), howMany + 1);
+}
 
-    _dirty = true;
+void TextureAtlas::swapQuads(ssize_t index, ssize_t otherIndex)
+{
+    CCASSERT( index >= 0 && index < _totalQuads, "swapQuads: Invalid index");
+    CCASSERT( otherIndex >= 0 && otherIndex < _totalQuads, "swapQuads: Invalid index");
+
+    std::swap(_quads[index], _quads[otherIndex]);
+
+    setDirtyRange(index, 1);
+    setDirtyRange(otherIndex, 1);
 }
 
 void TextureAtlas::removeQuadAtIndex(ssize_t index)
@@ -425,8 +437,7 @@ void TextureAtlas::removeQuadAtIndex(ssize_t index)
 
     _totalQuads--;
 
-
-    _dirty = true;
+    setDirtyRange(index, remaining);
 }
 
 void TextureAtlas::removeQuadsAtIndex(ssize_t index, ssize_t amount)
@@ -442,7 +453,7 @@ void TextureAtlas::removeQuadsAtIndex(ssize_t index, ssize_t amount)
         memmove( &_quads[index], &_quads[index+amount], sizeof(_quads[0]) * remaining );
     }
 
-    _dirty = true;
+    setDirtyRange(index, remaining);
 }
 
 void TextureAtlas::removeAllQuads()
@@ -521,7 +532,7 @@ bool TextureAtlas::resizeCapacity(ssize_t newCapacity)
     setupIndices();
     mapBuffers();
 
-    _dirty = true;
+    setDirty(true);
 
     return true;
 }
@@ -530,6 +541,8 @@ void TextureAtlas::increaseTotalQuadsWith(ssize_t amount)
 {
     CCASSERT(amount>=0, "amount >= 0");
     _totalQuads += amount;
+    // the new quads may have been written through getQuads() before they were counted
+    setDirtyRange(_totalQuads - amount, amount);
 }
 
 void TextureAtlas::moveQuadsFromIndex(ssize_t oldIndex, ssize_t amount, ssize_t newIndex)
@@ -561,7 +574,7 @@ void TextureAtlas::moveQuadsFromIndex(ssize_t oldIndex, ssize_t amount, ssize_t
 
     free(tempQuads);
 
-    _dirty = true;
+    setDirtyRange(MIN(oldIndex, newIndex), (oldIndex > newIndex ? oldIndex - newIndex : newIndex - oldIndex) + amount);
 }
 
 void TextureAtlas::moveQuadsFromIndex(ssize_t index, ssize_t newIndex)
@@ -570,6 +583,8 @@ void TextureAtlas::moveQuadsFromIndex(ssize_t index, ssize_t newIndex)
     CCASSERT(newIndex + (_totalQuads - index) <= _capacity, "moveQuadsFromIndex move is out of bounds");
 
     memmove(_quads + newIndex,_quads + index, (_totalQuads - index) * sizeof(_quads[0]));
+
+    setDirtyRange(newIndex, _totalQuads - index);
 }
 
 void TextureAtlas::fillWithEmptyQuadsFromIndex(ssize_t index, ssize_t amount)
@@ -583,6 +598,53 @@ void TextureAtlas::fillWithEmptyQuadsFromIndex(ssize_t index, ssize_t amount)
     {
         _quads[i] = quad;
     }
+
+    setDirtyRange(index, amount);
+}
+
+void TextureAtlas::setDirtyRange(ssize_t index, ssize_t amount)
+{
+    if (amount <= 0)
+    {
+        return;
+    }
+
+    if (_dirty)
+    {
+        _dirtyStart = MIN(_dirtyStart, index);
+        _dirtyEnd = MAX(_dirtyEnd, index + amount);
+    }
+    else
+    {
+        _dirtyStart = index;
+        _dirtyEnd = index + amount;
+        _dirty = true;
+    }
+}
+
+void TextureAtlas::uploadDirtyQuads(ssize_t drawnQuads)
+{
+    // the GL_ARRAY_BUFFER must be bound to the VBO of the quads
+
+    // quads past the drawn ones are uploaded when they are drawn
+    ssize_t end = MIN(_dirtyEnd, MAX(_totalQuads, drawnQuads));
+    end = MIN(end, _capacity);
+
+    if (end - _dirtyStart >= _capacity / 2)
+    {
+        // most of the buffer changed: orphan it instead of waiting for the draws that still use it
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * _capacity, _quads, GL_DYNAMIC_DRAW);
+        CC_INCREMENT_GL_UPLOADED_BYTES(sizeof(_quads[0]) * _capacity);
+        end = _dirtyEnd;
+    }
+    else if (end > _dirtyStart)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * _dirtyStart, sizeof(_quads[0]) * (end - _dirtyStart), &_quads[_dirtyStart]);
+        CC_INCREMENT_GL_UPLOADED_BYTES(sizeof(_quads[0]) * (end - _dirtyStart));
+    }
+
+    _dirtyStart = MAX(_dirtyStart, end);
+    _dirty = _dirtyStart < _dirtyEnd;
 }
 
 // TextureAtlas - Drawing
@@ -617,21 +679,8 @@ void TextureAtlas::drawNumberOfQuads(ssize_t numberOfQuads, ssize_t start)
         if (_dirty) 
         {
             glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-            // option 1: subdata
-//            glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0])*start, sizeof(_quads[0]) * n , &_quads[start] );
-
-            // option 2: data
-//            glBufferData(GL_ARRAY_BUFFER, sizeof(quads_[0]) * (n-start), &quads_[start], GL_DYNAMIC_DRAW);
-
-            // option 3: orphaning + glMapBuffer
-            glBufferData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * (numberOfQuads-start), nullptr, GL_DYNAMIC_DRAW);
-            void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-            memcpy(buf, _quads, sizeof(_quads[0])* (numberOfQuads-start));
-            glUnmapBuffer(GL_ARRAY_BUFFER);
-            
+            uploadDirtyQuads(start + numberOfQuads);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-            _dirty = false;
         }
 
         GL::bindVAO(_VAOname);
@@ -660,8 +709,7 @@ void TextureAtlas::drawNumberOfQuads(ssize_t numberOfQuads, ssize_t start)
         // XXX: update is done in draw... perhaps it should be done in a timer
         if (_dirty) 
         {
-            glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0])*start, sizeof(_quads[0]) * numberOfQuads , &_quads[start] );
-            _dirty = false;
+            uploadDirtyQuads(start + numberOfQuads);
         }
 
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
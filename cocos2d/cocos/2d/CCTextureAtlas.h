@@ -122,6 +122,11 @@ public:
     */
     void insertQuadFromIndex(ssize_t fromIndex, ssize_t newIndex);
 
+    /** Swaps the quads located at two indexes.
+    Only these two quads are uploaded to the VBO again.
+    */
+    void swapQuads(ssize_t index, ssize_t otherIndex);
+
     /** removes a quad at a given index number.
     The capacity remains the same, but the total number of quads to be drawn is reduced in 1
     @since v0.7.2
@@ -194,8 +199,18 @@ public:
 
     /** whether or not the array buffer of the VBO needs to be updated*/
     inline bool isDirty(void) { return _dirty; }
-    /** specify if the array buffer of the VBO needs to be updated */
-    inline void setDirty(bool bDirty) { _dirty = bDirty; }
+    /** specify if the array buffer of the VBO needs to be updated. When true, all the quads in use are uploaded again */
+    inline void setDirty(bool bDirty)
+    {
+        // quads past _totalQuads are marked again when they are added, see increaseTotalQuadsWith()
+        _dirtyStart = 0;
+        _dirtyEnd = bDirty ? _totalQuads : 0;
+        _dirty = _dirtyEnd > 0;
+    }
+    /** Marks amount quads from index as modified: only the modified quads are uploaded to the VBO before the next draw.
+     Use it after modifying the quads returned by getQuads() in place, getQuads() itself marks all of them as modified.
+     */
+    void setDirtyRange(ssize_t index, ssize_t amount);
     /**
      * @js NA
      * @lua NA
@@ -227,12 +242,16 @@ private:
     void mapBuffers();
     void setupVBOandVAO();
     void setupVBO();
+    void uploadDirtyQuads(ssize_t drawnQuads);
 
 protected:
     GLushort*           _indices;
     GLuint              _VAOname;
     GLuint              _buffersVBO[2]; //0: vertex  1: indices
     bool                _dirty; //indicates whether or not the array buffer of the VBO needs to be updated
+    /** range of quads, [_dirtyStart, _dirtyEnd), that needs to be uploaded to the VBO */
+    ssize_t _dirtyStart;
+    ssize_t _dirtyEnd;
     /** quantity of quads that are going to be drawn */
     ssize_t _totalQuads;
     /** quantity of quads that can be stored with the current texture atlas size */
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
 
 #include "CCTextureCache.h"
 #include "CCTexture2D.h"
@@ -38,6 +39,10 @@ THE SOFTWARE.
 #include "ccUtils.h"
 #include "CCScheduler.h"
 #include "deprecated/CCString.h"
+#include "CCProfiling.h"
+#include "CCEventType.h"
+#include "CCEventCustom.h"
+#include "CCEventDispatcher.h"
 
 
 #ifdef EMSCRIPTEN
@@ -62,6 +67,11 @@ TextureCache::TextureCache()
 , _imageInfoQueue(nullptr)
 , _needQuit(false)
 , _asyncRefCount(0)
+, _totalBytes(0)
+, _memoryBudget(0)
+, _useCounter(0)
+, _evictedTextures(0)
+, _reloadedTextures(0)
 {
 }
 
@@ -105,6 +115,7 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 
     if (texture != nullptr)
     {
+        touchTexture(fullpath, texture);
         callback(texture);
         return;
     }
@@ -189,6 +200,8 @@ void TextureCache::loadImage()
 
         if (generateImage)
         {
+            CC_PROFILER_ZONE("TextureCache - decode image (async)");
+
             const std::string& filename = asyncStruct->filename;
             // generate image      
             image = new Image();
@@ -244,6 +257,8 @@ void TextureCache::addImageAsyncCallBack(float dt)
         Texture2D *texture = nullptr;
         if (image)
         {
+            CC_PROFILER_ZONE("TextureCache - upload image (async)");
+
             // generate texture in render thread
             texture = new Texture2D();
 
@@ -258,6 +273,8 @@ void TextureCache::addImageAsyncCallBack(float dt)
             texture->retain();
 
             texture->autorelease();
+
+            addTextureInfo(filename, texture, true);
         }
         else
         {
@@ -297,10 +314,15 @@ Texture2D * TextureCache::addImage(const std::string &path)
     }
     auto it = _textures.find(fullpath);
     if( it != _textures.end() )
+    {
         texture = it->second;
+        touchTexture(fullpath, texture);
+    }
 
     if (! texture)
     {
+        CC_PROFILER_ZONE("TextureCache - addImage");
+
         // all images are handled by UIImage except PVR extension that is handled by our own handler
         do 
         {
@@ -320,6 +342,7 @@ Texture2D * TextureCache::addImage(const std::string &path)
 #endif
                 // texture already retained, no need to re-retain it
                 _textures.insert( std::make_pair(fullpath, texture) );
+                addTextureInfo(fullpath, texture, true);
             }
             else
             {
@@ -357,6 +380,8 @@ Texture2D* TextureCache::addImage(Image *image, const std::string &key)
             texture->retain();
 
             texture->autorelease();
+
+            addTextureInfo(key, texture, false);
         }
         else
         {
@@ -403,6 +428,9 @@ bool TextureCache::reloadTexture(const std::string& fileName)
             
             ret = texture->initWithImage(image);
         } while (0);
+
+        // the new image might have another size or format
+        touchTexture(fullpath, texture);
     }
 
     return ret;
@@ -416,6 +444,10 @@ void TextureCache::removeAllTextures()
         (it->second)->release();
     }
     _textures.clear();
+
+    _texturesInfo.clear();
+    _bytesPerPixelFormat.clear();
+    _totalBytes = 0;
 }
 
 void TextureCache::removeUnusedTextures()
@@ -425,6 +457,7 @@ void TextureCache::removeUnusedTextures()
         if( tex->getReferenceCount() == 1 ) {
             CCLOG("cocos2d: TextureCache: removing unused texture: %s", it->first.c_str());
 
+            removeTextureInfo(it->first);
             tex->release();
             _textures.erase(it++);
         } else {
@@ -443,6 +476,7 @@ void TextureCache::removeTexture(Texture2D* texture)
 
     for( auto it=_textures.cbegin(); it!=_textures.cend(); /* nothing */ ) {
         if( it->second == texture ) {
+            removeTextureInfo(it->first);
             texture->release();
             _textures.erase(it++);
             break;
@@ -462,6 +496,7 @@ void TextureCache::removeTextureForKey(const std::string &textureKeyName)
     }
 
     if( it != _textures.end() ) {
+        removeTextureInfo(it->first);
         (it->second)->release();
         _textures.erase(it);
     }
@@ -482,6 +517,127 @@ Texture2D* TextureCache::getTextureForKey(const std::string &textureKeyName) con
     return nullptr;
 }
 
+void TextureCache::addTextureInfo(const std::string& key, Texture2D* texture, bool fromFile)
+{
+    TextureInfo& info = _texturesInfo[key];
+    info.lastUse = ++_useCounter;
+    info.lastUseFrame = Director::getInstance()->getTotalFrames();
+    info.bytes = texture->getMemoryBytes();
+    info.pixelFormat = texture->getPixelFormat();
+    info.fromFile = fromFile;
+
+    _totalBytes += info.bytes;
+    _bytesPerPixelFormat[info.pixelFormat] += info.bytes;
+
+    if (fromFile && !_evictedKeys.empty() && _evictedKeys.erase(key) > 0)
+    {
+        ++_reloadedTextures;
+    }
+}
+
+void TextureCache::removeTextureInfo(const std::string& key)
+{
+    auto it = _texturesInfo.find(key);
+    if (it != _texturesInfo.end())
+    {
+        _totalBytes -= it->second.bytes;
+        _bytesPerPixelFormat[it->second.pixelFormat] -= it->second.bytes;
+        _texturesInfo.erase(it);
+    }
+}
+
+void TextureCache::touchTexture(const std::string& key, Texture2D* texture)
+{
+    auto it = _texturesInfo.find(key);
+    if (it == _texturesInfo.end())
+    {
+        return;
+    }
+
+    TextureInfo& info = it->second;
+    info.lastUse = ++_useCounter;
+    info.lastUseFrame = Director::getInstance()->getTotalFrames();
+
+    // mipmaps generated later, or reloaded with another image
+    if (info.bytes != texture->getMemoryBytes() || info.pixelFormat != texture->getPixelFormat())
+    {
+        _totalBytes -= info.bytes;
+        _bytesPerPixelFormat[info.pixelFormat] -= info.bytes;
+
+        info.bytes = texture->getMemoryBytes();
+        info.pixelFormat = texture->getPixelFormat();
+
+        _totalBytes += info.bytes;
+        _bytesPerPixelFormat[info.pixelFormat] += info.bytes;
+    }
+}
+
+size_t TextureCache::getBytesForPixelFormat(Texture2D::PixelFormat format) const
+{
+    auto it = _bytesPerPixelFormat.find(format);
+    return it != _bytesPerPixelFormat.end() ? it->second : 0;
+}
+
+void TextureCache::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    trimToMemoryBudget();
+}
+
+void TextureCache::trimToMemoryBudget()
+{
+    if (_memoryBudget == 0 || _totalBytes <= _memoryBudget)
+    {
+        return;
+    }
+
+    // the textures requested in this frame may not be retained yet by the code that asked for them
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+
+    std::vector<std::pair<unsigned int, std::string>> candidates;
+    for (auto& entry : _texturesInfo)
+    {
+        if (entry.second.fromFile && entry.second.lastUseFrame != frame)
+        {
+            candidates.push_back(std::make_pair(entry.second.lastUse, entry.first));
+        }
+    }
+
+    // least recently requested first
+    std::sort(candidates.begin(), candidates.end());
+
+    EventDispatcher *dispatcher = Director::getInstance()->getEventDispatcher();
+
+    for (auto& candidate : candidates)
+    {
+        if (_totalBytes <= _memoryBudget)
+        {
+            break;
+        }
+
+        auto it = _textures.find(candidate.second);
+        // only the cache references it
+        if (it == _textures.end() || it->second->getReferenceCount() != 1)
+        {
+            continue;
+        }
+
+        CCLOG("cocos2d: TextureCache: evicting texture: %s", it->first.c_str());
+
+        const std::string key = it->first;
+        removeTextureInfo(key);
+        it->second->release();
+        _textures.erase(it);
+
+        _evictedKeys.insert(key);
+        ++_evictedTextures;
+
+        EventCustom event(EVENT_TEXTURE_EVICTED);
+        event.setUserData((void*)&key);
+        dispatcher->dispatchEvent(&event);
+    }
+}
+
 void TextureCache::reloadAllTextures()
 {
 //will do nothing
@@ -504,7 +660,6 @@ std::string TextureCache::getCachedTextureInfo() const
     char buftmp[4096];
 
     unsigned int count = 0;
-    unsigned int totalBytes = 0;
 
     for( auto it = _textures.begin(); it != _textures.end(); ++it ) {
 
@@ -513,9 +668,8 @@ std::string TextureCache::getCachedTextureInfo() const
 
         Texture2D* tex = it->second;
         unsigned int bpp = tex->getBitsPerPixelForFormat();
-        // Each texture takes up width * height * bytesPerPixel bytes.
-        auto bytes = tex->getPixelsWide() * tex->getPixelsHigh() * bpp / 8;
-        totalBytes += bytes;
+        // counts the mipmaps, and the compressed size of the compressed textures
+        auto bytes = tex->getMemoryBytes();
         count++;
         snprintf(buftmp,sizeof(buftmp)-1,"\"%s\" rc=%lu id=%lu %lu x %lu @ %ld bpp => %lu KB\n",
                it->first.c_str(),
@@ -529,7 +683,22 @@ std::string TextureCache::getCachedTextureInfo() const
         buffer += buftmp;
     }
 
-    snprintf(buftmp, sizeof(buftmp)-1, "TextureCache dumpDebugInfo: %ld textures, for %lu KB (%.2f MB)\n", (long)count, (long)totalBytes / 1024, totalBytes / (1024.0f*1024.0f));
+    for (auto& entry : _bytesPerPixelFormat)
+    {
+        if (entry.second > 0)
+        {
+            snprintf(buftmp, sizeof(buftmp)-1, "%s => %lu KB\n", Texture2D::getStringForFormat(entry.first), (unsigned long)entry.second / 1024);
+            buffer += buftmp;
+        }
+    }
+
+    snprintf(buftmp, sizeof(buftmp)-1, "TextureCache dumpDebugInfo: %ld textures, for %lu KB (%.2f MB), budget %lu KB, %ld evicted, %ld reloaded\n",
+             (long)count,
+             (unsigned long)_totalBytes / 1024,
+             _totalBytes / (1024.0f*1024.0f),
+             (unsigned long)_memoryBudget / 1024,
+             (long)_evictedTextures,
+             (long)_reloadedTextures);
     buffer += buftmp;
 
     return buffer;
@@ -35,6 +35,8 @@ THE SOFTWARE.
 #include <queue>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
 #include <functional>
 
 #include "CCRef.h"
@@ -173,6 +175,34 @@ public:
     */
     std::string getCachedTextureInfo() const;
 
+    /** Sets the number of bytes of GPU memory that the cached textures may use. 0, the default, means no limit.
+    * When the cache is over the budget at the end of a frame, the least recently requested textures
+    * that were loaded from a file and are only referenced by the cache are removed. The textures requested
+    * during the frame are kept, so the texture returned by addImage() stays valid until the end of the frame
+    * even if it is not retained. addImage() loads the removed textures again the next time they are requested.
+    * The memory in use can be higher than the budget when the other textures are in use.
+    *
+    * @since v3.0
+    */
+    void setMemoryBudget(size_t bytes);
+    /** Returns the number of bytes of GPU memory that the cached textures may use */
+    size_t getMemoryBudget() const { return _memoryBudget; }
+
+    /** Removes the least recently requested textures until the cache fits in the budget.
+    * Called by the Director at the end of every frame.
+    */
+    void trimToMemoryBudget();
+
+    /** Returns the number of bytes of GPU memory used by the cached textures, counting their mipmaps */
+    size_t getTotalBytes() const { return _totalBytes; }
+    /** Returns the number of bytes of GPU memory used by the cached textures of a pixel format */
+    size_t getBytesForPixelFormat(Texture2D::PixelFormat format) const;
+
+    /** Returns the number of textures that were removed to stay in the memory budget */
+    unsigned int getEvictedTextures() const { return _evictedTextures; }
+    /** Returns the number of evicted textures that were loaded again */
+    unsigned int getReloadedTextures() const { return _reloadedTextures; }
+
     //wait for texture cahe to quit befor destroy instance
     //called by director, please do not called outside
     void waitForQuit();
@@ -181,6 +211,13 @@ private:
     void addImageAsyncCallBack(float dt);
     void loadImage();
 
+    /** accounts for a texture that was added to _textures */
+    void addTextureInfo(const std::string& key, Texture2D* texture, bool fromFile);
+    /** forgets a texture that is removed from _textures */
+    void removeTextureInfo(const std::string& key);
+    /** marks a texture as the most recently requested one, and updates its size if it changed */
+    void touchTexture(const std::string& key, Texture2D* texture);
+
 public:
     struct AsyncStruct
     {
@@ -214,6 +251,27 @@ protected:
     int _asyncRefCount;
 
     std::unordered_map<std::string, Texture2D*> _textures;
+
+    struct TextureInfo
+    {
+        // value of _useCounter when the texture was last requested
+        unsigned int lastUse;
+        // value of Director::getTotalFrames() when the texture was last requested
+        unsigned int lastUseFrame;
+        // size accounted in _totalBytes
+        size_t bytes;
+        Texture2D::PixelFormat pixelFormat;
+        // only the textures loaded from a file can be evicted, they can be loaded again
+        bool fromFile;
+    };
+    std::unordered_map<std::string, TextureInfo> _texturesInfo;
+    std::map<Texture2D::PixelFormat, size_t> _bytesPerPixelFormat;
+    size_t _totalBytes;
+    size_t _memoryBudget;
+    unsigned int _useCounter;
+    unsigned int _evictedTextures;
+    unsigned int _reloadedTextures;
+    std::unordered_set<std::string> _evictedKeys;
 };
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #define __CC_TOUCH_H__
 
 #include "CCRef.h"
+#include "CCSlabAllocator.h"
 #include "CCGeometry.h"
 
 NS_CC_BEGIN
@@ -38,6 +39,7 @@ NS_CC_BEGIN
 
 class CC_DLL Touch : public Ref
 {
+    CC_SLAB_ALLOCATED
 public:
     /** how the touches are dispathced */
     enum class DispatchMode {
@@ -262,6 +262,111 @@ To enable set it to a value different than 0. Disabled by default.
 #define CC_ENABLE_PROFILERS 0
 #endif
 
+/** @def CC_PROFILER_TRACE_BUFFER_SIZE
+ Number of zone events kept per thread by the Profiler trace. When a thread records more than that
+ between two exports, its oldest events are overwritten. Must be a power of 2.
+
+ Only used when CC_ENABLE_PROFILERS is enabled. Default is 65536 (1 MB per recording thread). The buffer
+ of a thread is released with the events it holds when the thread exits, except on Windows where it is kept
+ until the process exits.
+ */
+#ifndef CC_PROFILER_TRACE_BUFFER_SIZE
+#define CC_PROFILER_TRACE_BUFFER_SIZE 65536
+#endif
+
+/** @def CC_TMX_CHUNKED_LAYER_THRESHOLD
+ Number of tiles from which a TMXLayer is rendered in chunks of CC_TMX_CHUNK_SIZE x CC_TMX_CHUNK_SIZE tiles.
+ Only the chunks around the screen are then turned into quads, which keeps the memory and the loading
+ time of very large maps low. A layer can also ask for it with the "cc_chunk_size" property.
+
+ To enable set it to a value greater than 0. Disabled by default.
+ */
+#ifndef CC_TMX_CHUNKED_LAYER_THRESHOLD
+#define CC_TMX_CHUNKED_LAYER_THRESHOLD 0
+#endif
+
+/** @def CC_TMX_CHUNK_SIZE
+ Number of tiles on each side of a chunk of a chunked TMXLayer. Default is 32.
+ */
+#ifndef CC_TMX_CHUNK_SIZE
+#define CC_TMX_CHUNK_SIZE 32
+#endif
+
+/** @def CC_USE_SLAB_ALLOCATOR
+ If enabled, the hot short-lived objects (Sprite, Action, Touch, EventCustom and Timer) are allocated from
+ the SlabAllocator instead of the global heap. Spawning and destroying lots of them then reuses the
+ same memory blocks instead of calling malloc and free.
+
+ Every allocation takes the lock of the allocator, so it can be slower than the system heap when many
+ threads allocate at the same time.
+
+ To enable set it to 1. Disabled by default.
+ */
+#ifndef CC_USE_SLAB_ALLOCATOR
+#define CC_USE_SLAB_ALLOCATOR 0
+#endif
+
+/** @def CC_ENABLE_ATOMIC_REF_COUNT
+ If enabled, Ref::retain() and Ref::release() update the reference count atomically, so the same
+ object can be retained and released from several threads at the same time.
+
+ Objects that are created on a worker thread and then handed over to the main thread don't need it,
+ as long as the worker thread stops touching them once they are handed over: the references it still
+ holds must be released on the main thread, and it must not drain an AutoreleasePool holding them.
+
+ To enable set it to a value different than 0. Disabled by default.
+ */
+#ifndef CC_ENABLE_ATOMIC_REF_COUNT
+#define CC_ENABLE_ATOMIC_REF_COUNT 0
+#endif
+
+/** @def CC_USE_BINARY_VALUE_CACHE
+ If enabled, the plist files and the tiles of the TMX layers are loaded from their baked binary version
+ when there is an up to date one, and cached in the writable path the first time they are parsed.
+ See BinaryValueCache.
+
+ To enable set it to a value different than 0. Disabled by default.
+ It can also be changed at runtime with BinaryValueCache::setEnabled().
+ */
+#ifndef CC_USE_BINARY_VALUE_CACHE
+#define CC_USE_BINARY_VALUE_CACHE 0
+#endif
+
+/** @def CC_RENDER_TEXTURE_READBACK_FRAMES
+ Number of frames RenderTexture::saveToFileAsync() waits before mapping the pixel buffer object
+ its pixels were read into. Mapping it earlier stalls until the GPU has rendered them.
+
+ 2 by default.
+ */
+#ifndef CC_RENDER_TEXTURE_READBACK_FRAMES
+#define CC_RENDER_TEXTURE_READBACK_FRAMES 2
+#endif
+
+/** @def CC_ENABLE_GPU_GRID_EFFECTS
+ If enabled, Waves3D, Ripple3D, Liquid, Waves and Twirl move the vertices of the grid in the vertex shader
+ instead of rewriting all of them on the CPU every frame. The vertices are still set on the CPU
+ by the last update of the action, or when it is stopped.
+
+ Enabled by default. To disable set it to 0.
+ */
+#ifndef CC_ENABLE_GPU_GRID_EFFECTS
+#define CC_ENABLE_GPU_GRID_EFFECTS 1
+#endif
+
+/** @def CC_ENABLE_PARALLEL_POSE_EVALUATION
+ If enabled, the spine and cocostudio skeletal animations queue their pose in update() and the PoseBatch
+ evaluates all of them on the JobPool at the end of the update phase, before the scene is visited.
+ Their events are still fired on the main thread.
+ Until then the bones hold the pose of the previous update: code reading the bones or their world transforms
+ right after update() sees a stale pose, unless it calls PoseBatch::flush() first.
+
+ Disabled by default. To enable set it to 1.
+ It can also be changed at runtime with PoseBatch::setEnabled().
+ */
+#ifndef CC_ENABLE_PARALLEL_POSE_EVALUATION
+#define CC_ENABLE_PARALLEL_POSE_EVALUATION 0
+#endif
+
 /** Enable Lua engine debug log */
 #ifndef CC_LUA_ENGINE_DEBUG
 #define CC_LUA_ENGINE_DEBUG 0
@@ -215,6 +215,11 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 #define CC_PROFILER_STOP_INSTANCE(__id__, __name__) do{ ProfilingEndTimingBlock(    String::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
 #define CC_PROFILER_RESET_INSTANCE(__id__, __name__) do{ ProfilingResetTimingBlock( String::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
 
+#define CC_PROFILER_CONCAT_(__a__, __b__) __a__##__b__
+#define CC_PROFILER_CONCAT(__a__, __b__) CC_PROFILER_CONCAT_(__a__, __b__)
+#define CC_PROFILER_ZONE(__name__) \
+    static const unsigned int CC_PROFILER_CONCAT(__ccProfilerZoneId, __LINE__) = cocos2d::Profiler::registerZone(__name__); \
+    cocos2d::ProfilingZone CC_PROFILER_CONCAT(__ccProfilerZone, __LINE__)(CC_PROFILER_CONCAT(__ccProfilerZoneId, __LINE__))
 
 #else
 
@@ -233,6 +238,8 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 #define CC_PROFILER_STOP_INSTANCE(__id__, __name__) do {} while(0)
 #define CC_PROFILER_RESET_INSTANCE(__id__, __name__) do {} while(0)
 
+#define CC_PROFILER_ZONE(__name__) do {} while(0)
+
 #endif
 
 #if !defined(COCOS2D_DEBUG) || COCOS2D_DEBUG == 0
@@ -259,6 +266,11 @@ It should work same as apples CFSwapInt32LittleToHost(..)
         __renderer__->addDrawnVertices(__vertices__);                   \
     } while(0)
 
+/** @def CC_INCREMENT_GL_UPLOADED_BYTES
+ Increments the number of bytes uploaded to the vertex buffers in the current frame.
+ */
+#define CC_INCREMENT_GL_UPLOADED_BYTES(__bytes__) Director::getInstance()->getRenderer()->addUploadedBytes(__bytes__)
+
 /*******************/
 /** Notifications **/
 /*******************/
@@ -0,0 +1,92 @@
+/*
+ * cocos2d for iPhone: http://www.cocos2d-iphone.org
+ *
+ * Copyright (c) 2011 Ricardo Quesada
+ * Copyright (c) 2012 Zynga Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+"																		\n\
+attribute vec4 a_position;												\n\
+attribute vec2 a_texCoord;												\n\
+attribute vec2 a_gridCoord;												\n\
+																		\n\
+// x: effect, y: phase, z: amplitude									\n\
+uniform vec4 CC_GridEffect;												\n\
+// depends on the effect												\n\
+uniform vec4 CC_GridEffectParams;										\n\
+// number of tiles of the grid											\n\
+uniform vec2 CC_GridSize;												\n\
+																		\n\
+#ifdef GL_ES															\n\
+varying mediump vec2 v_texCoord;										\n\
+#else																	\n\
+varying vec2 v_texCoord;												\n\
+#endif																	\n\
+																		\n\
+void main()																\n\
+{																		\n\
+    vec4 position = a_position;											\n\
+    float phase = CC_GridEffect.y;										\n\
+    float amplitude = CC_GridEffect.z;									\n\
+																		\n\
+    if (CC_GridEffect.x == 1.0)											\n\
+    {																	\n\
+        // Waves3D														\n\
+        position.z += sin(phase + (position.x + position.y) * 0.01) * amplitude;	\n\
+    }																	\n\
+    else if (CC_GridEffect.x == 2.0)									\n\
+    {																	\n\
+        // Ripple3D: center and radius									\n\
+        float radius = CC_GridEffectParams.z;							\n\
+        float r = distance(CC_GridEffectParams.xy, position.xy);		\n\
+        if (r < radius)													\n\
+        {																\n\
+            r = radius - r;												\n\
+            float rate = (r / radius) * (r / radius);					\n\
+            position.z += sin(phase + r * 0.1) * amplitude * rate;		\n\
+        }																\n\
+    }																	\n\
+    else if (CC_GridEffect.x == 3.0)									\n\
+    {																	\n\
+        // Liquid, the border of the grid doesn't move					\n\
+        if (a_gridCoord.x > 0.5 && a_gridCoord.x < CC_GridSize.x - 0.5	\n\
+            && a_gridCoord.y > 0.5 && a_gridCoord.y < CC_GridSize.y - 0.5)	\n\
+        {																\n\
+            position.xy += sin(vec2(phase) + position.xy * 0.01) * amplitude;	\n\
+        }																\n\
+    }																	\n\
+    else if (CC_GridEffect.x == 4.0)									\n\
+    {																	\n\
+        // Waves: 1 or 0 to move vertically, horizontally				\n\
+        position.x += sin(phase + position.y * 0.01) * amplitude * CC_GridEffectParams.x;	\n\
+        position.y += sin(phase + position.x * 0.01) * amplitude * CC_GridEffectParams.y;	\n\
+    }																	\n\
+    else if (CC_GridEffect.x == 5.0)									\n\
+    {																	\n\
+        // Twirl: center												\n\
+        float a = length(a_gridCoord - CC_GridSize * 0.5) * cos(1.5707963 + phase) * amplitude;	\n\
+        vec2 d = position.xy - CC_GridEffectParams.xy;					\n\
+        position.xy = CC_GridEffectParams.xy + vec2(sin(a) * d.y + cos(a) * d.x, cos(a) * d.y - sin(a) * d.x);	\n\
+    }																	\n\
+																		\n\
+    gl_Position = CC_MVPMatrix * position;								\n\
+	v_texCoord = a_texCoord;											\n\
+}																		\n\
+";
@@ -44,6 +44,8 @@ const GLchar * ccPositionTexture_frag =
 #include "ccShader_PositionTexture_frag.h"
 const GLchar * ccPositionTexture_vert =
 #include "ccShader_PositionTexture_vert.h"
+const GLchar * ccPositionTextureGrid_vert =
+#include "ccShader_PositionTextureGrid_vert.h"
 
 //
 const GLchar * ccPositionTextureA8Color_frag =
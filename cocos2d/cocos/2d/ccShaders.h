@@ -44,6 +44,7 @@ extern CC_DLL const GLchar * ccPositionColor_vert;
 
 extern CC_DLL const GLchar * ccPositionTexture_frag;
 extern CC_DLL const GLchar * ccPositionTexture_vert;
+extern CC_DLL const GLchar * ccPositionTextureGrid_vert;
 
 extern CC_DLL const GLchar * ccPositionTextureA8Color_frag;
 extern CC_DLL const GLchar * ccPositionTextureA8Color_vert;
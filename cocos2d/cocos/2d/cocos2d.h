@@ -64,9 +64,11 @@ THE SOFTWARE.
 #include "CCMap.h"
 #include "CCGeometry.h"
 #include "CCAutoreleasePool.h"
+#include "CCJobPool.h"
 #include "CCNS.h"
 #include "CCData.h"
 #include "CCValue.h"
+#include "CCValueFlatMap.h"
 
 // draw nodes
 #include "CCDrawingPrimitives.h"
@@ -263,6 +265,7 @@ THE SOFTWARE.
 #include "CCConfiguration.h"
 #include "CCDirector.h"
 #include "CCScheduler.h"
+#include "CCPoseBatch.h"
 
 // component
 #include "CCComponent.h"
@@ -0,0 +1,685 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "platform/CCBinaryValueCache.h"
+#include "platform/CCFileUtils.h"
+#include "CCTMXObjectGroup.h"
+#include "CCTMXXMLParser.h"
+#include "xxhash.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+NS_CC_BEGIN
+
+namespace
+{
+    const char BINARY_VALUE_MAGIC[4] = { 'C', 'C', 'V', 'B' };
+    const uint32_t BINARY_VALUE_BYTE_ORDER = 0x01020304;
+    const uint16_t BINARY_VALUE_VERSION = 1;
+
+    const unsigned char ENTRY_KIND_MAP = 'M';
+    const unsigned char ENTRY_KIND_VECTOR = 'V';
+    const unsigned char ENTRY_KIND_TILES = 'T';
+
+    // written in the host byte order, baked files are rejected by hosts of the other order
+    struct EntryHeader
+    {
+        char magic[4];
+        uint32_t byteOrder;
+        uint64_t sourceSize;
+        int64_t sourceTime;     // 0 when the modification time of the source is unknown
+        uint64_t payloadSize;
+        uint32_t sourceHash;
+        uint16_t version;
+        unsigned char kind;
+        unsigned char reserved;
+    };
+
+    static_assert(sizeof(EntryHeader) == 40, "EntryHeader must not be padded");
+
+    std::string getLayerKey(int layerIndex)
+    {
+        char key[16];
+        sprintf(key, "%d", layerIndex);
+        return key;
+    }
+
+    bool getSourceStat(const std::string& fullPath, uint64_t* size, int64_t* time)
+    {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8)
+        CC_UNUSED_PARAM(fullPath);
+        CC_UNUSED_PARAM(size);
+        CC_UNUSED_PARAM(time);
+        return false;
+#else
+        struct stat st;
+        if (stat(fullPath.c_str(), &st) != 0)
+        {
+            return false;
+        }
+        *size = static_cast<uint64_t>(st.st_size);
+        *time = static_cast<int64_t>(st.st_mtime);
+        return true;
+#endif
+    }
+
+    // shipped entries are baked from the sources packaged with them: a source of the baked size is trusted
+    // without being read, sourceHash identifies the baked content. Runtime entries also need the modification time.
+    bool isUpToDate(const EntryHeader& header, const std::string& fullPath, bool shipped)
+    {
+        uint64_t size = 0;
+        int64_t time = 0;
+        if (getSourceStat(fullPath, &size, &time))
+        {
+            if (size != header.sourceSize)
+            {
+                return false;
+            }
+            if (shipped || (header.sourceTime != 0 && time == header.sourceTime))
+            {
+                return true;
+            }
+        }
+        else if (shipped)
+        {
+            // packaged resources (e.g. inside the apk) can't be stat'ed, they only change with the entry next to them
+            return true;
+        }
+
+        // the modification time of the source is unknown or changed: compare the content
+        Data source = FileUtils::getInstance()->getDataFromFile(fullPath);
+        return ! source.isNull()
+            && static_cast<uint64_t>(source.getSize()) == header.sourceSize
+            && XXH32(source.getBytes(), static_cast<int>(source.getSize()), 0) == header.sourceHash;
+    }
+
+    class BinaryWriter
+    {
+    public:
+        template <typename T>
+        void write(T value)
+        {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+            _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void writeString(const std::string& str)
+        {
+            write(static_cast<uint32_t>(str.size()));
+            _buffer.insert(_buffer.end(), str.begin(), str.end());
+        }
+
+        // ValueMap and ValueFlatMap are written the same way
+        template <class T>
+        void writeMap(const T& dict)
+        {
+            write(static_cast<unsigned char>(Value::Type::MAP));
+            write(static_cast<uint32_t>(dict.size()));
+            for (const auto& iter : dict)
+            {
+                writeString(iter.first);
+                writeValue(iter.second);
+            }
+        }
+
+        void writeVector(const ValueVector& array)
+        {
+            write(static_cast<unsigned char>(Value::Type::VECTOR));
+            write(static_cast<uint32_t>(array.size()));
+            for (const auto& value : array)
+            {
+                writeValue(value);
+            }
+        }
+
+        void writeValue(const Value& value)
+        {
+            switch (value.getType())
+            {
+                case Value::Type::BYTE:
+                    write(static_cast<unsigned char>(Value::Type::BYTE));
+                    write(value.asByte());
+                    break;
+                case Value::Type::INTEGER:
+                    write(static_cast<unsigned char>(Value::Type::INTEGER));
+                    write(static_cast<int32_t>(value.asInt()));
+                    break;
+                case Value::Type::FLOAT:
+                    write(static_cast<unsigned char>(Value::Type::FLOAT));
+                    write(value.asFloat());
+                    break;
+                case Value::Type::DOUBLE:
+                    write(static_cast<unsigned char>(Value::Type::DOUBLE));
+                    write(value.asDouble());
+                    break;
+                case Value::Type::BOOLEAN:
+                    write(static_cast<unsigned char>(Value::Type::BOOLEAN));
+                    write(static_cast<unsigned char>(value.asBool() ? 1 : 0));
+                    break;
+                case Value::Type::STRING:
+                    write(static_cast<unsigned char>(Value::Type::STRING));
+                    writeString(value.asString());
+                    break;
+                case Value::Type::VECTOR:
+                    writeVector(value.asValueVector());
+                    break;
+                case Value::Type::MAP:
+                    writeMap(value.asValueMap());
+                    break;
+                case Value::Type::FLAT_MAP:
+                    writeMap(value.asValueFlatMap());
+                    break;
+                case Value::Type::INT_KEY_MAP:
+                    write(static_cast<unsigned char>(Value::Type::INT_KEY_MAP));
+                    write(static_cast<uint32_t>(value.asIntKeyMap().size()));
+                    for (const auto& iter : value.asIntKeyMap())
+                    {
+                        write(static_cast<int32_t>(iter.first));
+                        writeValue(iter.second);
+                    }
+                    break;
+                default:
+                    write(static_cast<unsigned char>(Value::Type::NONE));
+                    break;
+            }
+        }
+
+        Data getData() const
+        {
+            Data ret;
+            ret.copy(const_cast<unsigned char*>(_buffer.data()), static_cast<ssize_t>(_buffer.size()));
+            return ret;
+        }
+
+    private:
+        std::vector<unsigned char> _buffer;
+    };
+
+    class BinaryReader
+    {
+    public:
+        // flatMaps: decode the dictionaries as ValueFlatMap instead of ValueMap
+        BinaryReader(const unsigned char* bytes, ssize_t size, bool flatMaps = false)
+        : _current(bytes)
+        , _end(bytes + size)
+        , _failed(false)
+        , _flatMaps(flatMaps)
+        {}
+
+        bool hasFailed() const { return _failed; }
+        bool isAtEnd() const { return _current == _end; }
+
+        template <typename T>
+        T read()
+        {
+            T value = T();
+            if (_failed || static_cast<size_t>(_end - _current) < sizeof(T))
+            {
+                _failed = true;
+                return value;
+            }
+            memcpy(&value, _current, sizeof(T));
+            _current += sizeof(T);
+            return value;
+        }
+
+        // every element takes at least one byte: a larger count can only come from a corrupted file
+        uint32_t readCount()
+        {
+            uint32_t count = read<uint32_t>();
+            if (count > static_cast<size_t>(_end - _current))
+            {
+                _failed = true;
+                return 0;
+            }
+            return count;
+        }
+
+        std::string readString()
+        {
+            uint32_t length = readCount();
+            if (_failed)
+            {
+                return "";
+            }
+            std::string ret(reinterpret_cast<const char*>(_current), length);
+            _current += length;
+            return ret;
+        }
+
+        ValueMap readMapBody()
+        {
+            uint32_t count = readCount();
+            ValueMap dict;
+            dict.reserve(count);
+            for (uint32_t i = 0; i < count && ! _failed; ++i)
+            {
+                std::string key = readString();
+                dict.insert(std::make_pair(std::move(key), readValue()));
+            }
+            return dict;
+        }
+
+        ValueFlatMap readFlatMapBody()
+        {
+            uint32_t count = readCount();
+            ValueFlatMap dict;
+            dict.reserve(count);
+            for (uint32_t i = 0; i < count && ! _failed; ++i)
+            {
+                std::string key = readString();
+                dict.insert(std::make_pair(std::move(key), readValue()));
+            }
+            return dict;
+        }
+
+        ValueVector readVectorBody()
+        {
+            uint32_t count = readCount();
+            ValueVector array;
+            array.reserve(count);
+            for (uint32_t i = 0; i < count && ! _failed; ++i)
+            {
+                array.push_back(readValue());
+            }
+            return array;
+        }
+
+        Value readValue()
+        {
+            switch (static_cast<Value::Type>(read<unsigned char>()))
+            {
+                case Value::Type::NONE:
+                    return Value();
+                case Value::Type::BYTE:
+                    return Value(read<unsigned char>());
+                case Value::Type::INTEGER:
+                    return Value(static_cast<int>(read<int32_t>()));
+                case Value::Type::FLOAT:
+                    return Value(read<float>());
+                case Value::Type::DOUBLE:
+                    return Value(read<double>());
+                case Value::Type::BOOLEAN:
+                    return Value(read<unsigned char>() != 0);
+                case Value::Type::STRING:
+                    return Value(readString());
+                case Value::Type::VECTOR:
+                    return Value(readVectorBody());
+                case Value::Type::MAP:
+                    return _flatMaps ? Value(readFlatMapBody()) : Value(readMapBody());
+                case Value::Type::INT_KEY_MAP:
+                {
+                    uint32_t count = readCount();
+                    ValueMapIntKey dict;
+                    dict.reserve(count);
+                    for (uint32_t i = 0; i < count && ! _failed; ++i)
+                    {
+                        int key = static_cast<int>(read<int32_t>());
+                        dict.insert(std::make_pair(key, readValue()));
+                    }
+                    return Value(std::move(dict));
+                }
+                default:
+                    _failed = true;
+                    return Value();
+            }
+        }
+
+    private:
+        const unsigned char* _current;
+        const unsigned char* _end;
+        bool _failed;
+        bool _flatMaps;
+    };
+}
+
+BinaryValueCache* BinaryValueCache::s_sharedBinaryValueCache = nullptr;
+
+BinaryValueCache* BinaryValueCache::getInstance()
+{
+    if (! s_sharedBinaryValueCache)
+    {
+        s_sharedBinaryValueCache = new BinaryValueCache();
+    }
+    return s_sharedBinaryValueCache;
+}
+
+void BinaryValueCache::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedBinaryValueCache);
+}
+
+BinaryValueCache::BinaryValueCache()
+: _enabled(CC_USE_BINARY_VALUE_CACHE != 0)
+, _baking(false)
+{
+    setCacheDirectory(FileUtils::getInstance()->getWritablePath());
+}
+
+Data BinaryValueCache::encode(const ValueMap& dict)
+{
+    BinaryWriter writer;
+    writer.writeMap(dict);
+    return writer.getData();
+}
+
+Data BinaryValueCache::encode(const ValueFlatMap& dict)
+{
+    BinaryWriter writer;
+    writer.writeMap(dict);
+    return writer.getData();
+}
+
+Data BinaryValueCache::encode(const ValueVector& array)
+{
+    BinaryWriter writer;
+    writer.writeVector(array);
+    return writer.getData();
+}
+
+bool BinaryValueCache::decode(const unsigned char* bytes, ssize_t size, ValueMap& dict)
+{
+    BinaryReader reader(bytes, size);
+    if (static_cast<Value::Type>(reader.read<unsigned char>()) != Value::Type::MAP)
+    {
+        return false;
+    }
+
+    ValueMap ret = reader.readMapBody();
+    if (reader.hasFailed() || ! reader.isAtEnd())
+    {
+        return false;
+    }
+
+    dict = std::move(ret);
+    return true;
+}
+
+bool BinaryValueCache::decode(const unsigned char* bytes, ssize_t size, ValueFlatMap& dict)
+{
+    BinaryReader reader(bytes, size, true);
+    if (static_cast<Value::Type>(reader.read<unsigned char>()) != Value::Type::MAP)
+    {
+        return false;
+    }
+
+    ValueFlatMap ret = reader.readFlatMapBody();
+    if (reader.hasFailed() || ! reader.isAtEnd())
+    {
+        return false;
+    }
+
+    dict = std::move(ret);
+    return true;
+}
+
+bool BinaryValueCache::decode(const unsigned char* bytes, ssize_t size, ValueVector& array)
+{
+    BinaryReader reader(bytes, size);
+    if (static_cast<Value::Type>(reader.read<unsigned char>()) != Value::Type::VECTOR)
+    {
+        return false;
+    }
+
+    ValueVector ret = reader.readVectorBody();
+    if (reader.hasFailed() || ! reader.isAtEnd())
+    {
+        return false;
+    }
+
+    array = std::move(ret);
+    return true;
+}
+
+void BinaryValueCache::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+void BinaryValueCache::setCacheDirectory(const std::string& directory)
+{
+    _cacheDirectory = directory;
+    if (! _cacheDirectory.empty() && _cacheDirectory[_cacheDirectory.length() - 1] != '/')
+    {
+        _cacheDirectory += '/';
+    }
+}
+
+std::string BinaryValueCache::getEntryPath(const std::string& fullPath, const std::string& key, bool nextToSource) const
+{
+    if (nextToSource)
+    {
+        return key.empty() ? fullPath + ".ccvb" : fullPath + "." + key + ".ccvb";
+    }
+
+    // runtime entries are named after the hash of their source path
+    std::string identity = fullPath + "#" + key;
+    char name[64];
+    sprintf(name, "valuecache-%08x%08x.ccvb",
+            XXH32(identity.c_str(), static_cast<int>(identity.length()), 0),
+            XXH32(identity.c_str(), static_cast<int>(identity.length()), 1));
+    return _cacheDirectory + name;
+}
+
+bool BinaryValueCache::loadEntry(const std::string& fullPath, const std::string& key, unsigned char kind, Data& entry)
+{
+    if (_baking || fullPath.empty())
+    {
+        return false;
+    }
+
+    FileUtils* fileUtils = FileUtils::getInstance();
+
+    // shipped entries first, then the runtime ones
+    for (int i = 0; i < 2; ++i)
+    {
+        std::string path = getEntryPath(fullPath, key, i == 0);
+        if (! fileUtils->isFileExist(path))
+        {
+            continue;
+        }
+
+        Data data = fileUtils->getDataFromFile(path);
+        if (static_cast<size_t>(data.getSize()) < sizeof(EntryHeader))
+        {
+            continue;
+        }
+
+        EntryHeader header;
+        memcpy(&header, data.getBytes(), sizeof(header));
+        if (memcmp(header.magic, BINARY_VALUE_MAGIC, sizeof(header.magic)) != 0
+            || header.byteOrder != BINARY_VALUE_BYTE_ORDER
+            || header.version != BINARY_VALUE_VERSION
+            || header.kind != kind
+            || header.payloadSize != static_cast<uint64_t>(data.getSize()) - sizeof(EntryHeader))
+        {
+            CCLOG("cocos2d: BinaryValueCache: ignoring invalid entry %s", path.c_str());
+            continue;
+        }
+
+        if (! isUpToDate(header, fullPath, i == 0))
+        {
+            continue;
+        }
+
+        entry = std::move(data);
+        return true;
+    }
+
+    return false;
+}
+
+void BinaryValueCache::saveEntry(const std::string& fullPath, const std::string& key, unsigned char kind, const unsigned char* payload, ssize_t size)
+{
+    if (fullPath.empty())
+    {
+        return;
+    }
+
+    Data source = FileUtils::getInstance()->getDataFromFile(fullPath);
+    if (source.isNull())
+    {
+        return;
+    }
+
+    EntryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_VALUE_MAGIC, sizeof(header.magic));
+    header.byteOrder = BINARY_VALUE_BYTE_ORDER;
+    header.version = BINARY_VALUE_VERSION;
+    header.kind = kind;
+    header.payloadSize = static_cast<uint64_t>(size);
+    header.sourceSize = static_cast<uint64_t>(source.getSize());
+    header.sourceHash = XXH32(source.getBytes(), static_cast<int>(source.getSize()), 0);
+
+    uint64_t statSize = 0;
+    int64_t statTime = 0;
+    // shipped entries are always checked against the content, the modification time won't survive packaging
+    if (! _baking && getSourceStat(fullPath, &statSize, &statTime) && statSize == header.sourceSize)
+    {
+        header.sourceTime = statTime;
+    }
+
+    std::string path = getEntryPath(fullPath, key, _baking);
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (! fp)
+    {
+        CCLOG("cocos2d: BinaryValueCache: can not write %s", path.c_str());
+        return;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, fp) == 1
+        && (size == 0 || fwrite(payload, static_cast<size_t>(size), 1, fp) == 1);
+    fclose(fp);
+
+    if (! written)
+    {
+        // a truncated entry would be rejected anyway, don't leave it around
+        remove(path.c_str());
+    }
+}
+
+bool BinaryValueCache::loadValueMap(const std::string& fullPath, ValueMap& dict)
+{
+    Data entry;
+    return loadEntry(fullPath, "", ENTRY_KIND_MAP, entry)
+        && decode(entry.getBytes() + sizeof(EntryHeader), entry.getSize() - sizeof(EntryHeader), dict);
+}
+
+bool BinaryValueCache::loadValueFlatMap(const std::string& fullPath, ValueFlatMap& dict)
+{
+    Data entry;
+    return loadEntry(fullPath, "", ENTRY_KIND_MAP, entry)
+        && decode(entry.getBytes() + sizeof(EntryHeader), entry.getSize() - sizeof(EntryHeader), dict);
+}
+
+bool BinaryValueCache::loadValueVector(const std::string& fullPath, ValueVector& array)
+{
+    Data entry;
+    return loadEntry(fullPath, "", ENTRY_KIND_VECTOR, entry)
+        && decode(entry.getBytes() + sizeof(EntryHeader), entry.getSize() - sizeof(EntryHeader), array);
+}
+
+void BinaryValueCache::saveValueMap(const std::string& fullPath, const ValueMap& dict)
+{
+    Data payload = encode(dict);
+    saveEntry(fullPath, "", ENTRY_KIND_MAP, payload.getBytes(), payload.getSize());
+}
+
+void BinaryValueCache::saveValueFlatMap(const std::string& fullPath, const ValueFlatMap& dict)
+{
+    Data payload = encode(dict);
+    saveEntry(fullPath, "", ENTRY_KIND_MAP, payload.getBytes(), payload.getSize());
+}
+
+void BinaryValueCache::saveValueVector(const std::string& fullPath, const ValueVector& array)
+{
+    Data payload = encode(array);
+    saveEntry(fullPath, "", ENTRY_KIND_VECTOR, payload.getBytes(), payload.getSize());
+}
+
+uint32_t* BinaryValueCache::loadTiles(const std::string& tmxFullPath, int layerIndex, ssize_t tilesCount)
+{
+    Data entry;
+    if (! loadEntry(tmxFullPath, getLayerKey(layerIndex), ENTRY_KIND_TILES, entry)
+        || entry.getSize() - sizeof(EntryHeader) != tilesCount * sizeof(uint32_t))
+    {
+        return nullptr;
+    }
+
+    uint32_t* tiles = static_cast<uint32_t*>(malloc(tilesCount * sizeof(uint32_t)));
+    memcpy(tiles, entry.getBytes() + sizeof(EntryHeader), tilesCount * sizeof(uint32_t));
+    return tiles;
+}
+
+void BinaryValueCache::saveTiles(const std::string& tmxFullPath, int layerIndex, const uint32_t* tiles, ssize_t tilesCount)
+{
+    saveEntry(tmxFullPath, getLayerKey(layerIndex), ENTRY_KIND_TILES,
+              reinterpret_cast<const unsigned char*>(tiles), tilesCount * sizeof(uint32_t));
+}
+
+bool BinaryValueCache::bakeFile(const std::string& fullPath)
+{
+    FileUtils* fileUtils = FileUtils::getInstance();
+    if (! fileUtils->isFileExist(fullPath))
+    {
+        return false;
+    }
+
+    bool enabled = _enabled;
+    _enabled = true;
+    _baking = true;
+
+    bool ret = false;
+    std::string extension = fullPath.substr(fullPath.find_last_of('.') + 1);
+    if (extension == "tmx")
+    {
+        // the layers are saved by the parser
+        TMXMapInfo* mapInfo = TMXMapInfo::create(fullPath);
+        ret = mapInfo != nullptr;
+    }
+    else
+    {
+        ValueMap dict = fileUtils->getValueMapFromFile(fullPath);
+        if (! dict.empty())
+        {
+            ret = true;
+        }
+        else
+        {
+            ret = ! fileUtils->getValueVectorFromFile(fullPath).empty();
+        }
+    }
+
+    _baking = false;
+    _enabled = enabled;
+
+    return ret;
+}
+
+NS_CC_END
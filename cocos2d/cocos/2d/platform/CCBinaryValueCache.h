@@ -0,0 +1,128 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CC_BINARY_VALUE_CACHE_H__
+#define __CC_BINARY_VALUE_CACHE_H__
+
+#include "CCPlatformMacros.h"
+#include "CCValue.h"
+#include "CCValueFlatMap.h"
+#include "CCData.h"
+
+#include <stdint.h>
+#include <string>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/** @brief Keeps the content of plist files and the decoded tiles of TMX layers in a compact binary form.
+
+ Parsing the XML is the slow part of loading a plist or a TMX map. When the cache is enabled,
+ FileUtils::getValueMapFromFile(), FileUtils::getValueVectorFromFile() and TMXMapInfo first look for
+ a baked version of the file:
+ - "<file>.ccvb" (or "<file>.<layer index>.ccvb" for the layers of a TMX map) shipped next to it,
+   see bakeFile() and the cocos2d-valuebaker tool,
+ - or the entry written in the cache directory the first time the file was parsed.
+
+ A baked file remembers the size, the modification time and the hash of the file it comes from.
+ Entries written in the cache directory are ignored as soon as that file changes. Shipped entries are
+ only checked against the size of the file, so that loading them never reads the file itself: bake them
+ again whenever the files change.
+ */
+class CC_DLL BinaryValueCache
+{
+public:
+    /** returns the shared cache */
+    static BinaryValueCache* getInstance();
+
+    /** destroys the shared cache */
+    static void destroyInstance();
+
+    /** serializes a ValueMap, a ValueFlatMap or a ValueVector. Both kinds of maps are encoded the same way */
+    static Data encode(const ValueMap& dict);
+    static Data encode(const ValueFlatMap& dict);
+    static Data encode(const ValueVector& array);
+
+    /** deserializes a ValueMap, a ValueFlatMap or a ValueVector. Returns false if the bytes don't hold one.
+     The dictionaries nested in a ValueFlatMap are ValueFlatMap too.
+     */
+    static bool decode(const unsigned char* bytes, ssize_t size, ValueMap& dict);
+    static bool decode(const unsigned char* bytes, ssize_t size, ValueFlatMap& dict);
+    static bool decode(const unsigned char* bytes, ssize_t size, ValueVector& array);
+
+    /** Enables or disables the cache. Disabled by default, see CC_USE_BINARY_VALUE_CACHE */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    /** Directory where the files parsed at runtime are cached. It must exist. Default is the writable path */
+    void setCacheDirectory(const std::string& directory);
+    const std::string& getCacheDirectory() const { return _cacheDirectory; }
+
+    /** Loads the baked content of a plist file. Returns false if there is no up to date baked version */
+    bool loadValueMap(const std::string& fullPath, ValueMap& dict);
+    bool loadValueFlatMap(const std::string& fullPath, ValueFlatMap& dict);
+    bool loadValueVector(const std::string& fullPath, ValueVector& array);
+
+    /** Caches the parsed content of a plist file */
+    void saveValueMap(const std::string& fullPath, const ValueMap& dict);
+    void saveValueFlatMap(const std::string& fullPath, const ValueFlatMap& dict);
+    void saveValueVector(const std::string& fullPath, const ValueVector& array);
+
+    /** Loads the decoded tiles of a TMX layer, in a buffer allocated with malloc().
+     Returns nullptr if there is no up to date baked version */
+    uint32_t* loadTiles(const std::string& tmxFullPath, int layerIndex, ssize_t tilesCount);
+
+    /** Caches the decoded tiles of a TMX layer */
+    void saveTiles(const std::string& tmxFullPath, int layerIndex, const uint32_t* tiles, ssize_t tilesCount);
+
+    /** Parses a plist or a TMX file and writes its baked version next to it.
+     This is what the offline converter does, it works even if the cache is disabled.
+     */
+    bool bakeFile(const std::string& fullPath);
+
+protected:
+    BinaryValueCache();
+
+    bool loadEntry(const std::string& fullPath, const std::string& key, unsigned char kind, Data& entry);
+    void saveEntry(const std::string& fullPath, const std::string& key, unsigned char kind, const unsigned char* payload, ssize_t size);
+    std::string getEntryPath(const std::string& fullPath, const std::string& key, bool nextToSource) const;
+
+    static BinaryValueCache* s_sharedBinaryValueCache;
+
+    bool _enabled;
+    std::string _cacheDirectory;
+    //! true while baking: entries are written next to the sources, and never loaded
+    bool _baking;
+};
+
+// end of platform group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_BINARY_VALUE_CACHE_H__
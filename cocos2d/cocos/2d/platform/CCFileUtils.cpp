@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "ccMacros.h"
 #include "CCDirector.h"
 #include "CCSAXParser.h"
+#include "CCBinaryValueCache.h"
 #include "tinyxml2.h"
 #include "unzip.h"
 #include <stack>
@@ -56,21 +57,26 @@ typedef enum
     SAX_RESULT_ARRAY
 }SAXResult;
 
+// the dictionary held by a Value, for the kind of dictionary built by DictMaker
+static ValueMap* getDict(Value& value, ValueMap*) { return &value.asValueMap(); }
+static ValueFlatMap* getDict(Value& value, ValueFlatMap*) { return &value.asValueFlatMap(); }
+
+template <class DictType>
 class DictMaker : public SAXDelegator
 {
 public:
     SAXResult _resultType;
-	ValueMap _rootDict;
+	DictType _rootDict;
 	ValueVector _rootArray;
 
     std::string _curKey;   ///< parsed key
     std::string _curValue; // parsed value
     SAXState _state;
 
-	ValueMap*  _curDict;
+	DictType*  _curDict;
     ValueVector* _curArray;
 
-	std::stack<ValueMap*> _dictStack;
+	std::stack<DictType*> _dictStack;
     std::stack<ValueVector*> _arrayStack;
     std::stack<SAXState>  _stateStack;
 
@@ -84,7 +90,7 @@ public:
     {
     }
 
-    ValueMap dictionaryWithContentsOfFile(const std::string& fileName)
+    DictType dictionaryWithContentsOfFile(const std::string& fileName)
     {
         _resultType = SAX_RESULT_DICT;
         SAXParser parser;
@@ -131,16 +137,16 @@ public:
             if (SAX_ARRAY == preState)
             {
                 // add a new dictionary into the array
-                _curArray->push_back(Value(ValueMap()));
-				_curDict = &(_curArray->rbegin())->asValueMap();
+                _curArray->push_back(Value(DictType()));
+				_curDict = getDict(*_curArray->rbegin(), static_cast<DictType*>(nullptr));
             }
             else if (SAX_DICT == preState)
             {
                 // add a new dictionary into the pre dictionary
                 CCASSERT(! _dictStack.empty(), "The state is wrong!");
-                ValueMap* preDict = _dictStack.top();
-                (*preDict)[_curKey] = Value(ValueMap());
-				_curDict = &(*preDict)[_curKey].asValueMap();
+                DictType* preDict = _dictStack.top();
+                (*preDict)[_curKey] = Value(DictType());
+				_curDict = getDict((*preDict)[_curKey], static_cast<DictType*>(nullptr));
             }
 
             // record the dict state
@@ -308,15 +314,61 @@ public:
 ValueMap FileUtils::getValueMapFromFile(const std::string& filename)
 {
     const std::string fullPath = fullPathForFilename(filename.c_str());
-    DictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath.c_str());
+
+    BinaryValueCache* cache = BinaryValueCache::getInstance();
+    ValueMap ret;
+    if (cache->isEnabled() && cache->loadValueMap(fullPath, ret))
+    {
+        return ret;
+    }
+
+    DictMaker<ValueMap> tMaker;
+    ret = tMaker.dictionaryWithContentsOfFile(fullPath.c_str());
+    if (cache->isEnabled() && ! ret.empty())
+    {
+        cache->saveValueMap(fullPath, ret);
+    }
+    return ret;
+}
+
+ValueFlatMap FileUtils::getValueFlatMapFromFile(const std::string& filename)
+{
+    const std::string fullPath = fullPathForFilename(filename.c_str());
+
+    BinaryValueCache* cache = BinaryValueCache::getInstance();
+    ValueFlatMap ret;
+    if (cache->isEnabled() && cache->loadValueFlatMap(fullPath, ret))
+    {
+        return ret;
+    }
+
+    DictMaker<ValueFlatMap> tMaker;
+    ret = tMaker.dictionaryWithContentsOfFile(fullPath.c_str());
+    if (cache->isEnabled() && ! ret.empty())
+    {
+        cache->saveValueFlatMap(fullPath, ret);
+    }
+    return ret;
 }
 
 ValueVector FileUtils::getValueVectorFromFile(const std::string& filename)
 {
     const std::string fullPath = fullPathForFilename(filename.c_str());
-    DictMaker tMaker;
-    return tMaker.arrayWithContentsOfFile(fullPath.c_str());
+
+    BinaryValueCache* cache = BinaryValueCache::getInstance();
+    ValueVector ret;
+    if (cache->isEnabled() && cache->loadValueVector(fullPath, ret))
+    {
+        return ret;
+    }
+
+    DictMaker<ValueMap> tMaker;
+    ret = tMaker.arrayWithContentsOfFile(fullPath.c_str());
+    if (cache->isEnabled() && ! ret.empty())
+    {
+        cache->saveValueVector(fullPath, ret);
+    }
+    return ret;
 }
 
 
@@ -464,6 +516,7 @@ NS_CC_BEGIN
 /* The subclass FileUtilsApple should override these two method. */
 ValueMap FileUtils::getValueMapFromFile(const std::string& filename) {return ValueMap();}
 ValueVector FileUtils::getValueVectorFromFile(const std::string& filename) {return ValueVector();}
+ValueFlatMap FileUtils::getValueFlatMapFromFile(const std::string& filename) {return ValueFlatMap(getValueMapFromFile(filename));}
 bool FileUtils::writeToFile(ValueMap& dict, const std::string &fullPath) {return false;}
 
 #endif /* (CC_TARGET_PLATFORM != CC_PLATFORM_IOS) && (CC_TARGET_PLATFORM != CC_PLATFORM_MAC) */
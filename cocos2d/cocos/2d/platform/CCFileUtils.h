@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "CCPlatformMacros.h"
 #include "ccTypes.h"
 #include "CCValue.h"
+#include "CCValueFlatMap.h"
 #include "CCData.h"
 
 #include <string>
@@ -315,6 +316,13 @@ public:
      *  @note This method is used internally.
      */
     virtual ValueMap getValueMapFromFile(const std::string& filename);
+
+    /**
+     *  Converts the contents of a file to a ValueFlatMap, the nested dictionaries are ValueFlatMap too.
+     *  Cheaper to build and to look up than getValueMapFromFile() for the files read once at load time.
+     *  @note This method is used internally.
+     */
+    virtual ValueFlatMap getValueFlatMapFromFile(const std::string& filename);
     
     /**
      *  Write a ValueMap to a plist file.
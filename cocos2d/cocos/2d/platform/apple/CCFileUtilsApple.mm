@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "CCDirector.h"
 #include "CCSAXParser.h"
 #include "CCDictionary.h"
+#include "CCBinaryValueCache.h"
 #include "unzip.h"
 
 #include "CCFileUtilsApple.h"
@@ -399,11 +400,17 @@ std::string FileUtilsApple::getFullPathForDirectoryAndFilename(const std::string
 ValueMap FileUtilsApple::getValueMapFromFile(const std::string& filename)
 {
     std::string fullPath = fullPathForFilename(filename);
+
+    BinaryValueCache* cache = BinaryValueCache::getInstance();
+    ValueMap ret;
+    if (cache->isEnabled() && cache->loadValueMap(fullPath, ret))
+    {
+        return ret;
+    }
+
     NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
     NSDictionary* dict = [NSDictionary dictionaryWithContentsOfFile:path];
     
-    ValueMap ret;
-    
     if (dict != nil)
     {
         for (id key in [dict allKeys])
@@ -412,6 +419,11 @@ ValueMap FileUtilsApple::getValueMapFromFile(const std::string& filename)
             addValueToDict(key, value, ret);
         }
     }
+
+    if (cache->isEnabled() && ! ret.empty())
+    {
+        cache->saveValueMap(fullPath, ret);
+    }
     return ret;
 }
 
@@ -440,16 +452,26 @@ ValueVector FileUtilsApple::getValueVectorFromFile(const std::string& filename)
     //    pPath = [[NSBundle mainBundle] pathForResource:pPath ofType:pathExtension];
     //    fixing cannot read data using Array::createWithContentsOfFile
     std::string fullPath = fullPathForFilename(filename);
+
+    BinaryValueCache* cache = BinaryValueCache::getInstance();
+    ValueVector ret;
+    if (cache->isEnabled() && cache->loadValueVector(fullPath, ret))
+    {
+        return ret;
+    }
+
     NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
     NSArray* array = [NSArray arrayWithContentsOfFile:path];
     
-    ValueVector ret;
-    
     for (id value in array)
     {
         addItemToArray(value, ret);
     }
-    
+
+    if (cache->isEnabled() && ! ret.empty())
+    {
+        cache->saveValueVector(fullPath, ret);
+    }
     return ret;
 }
 
@@ -86,6 +86,13 @@ int Application::run()
         director->mainLoop();
         glview->pollEvents();
 
+        // headless frames don't track the wall clock, no need to wait for the next one.
+        // The window is still polled: see Director::setHeadless()
+        if (director->isHeadless())
+        {
+            continue;
+        }
+
         curTime = getCurrentMillSecond();
         if (curTime - lastTime < _animationInterval)
         {
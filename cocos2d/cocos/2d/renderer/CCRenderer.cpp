@@ -37,6 +37,7 @@
 #include "CCEventDispatcher.h"
 #include "CCEventListenerCustom.h"
 #include "CCEventType.h"
+#include "CCProfiling.h"
 
 #include "kazmath/kazmath.h"
 
@@ -111,6 +112,9 @@ Renderer::Renderer()
 :_lastMaterialID(0)
 ,_numQuads(0)
 ,_glViewAssigned(false)
+,_uploadedBytes(0)
+,_flushes(0)
+,_addedCommands(0)
 ,_isRendering(false)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 ,_cacheTextureListener(nullptr)
@@ -253,6 +257,7 @@ void Renderer::addCommand(RenderCommand* command, int renderQueue)
     CCASSERT(renderQueue >=0, "Invalid render queue");
     CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
     _renderGroups[renderQueue].push_back(command);
+    ++_addedCommands;
 }
 
 void Renderer::pushGroup(int renderQueueID)
@@ -329,6 +334,8 @@ void Renderer::visitRenderQueue(const RenderQueue& queue)
 
 void Renderer::render()
 {
+    CC_PROFILER_ZONE("Renderer - render");
+
     //Uncomment this once everything is rendered by new renderer
     //glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -339,6 +346,8 @@ void Renderer::render()
     {
         // cleanup
         _drawnBatches = _drawnVertices = 0;
+        _uploadedBytes = 0;
+        _flushes = 0;
 
         //Process render commands
         //1. Sort render commands based on ID
@@ -371,6 +380,7 @@ void Renderer::clean()
     _numQuads = 0;
 
     _lastMaterialID = 0;
+    _addedCommands = 0;
 }
 
 void Renderer::convertToWorldCoordinates(V3F_C4B_T2F_Quad* quads, ssize_t quantity, const kmMat4& modelView)
@@ -409,6 +419,8 @@ void Renderer::drawBatchedQuads()
         return;
     }
 
+    _uploadedBytes += sizeof(_quads[0]) * _numQuads;
+
     if (Configuration::getInstance()->supportsShareableVAO())
     {
         //Set VBO data
@@ -502,6 +514,10 @@ void Renderer::drawBatchedQuads()
 
 void Renderer::flush()
 {
+    if (_numQuads > 0)
+    {
+        _flushes++;
+    }
     drawBatchedQuads();
     _lastMaterialID = 0;
 }
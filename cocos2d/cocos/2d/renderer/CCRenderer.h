@@ -111,6 +111,16 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) QuadCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of bytes uploaded to vertex buffers in the last frame */
+    ssize_t getUploadedBytes() const { return _uploadedBytes; }
+    /* Code that uploads vertices with glBufferData / glBufferSubData should update this value */
+    void addUploadedBytes(ssize_t number) { _uploadedBytes += number; };
+    /* returns the number of times a batch of quads was cut by another command in the last frame */
+    ssize_t getFlushes() const { return _flushes; }
+
+    /* returns the number of commands added since the last frame was rendered.
+     Two equal values in the same frame mean that nothing was queued in between */
+    unsigned int getAddedCommands() const { return _addedCommands; }
 
     inline GroupCommandManager* getGroupCommandManager() const { return _groupCommandManager; };
 
@@ -155,6 +165,11 @@ protected:
     // stats
     ssize_t _drawnBatches;
     ssize_t _drawnVertices;
+    ssize_t _uploadedBytes;
+    ssize_t _flushes;
+
+    unsigned int _addedCommands;
+
     //the flag for checking whether renderer is rendering
     bool _isRendering;
     
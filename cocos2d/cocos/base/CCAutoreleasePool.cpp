@@ -124,6 +124,7 @@ void PoolManager::destroyInstance()
 }
 
 PoolManager::PoolManager()
+: _mainThreadId(std::this_thread::get_id())
 {
 }
 
@@ -143,11 +144,39 @@ PoolManager::~PoolManager()
 
 AutoreleasePool* PoolManager::getCurrentPool() const
 {
-    return _curReleasePool;
+    if (isMainThread())
+    {
+        return _curReleasePool;
+    }
+
+    std::lock_guard<std::mutex> lock(_threadPoolStacksMutex);
+    auto iter = _threadPoolStacks.find(std::this_thread::get_id());
+    if (iter == _threadPoolStacks.end() || iter->second.empty())
+    {
+        return nullptr;
+    }
+    return iter->second.back();
 }
 
 bool PoolManager::isObjectInPools(Ref* obj) const
 {
+    if (!isMainThread())
+    {
+        std::lock_guard<std::mutex> lock(_threadPoolStacksMutex);
+        auto iter = _threadPoolStacks.find(std::this_thread::get_id());
+        if (iter == _threadPoolStacks.end())
+        {
+            return false;
+        }
+
+        for (const auto& pool : iter->second)
+        {
+            if (pool->contains(obj))
+                return true;
+        }
+        return false;
+    }
+
     for (const auto& pool : _releasePoolStack)
     {
         if (pool->contains(obj))
@@ -158,12 +187,33 @@ bool PoolManager::isObjectInPools(Ref* obj) const
 
 void PoolManager::push(AutoreleasePool *pool)
 {
+    if (!isMainThread())
+    {
+        std::lock_guard<std::mutex> lock(_threadPoolStacksMutex);
+        _threadPoolStacks[std::this_thread::get_id()].push_back(pool);
+        return;
+    }
+
     _releasePoolStack.push_back(pool);
     _curReleasePool = pool;
 }
 
 void PoolManager::pop()
 {
+    if (!isMainThread())
+    {
+        std::lock_guard<std::mutex> lock(_threadPoolStacksMutex);
+        auto iter = _threadPoolStacks.find(std::this_thread::get_id());
+        CC_ASSERT(iter != _threadPoolStacks.end() && !iter->second.empty());
+
+        iter->second.pop_back();
+        if (iter->second.empty())
+        {
+            _threadPoolStacks.erase(iter);
+        }
+        return;
+    }
+
     // Can not pop the pool that created by engine
     CC_ASSERT(_releasePoolStack.size() >= 1);
     
@@ -28,6 +28,9 @@ THE SOFTWARE.
 #include <stack>
 #include <vector>
 #include <string>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include "CCRef.h"
 
 NS_CC_BEGIN
@@ -143,9 +146,13 @@ public:
     /**
      * Get current auto release pool, there is at least one auto release pool that created by engine.
      * You can create your own auto release pool at demand, which will be put into auto releae pool stack.
+     *
+     * Every thread has its own stack of pools. The engine only creates pools for the main thread,
+     * so on other threads it returns nullptr until an AutoreleasePool is created on the stack of that thread.
      */
     AutoreleasePool *getCurrentPool() const;
 
+    /** Checks whether the object is in one of the pools of the calling thread */
     bool isObjectInPools(Ref* obj) const;
 
     /**
@@ -160,11 +167,19 @@ private:
     
     void push(AutoreleasePool *pool);
     void pop();
+
+    bool isMainThread() const { return std::this_thread::get_id() == _mainThreadId; }
     
     static PoolManager* s_singleInstance;
     
     std::deque<AutoreleasePool*> _releasePoolStack;
     AutoreleasePool *_curReleasePool;
+
+    /// the thread that owns _releasePoolStack, the one which created the PoolManager
+    std::thread::id _mainThreadId;
+    /// pools created by the other threads, per thread
+    std::unordered_map<std::thread::id, std::vector<AutoreleasePool*>> _threadPoolStacks;
+    mutable std::mutex _threadPoolStacksMutex;
 };
 
 // end of base_nodes group
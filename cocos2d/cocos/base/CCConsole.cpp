@@ -58,6 +58,8 @@
 #include "platform/CCFileUtils.h"
 #include "CCConfiguration.h"
 #include "CCTextureCache.h"
+#include "CCSpriteFrameCache.h"
+#include "CCSlabAllocator.h"
 #include "CCGLView.h"
 #include "base64.h"
 NS_CC_BEGIN
@@ -264,6 +266,7 @@ Console::Console()
 {
     // VS2012 doesn't support initializer list, so we create a new array and assign its elements to '_command'.
 	Command commands[] = {     
+        { "allocator", "Purge or print the SlabAllocator counters. Args: [purge | ] ", std::bind(&Console::commandAllocator, this, std::placeholders::_1, std::placeholders::_2) },
         { "config", "Print the Configuration object", std::bind(&Console::commandConfig, this, std::placeholders::_1, std::placeholders::_2) },
         { "debugmsg", "Whether or not to forward the debug messages on the console. Args: [on | off]", [&](int fd, const std::string& args) {
             if( args.compare("on")==0 || args.compare("off")==0) {
@@ -570,6 +573,7 @@ void Console::commandTextures(int fd, const std::string& args)
     {
         sched->performFunctionInCocosThread( [=](){
             mydprintf(fd, "%s", Director::getInstance()->getTextureCache()->getCachedTextureInfo().c_str());
+            mydprintf(fd, "%s", SpriteFrameCache::getInstance()->getCachedSheetsInfo().c_str());
             sendPrompt(fd);
         }
                                             );
@@ -580,6 +584,22 @@ void Console::commandTextures(int fd, const std::string& args)
     }
 }
 
+void Console::commandAllocator(int fd, const std::string& args)
+{
+    if( args.compare("purge")== 0)
+    {
+        SlabAllocator::getInstance()->purge();
+    }
+    else if(args.length()==0)
+    {
+        mydprintf(fd, "%s", SlabAllocator::getInstance()->getDescription().c_str());
+    }
+    else
+    {
+        mydprintf(fd, "Unsupported argument: '%s'. Supported arguments: 'purge' or nothing", args.c_str());
+    }
+}
+
 
 void Console::commandDirector(int fd, const std::string& args)
 {
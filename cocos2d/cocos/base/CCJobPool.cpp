@@ -0,0 +1,192 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCJobPool.h"
+
+#include <algorithm>
+
+NS_CC_BEGIN
+
+static JobPool* s_sharedJobPool = nullptr;
+
+JobPool* JobPool::getInstance()
+{
+    if (! s_sharedJobPool)
+    {
+        s_sharedJobPool = new JobPool();
+    }
+    return s_sharedJobPool;
+}
+
+void JobPool::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedJobPool);
+}
+
+JobPool::JobPool()
+: _workerCount(0)
+, _generation(0)
+, _runningWorkers(0)
+, _quit(false)
+, _job(nullptr)
+, _count(0)
+, _grain(1)
+, _nextIndex(0)
+, _busy(false)
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    _workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+JobPool::~JobPool()
+{
+    stopWorkers();
+}
+
+void JobPool::setWorkerCount(unsigned int count)
+{
+    if (count == _workerCount)
+        return;
+
+    stopWorkers();
+    _workerCount = count;
+}
+
+void JobPool::startWorkers()
+{
+    _quit = false;
+    _generation = 0;
+    _workers.reserve(_workerCount);
+    for (unsigned int i = 0; i < _workerCount; ++i)
+    {
+        _workers.push_back(std::thread(&JobPool::workerLoop, this));
+    }
+}
+
+void JobPool::stopWorkers()
+{
+    if (_workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void JobPool::workerLoop()
+{
+    unsigned int generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeCondition.wait(lock, [&]() { return _quit || _generation != generation; });
+            if (_quit)
+                return;
+            generation = _generation;
+        }
+
+        runJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_runningWorkers == 0)
+            {
+                _doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void JobPool::runJobs()
+{
+    while (true)
+    {
+        ssize_t begin = _nextIndex.fetch_add(_grain);
+        if (begin >= _count)
+            break;
+
+        ssize_t end = std::min(begin + _grain, _count);
+        for (ssize_t i = begin; i < end; ++i)
+        {
+            (*_job)(i);
+        }
+    }
+}
+
+void JobPool::parallelFor(ssize_t count, const std::function<void(ssize_t)>& job, ssize_t grain)
+{
+    if (count <= 0)
+        return;
+
+    grain = std::max(grain, (ssize_t)1);
+
+    bool idle = false;
+    if (_workerCount == 0 || count <= grain || ! _busy.compare_exchange_strong(idle, true))
+    {
+        for (ssize_t i = 0; i < count; ++i)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    if (_workers.empty())
+    {
+        startWorkers();
+    }
+
+    _job = &job;
+    _count = count;
+    _grain = grain;
+    _nextIndex = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _runningWorkers = (unsigned int)_workers.size();
+        ++_generation;
+    }
+    _wakeCondition.notify_all();
+
+    runJobs();
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCondition.wait(lock, [this]() { return _runningWorkers == 0; });
+    }
+
+    _job = nullptr;
+    _busy = false;
+}
+
+NS_CC_END
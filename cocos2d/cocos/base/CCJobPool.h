@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCJOBPOOL_H__
+#define __CCJOBPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CCPlatformMacros.h"
+#include "CCStdC.h" // for ssize_t on window
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+/**
+ * Fixed set of worker threads running short, independent jobs for the main loop.
+ *
+ * parallelFor() hands the indexes of a batch to the workers and to the calling thread, and returns once
+ * all of them were processed, so the caller never sees a half finished batch. Jobs must not touch
+ * state shared with other jobs of the batch, nor call into the scene graph, the scheduler or the event dispatcher.
+ * The workers are started by the first batch that needs them.
+ */
+class CC_DLL JobPool
+{
+public:
+    /** returns the shared job pool */
+    static JobPool* getInstance();
+
+    /** stops the workers and destroys the shared job pool */
+    static void destroyInstance();
+
+    /** Calls job(index) for every index in [0, count) and returns when all of them are done.
+     Indexes are handed out in chunks of `grain`. When the pool has no worker, or when it is already
+     running a batch (e.g. parallelFor() is called from a job), every index is processed on the calling thread.
+     */
+    void parallelFor(ssize_t count, const std::function<void(ssize_t)>& job, ssize_t grain = 1);
+
+    /** Number of worker threads, not counting the thread calling parallelFor() */
+    unsigned int getWorkerCount() const { return _workerCount; }
+    /** Sets the number of worker threads. 0 runs every job on the calling thread.
+     Defaults to the number of hardware threads minus one. Must not be called from a job.
+     */
+    void setWorkerCount(unsigned int count);
+
+private:
+    JobPool();
+    ~JobPool();
+
+    void startWorkers();
+    void stopWorkers();
+    void workerLoop();
+    void runJobs();
+
+    std::vector<std::thread> _workers;
+    unsigned int _workerCount;
+
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _doneCondition;
+    unsigned int _generation;
+    unsigned int _runningWorkers;
+    bool _quit;
+
+    // current batch, written by parallelFor() before the workers are woken up
+    const std::function<void(ssize_t)>* _job;
+    ssize_t _count;
+    ssize_t _grain;
+    std::atomic<ssize_t> _nextIndex;
+    std::atomic<bool> _busy;
+
+    CC_DISALLOW_COPY_AND_ASSIGN(JobPool);
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCJOBPOOL_H__
@@ -28,18 +28,42 @@ THE SOFTWARE.
 #include "ccMacros.h"
 #include "CCScriptSupport.h"
 
+#if CC_ENABLE_SCRIPT_BINDING
+#include <atomic>
+#endif
+
 NS_CC_BEGIN
 
+#if CC_ENABLE_SCRIPT_BINDING
+// Refs may be created on loading threads
+static std::atomic<unsigned int> s_objectCount(0);
+#endif
+
 Ref::Ref()
 : _referenceCount(1) // when the Ref is created, the reference count of it is 1
 {
 #if CC_ENABLE_SCRIPT_BINDING
-    static unsigned int uObjectCount = 0;
     _luaID = 0;
-    _ID = ++uObjectCount;
+    _ID = ++s_objectCount;
 #endif
 }
 
+Ref::Ref(const Ref& other)
+: _referenceCount(1)
+{
+    CC_UNUSED_PARAM(other);
+#if CC_ENABLE_SCRIPT_BINDING
+    _luaID = 0;
+    _ID = ++s_objectCount;
+#endif
+}
+
+Ref& Ref::operator=(const Ref& other)
+{
+    CC_UNUSED_PARAM(other);
+    return *this;
+}
+
 Ref::~Ref()
 {
 #if CC_ENABLE_SCRIPT_BINDING
@@ -62,19 +86,29 @@ Ref::~Ref()
 void Ref::retain()
 {
     CCASSERT(_referenceCount > 0, "reference count should greater than 0");
+#if CC_ENABLE_ATOMIC_REF_COUNT
+    _referenceCount.fetch_add(1, std::memory_order_relaxed);
+#else
     ++_referenceCount;
+#endif
 }
 
 void Ref::release()
 {
     CCASSERT(_referenceCount > 0, "reference count should greater than 0");
-    --_referenceCount;
+#if CC_ENABLE_ATOMIC_REF_COUNT
+    // acquire-release: the thread deleting the Ref must see the writes done by the other owners
+    unsigned int count = _referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+#else
+    unsigned int count = --_referenceCount;
+#endif
     
-    if (_referenceCount == 0)
+    if (count == 0)
     {
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
         auto poolManager = PoolManager::getInstance();
-        if (!poolManager->getCurrentPool()->isClearing() && poolManager->isObjectInPools(this))
+        auto currentPool = poolManager->getCurrentPool();
+        if ((currentPool == nullptr || !currentPool->isClearing()) && poolManager->isObjectInPools(this))
         {
             // Trigger an assert if the reference count is 0 but the Ref is still in autorelease pool.
             // This happens when 'autorelease/release' were not used in pairs with 'new/retain'.
@@ -112,7 +146,12 @@ void Ref::release()
 
 Ref* Ref::autorelease()
 {
-    PoolManager::getInstance()->getCurrentPool()->addObject(this);
+    auto pool = PoolManager::getInstance()->getCurrentPool();
+    CCASSERT(pool != nullptr, "No autorelease pool on this thread, create an AutoreleasePool on its stack first");
+    if (pool)
+    {
+        pool->addObject(this);
+    }
     return this;
 }
 
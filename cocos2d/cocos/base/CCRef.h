@@ -29,6 +29,10 @@ THE SOFTWARE.
 #include "CCPlatformMacros.h"
 #include "ccConfig.h"
 
+#if CC_ENABLE_ATOMIC_REF_COUNT
+#include <atomic>
+#endif
+
 NS_CC_BEGIN
 
 /**
@@ -93,6 +97,9 @@ public:
      * This descrements the Ref's reference count at the end of current
      * autorelease pool block.
      *
+     * Each thread has its own autorelease pools. Threads other than the main
+     * thread must create an AutoreleasePool on their stack before calling it.
+     *
      * If the reference count reaches 0 after the descrement, this Ref is
      * destructed.
      *
@@ -120,6 +127,22 @@ protected:
      * @js NA
      */
     Ref();
+
+    /**
+     * Copy constructor
+     *
+     * The copy doesn't share the reference count of the original: its reference count is 1.
+     * @js NA
+     * @lua NA
+     */
+    Ref(const Ref& other);
+
+    /**
+     * Assignment keeps the reference count of the assigned Ref untouched.
+     * @js NA
+     * @lua NA
+     */
+    Ref& operator=(const Ref& other);
     
 public:
     /**
@@ -130,7 +153,11 @@ public:
     
 protected:
     /// count of references
+#if CC_ENABLE_ATOMIC_REF_COUNT
+    std::atomic<unsigned int> _referenceCount;
+#else
     unsigned int _referenceCount;
+#endif
     
     friend class AutoreleasePool;
     
@@ -0,0 +1,267 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCSlabAllocator.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include "ccMacros.h"
+
+NS_CC_BEGIN
+
+float SlabAllocator::Stats::getFragmentation() const
+{
+    if (reservedBytes == 0)
+        return 0.0f;
+
+    return 1.0f - static_cast<float>(usedBytes) / static_cast<float>(reservedBytes);
+}
+
+SlabAllocator* SlabAllocator::getInstance()
+{
+    // Never destroyed: objects may still be released while static objects are destructed
+    static SlabAllocator* s_sharedSlabAllocator = new SlabAllocator();
+    return s_sharedSlabAllocator;
+}
+
+SlabAllocator::SlabAllocator()
+{
+    for (auto& sizeClass : _sizeClasses)
+    {
+        sizeClass.freeList = nullptr;
+        sizeClass.liveBlocks = 0;
+        sizeClass.usedBytes = 0;
+    }
+    _stats = Stats();
+}
+
+size_t SlabAllocator::getBlocksPerPage(size_t index)
+{
+    return std::max(PAGE_SIZE / getBlockSize(index), static_cast<size_t>(8));
+}
+
+void SlabAllocator::addPage(size_t index)
+{
+    auto& sizeClass = _sizeClasses[index];
+    size_t blockSize = getBlockSize(index);
+    size_t blocks = getBlocksPerPage(index);
+
+    char* page = static_cast<char*>(::operator new(blockSize * blocks));
+    sizeClass.pages.push_back(page);
+
+    // thread the new blocks in front of the free list, lowest address first
+    for (size_t i = blocks; i > 0; --i)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(page + (i - 1) * blockSize);
+        block->next = sizeClass.freeList;
+        sizeClass.freeList = block;
+    }
+
+    _stats.pages++;
+    _stats.reservedBytes += blockSize * blocks;
+}
+
+void* SlabAllocator::allocate(size_t size)
+{
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.fallbackAllocations++;
+        return ::operator new(size);
+    }
+
+    size_t index = (size - 1) / GRANULARITY;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& sizeClass = _sizeClasses[index];
+    if (sizeClass.freeList == nullptr)
+    {
+        addPage(index);
+    }
+
+    FreeBlock* block = sizeClass.freeList;
+    sizeClass.freeList = block->next;
+    sizeClass.liveBlocks++;
+    sizeClass.usedBytes += size;
+
+    _stats.allocations++;
+    _stats.liveBlocks++;
+    _stats.usedBytes += size;
+    _stats.peakLiveBlocks = std::max(_stats.peakLiveBlocks, _stats.liveBlocks);
+
+    return block;
+}
+
+void SlabAllocator::deallocate(void* ptr, size_t size)
+{
+    if (ptr == nullptr)
+        return;
+
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    size_t index = (size - 1) / GRANULARITY;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& sizeClass = _sizeClasses[index];
+    CCASSERT(sizeClass.liveBlocks > 0, "SlabAllocator: block freed twice or with a wrong size");
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = sizeClass.freeList;
+    sizeClass.freeList = block;
+    sizeClass.liveBlocks--;
+    sizeClass.usedBytes -= size;
+
+    _stats.deallocations++;
+    _stats.liveBlocks--;
+    _stats.usedBytes -= size;
+}
+
+void SlabAllocator::reserve(size_t size, size_t count)
+{
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+        return;
+
+    size_t index = (size - 1) / GRANULARITY;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& sizeClass = _sizeClasses[index];
+    size_t capacity = sizeClass.pages.size() * getBlocksPerPage(index);
+    while (capacity < sizeClass.liveBlocks + count)
+    {
+        addPage(index);
+        capacity += getBlocksPerPage(index);
+    }
+}
+
+void SlabAllocator::purge()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t index = 0; index < NUM_SIZE_CLASSES; ++index)
+    {
+        purgeSizeClass(index);
+    }
+}
+
+void SlabAllocator::purgeSizeClass(size_t index)
+{
+    auto& sizeClass = _sizeClasses[index];
+    if (sizeClass.pages.empty())
+        return;
+
+    size_t blockSize = getBlockSize(index);
+    size_t blocks = getBlocksPerPage(index);
+    size_t pageBytes = blockSize * blocks;
+
+    // count the free blocks of every page, a page whose blocks are all free has no live object
+    std::vector<char*> pages = sizeClass.pages;
+    std::sort(pages.begin(), pages.end(), std::less<char*>());
+    std::vector<size_t> freeBlocks(pages.size(), 0);
+    auto findPage = [&](FreeBlock* block) -> size_t {
+        char* address = reinterpret_cast<char*>(block);
+        auto iter = std::upper_bound(pages.begin(), pages.end(), address, std::less<char*>());
+        return (iter - pages.begin()) - 1;
+    };
+    for (FreeBlock* block = sizeClass.freeList; block; block = block->next)
+    {
+        freeBlocks[findPage(block)]++;
+    }
+
+    size_t released = 0;
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        if (freeBlocks[i] == blocks)
+            released++;
+    }
+    if (released == 0)
+        return;
+
+    // drop the blocks of the empty pages from the free list, keeping the order of the others
+    FreeBlock** link = &sizeClass.freeList;
+    while (*link)
+    {
+        if (freeBlocks[findPage(*link)] == blocks)
+            *link = (*link)->next;
+        else
+            link = &(*link)->next;
+    }
+
+    sizeClass.pages.clear();
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        if (freeBlocks[i] == blocks)
+            ::operator delete(pages[i]);
+        else
+            sizeClass.pages.push_back(pages[i]);
+    }
+
+    _stats.pages -= released;
+    _stats.reservedBytes -= released * pageBytes;
+}
+
+SlabAllocator::Stats SlabAllocator::getStats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+std::string SlabAllocator::getDescription() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "<SlabAllocator | allocs = %lu, frees = %lu, fallbacks = %lu, live = %lu (peak %lu), pages = %lu, reserved = %.2f KB, fragmentation = %.1f%%>\n",
+             (unsigned long)_stats.allocations,
+             (unsigned long)_stats.deallocations,
+             (unsigned long)_stats.fallbackAllocations,
+             (unsigned long)_stats.liveBlocks,
+             (unsigned long)_stats.peakLiveBlocks,
+             (unsigned long)_stats.pages,
+             _stats.reservedBytes / 1024.0f,
+             _stats.getFragmentation() * 100.0f);
+    std::string ret = buffer;
+
+    for (size_t index = 0; index < NUM_SIZE_CLASSES; ++index)
+    {
+        const auto& sizeClass = _sizeClasses[index];
+        if (sizeClass.pages.empty())
+            continue;
+
+        size_t capacity = sizeClass.pages.size() * getBlocksPerPage(index);
+        snprintf(buffer, sizeof(buffer), "\"%lu bytes\" live = %lu/%lu, pages = %lu\n",
+                 (unsigned long)getBlockSize(index),
+                 (unsigned long)sizeClass.liveBlocks,
+                 (unsigned long)capacity,
+                 (unsigned long)sizeClass.pages.size());
+        ret += buffer;
+    }
+    return ret;
+}
+
+NS_CC_END
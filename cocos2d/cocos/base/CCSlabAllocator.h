@@ -0,0 +1,141 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCSLABALLOCATOR_H__
+#define __CCSLABALLOCATOR_H__
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CCPlatformMacros.h"
+#include "ccConfig.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+/**
+ * Size-classed slab allocator for short-lived engine objects.
+ *
+ * Memory is carved out of pages holding many blocks of the same size, and freed blocks are
+ * kept in a free list so the next object of that size reuses them without calling malloc.
+ * Classes opt in with the `CC_SLAB_ALLOCATED` macro, which overrides their operator new/delete.
+ * Subclasses inherit it; requests bigger than MAX_BLOCK_SIZE fall back to the global operator new.
+ */
+class CC_DLL SlabAllocator
+{
+public:
+    /** Block sizes are multiples of this value */
+    static const size_t GRANULARITY = 16;
+    /** Bigger requests are not served by the slabs */
+    static const size_t MAX_BLOCK_SIZE = 2048;
+
+    /** Allocation and fragmentation counters */
+    struct Stats
+    {
+        size_t allocations;         ///< blocks handed out by the slabs since startup
+        size_t deallocations;       ///< blocks given back to the slabs since startup
+        size_t fallbackAllocations; ///< requests too big for the slabs
+        size_t liveBlocks;          ///< blocks currently in use
+        size_t peakLiveBlocks;      ///< highest value of liveBlocks
+        size_t pages;               ///< pages currently owned by the slabs
+        size_t reservedBytes;       ///< bytes currently owned by the slabs
+        size_t usedBytes;           ///< bytes requested by the live objects
+
+        /** Share of the reserved memory that is not used by live objects, between 0 and 1 */
+        float getFragmentation() const;
+    };
+
+    /** returns the shared slab allocator */
+    static SlabAllocator* getInstance();
+
+    /** Allocates `size` bytes, from a slab when the size fits in one */
+    void* allocate(size_t size);
+    /** Releases memory returned by allocate(). `size` must be the size passed to allocate() */
+    void deallocate(void* ptr, size_t size);
+
+    /** Makes sure `count` objects of `size` bytes can be allocated without touching malloc, e.g. before spawning a burst of bullets */
+    void reserve(size_t size, size_t count);
+    /** Returns the pages that have no live block to the system. Called by Director::purgeCachedData() */
+    void purge();
+
+    /** Returns the counters of all the size classes */
+    Stats getStats() const;
+    /** Returns a human readable summary of the counters, one line per size class in use */
+    std::string getDescription() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct SizeClass
+    {
+        FreeBlock* freeList;
+        std::vector<char*> pages;
+        size_t liveBlocks;
+        size_t usedBytes;
+    };
+
+    static const size_t NUM_SIZE_CLASSES = MAX_BLOCK_SIZE / GRANULARITY;
+    static const size_t PAGE_SIZE = 16 * 1024;
+
+    SlabAllocator();
+
+    static size_t getBlockSize(size_t index) { return (index + 1) * GRANULARITY; }
+    static size_t getBlocksPerPage(size_t index);
+    void addPage(size_t index);
+    void purgeSizeClass(size_t index);
+
+    SizeClass _sizeClasses[NUM_SIZE_CLASSES];
+    Stats _stats;
+    mutable std::mutex _mutex;
+
+    CC_DISALLOW_COPY_AND_ASSIGN(SlabAllocator);
+};
+
+/** @def CC_SLAB_ALLOCATED
+ * Put it at the very beginning of a class declaration to allocate the instances of the class (and of its subclasses)
+ * from the SlabAllocator. It leaves the access specifier as public.
+ */
+#if CC_USE_SLAB_ALLOCATOR
+#define CC_SLAB_ALLOCATED \
+public: \
+    static void* operator new(size_t size) { return cocos2d::SlabAllocator::getInstance()->allocate(size); } \
+    static void operator delete(void* ptr, size_t size) { cocos2d::SlabAllocator::getInstance()->deallocate(ptr, size); }
+#else
+#define CC_SLAB_ALLOCATED public:
+#endif
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCSLABALLOCATOR_H__
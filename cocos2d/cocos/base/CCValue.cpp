@@ -23,153 +23,168 @@
  ****************************************************************************/
 
 #include "CCValue.h"
+#include "CCValueFlatMap.h"
 #include <sstream>
 #include <iomanip>
+#include <string.h>
 
 NS_CC_BEGIN
 
 const Value Value::Null;
 
 Value::Value()
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::NONE)
 {
-    
+    _field.doubleVal = 0.0;
 }
 
 Value::Value(unsigned char v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::BYTE)
 {
-    _baseData.byteVal = v;
+    _field.doubleVal = 0.0;
+    _field.byteVal = v;
 }
 
 Value::Value(int v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::INTEGER)
 {
-    _baseData.intVal = v;
+    _field.doubleVal = 0.0;
+    _field.intVal = v;
 }
 
 Value::Value(float v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::FLOAT)
 {
-    _baseData.floatVal = v;
+    _field.doubleVal = 0.0;
+    _field.floatVal = v;
 }
 
 Value::Value(double v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::DOUBLE)
 {
-    _baseData.doubleVal = v;
+    _field.doubleVal = 0.0;
+    _field.doubleVal = v;
 }
 
 Value::Value(bool v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::BOOLEAN)
 {
-    _baseData.boolVal = v;
+    _field.doubleVal = 0.0;
+    _field.boolVal = v;
 }
 
 Value::Value(const char* v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::STRING)
 {
-    _strData = v;
+    v = v ? v : "";
+    setString(v, strlen(v));
 }
 
 Value::Value(const std::string& v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::STRING)
 {
-    _strData = v;
+    setString(v.c_str(), v.length());
 }
 
 Value::Value(const ValueVector& v)
-: _vectorData(new ValueVector())
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::VECTOR)
 {
-    *_vectorData = v;
+    _field.vectorVal = new ValueVector(v);
 }
 
 Value::Value(ValueVector&& v)
-: _vectorData(new ValueVector())
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::VECTOR)
 {
-    *_vectorData = std::move(v);
+    _field.vectorVal = new ValueVector(std::move(v));
 }
 
 Value::Value(const ValueMap& v)
-: _vectorData(nullptr)
-, _mapData(new ValueMap())
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::MAP)
 {
-    *_mapData = v;
+    _field.mapVal = new ValueMap(v);
 }
 
 Value::Value(ValueMap&& v)
-: _vectorData(nullptr)
-, _mapData(new ValueMap())
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
 , _type(Type::MAP)
 {
-    *_mapData = std::move(v);
+    _field.mapVal = new ValueMap(std::move(v));
 }
 
 Value::Value(const ValueMapIntKey& v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(new ValueMapIntKey())
+: _inlineStringLength(0)
 , _type(Type::INT_KEY_MAP)
 {
-    *_intKeyMapData = v;
+    _field.intKeyMapVal = new ValueMapIntKey(v);
 }
 
 Value::Value(ValueMapIntKey&& v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(new ValueMapIntKey())
+: _inlineStringLength(0)
 , _type(Type::INT_KEY_MAP)
 {
-    *_intKeyMapData = std::move(v);
+    _field.intKeyMapVal = new ValueMapIntKey(std::move(v));
+}
+
+Value::Value(const ValueFlatMap& v)
+: _inlineStringLength(0)
+, _type(Type::FLAT_MAP)
+{
+    _field.flatMapVal = new ValueFlatMap(v);
+}
+
+Value::Value(ValueFlatMap&& v)
+: _inlineStringLength(0)
+, _type(Type::FLAT_MAP)
+{
+    _field.flatMapVal = new ValueFlatMap(std::move(v));
 }
 
 Value::Value(const Value& other)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(0)
+, _type(other._type)
 {
-    *this = other;
+    switch (other._type) {
+        case Type::STRING:
+            setString(other.getStringData(), other.getStringLength());
+            break;
+        case Type::VECTOR:
+            _field.vectorVal = new ValueVector(*other._field.vectorVal);
+            break;
+        case Type::MAP:
+            _field.mapVal = new ValueMap(*other._field.mapVal);
+            break;
+        case Type::INT_KEY_MAP:
+            _field.intKeyMapVal = new ValueMapIntKey(*other._field.intKeyMapVal);
+            break;
+        case Type::FLAT_MAP:
+            _field.flatMapVal = new ValueFlatMap(*other._field.flatMapVal);
+            break;
+        default:
+            _field = other._field;
+            break;
+    }
 }
 
 Value::Value(Value&& other)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _inlineStringLength(other._inlineStringLength)
+, _type(other._type)
 {
-    *this = std::move(other);
+    _field = other._field;
+
+    other._field.doubleVal = 0.0;
+    other._inlineStringLength = 0;
+    other._type = Type::NONE;
 }
 
 Value::~Value()
@@ -180,44 +195,9 @@ Value::~Value()
 Value& Value::operator= (const Value& other)
 {
     if (this != &other) {
-        switch (other._type) {
-            case Type::BYTE:
-                _baseData.byteVal = other._baseData.byteVal;
-                break;
-            case Type::INTEGER:
-                _baseData.intVal = other._baseData.intVal;
-                break;
-            case Type::FLOAT:
-                _baseData.floatVal = other._baseData.floatVal;
-                break;
-            case Type::DOUBLE:
-                _baseData.doubleVal = other._baseData.doubleVal;
-                break;
-            case Type::BOOLEAN:
-                _baseData.boolVal = other._baseData.boolVal;
-                break;
-            case Type::STRING:
-                _strData = other._strData;
-                break;
-            case Type::VECTOR:
-                if (_vectorData == nullptr)
-                    _vectorData = new ValueVector();
-                *_vectorData = *other._vectorData;
-                break;
-            case Type::MAP:
-                if (_mapData == nullptr)
-                    _mapData = new ValueMap();
-                *_mapData = *other._mapData;
-                break;
-            case Type::INT_KEY_MAP:
-                if (_intKeyMapData == nullptr)
-                    _intKeyMapData = new ValueMapIntKey();
-                *_intKeyMapData = *other._intKeyMapData;
-                break;
-            default:
-                break;
-        }
-        _type = other._type;
+        // other may be owned by this value, copy it before releasing anything
+        Value copy(other);
+        *this = std::move(copy);
     }
     return *this;
 }
@@ -225,46 +205,18 @@ Value& Value::operator= (const Value& other)
 Value& Value::operator= (Value&& other)
 {
     if (this != &other) {
-        switch (other._type) {
-            case Type::BYTE:
-                _baseData.byteVal = other._baseData.byteVal;
-                break;
-            case Type::INTEGER:
-                _baseData.intVal = other._baseData.intVal;
-                break;
-            case Type::FLOAT:
-                _baseData.floatVal = other._baseData.floatVal;
-                break;
-            case Type::DOUBLE:
-                _baseData.doubleVal = other._baseData.doubleVal;
-                break;
-            case Type::BOOLEAN:
-                _baseData.boolVal = other._baseData.boolVal;
-                break;
-            case Type::STRING:
-                _strData = other._strData;
-                break;
-            case Type::VECTOR:
-                CC_SAFE_DELETE(_vectorData);
-                _vectorData = other._vectorData;
-                break;
-            case Type::MAP:
-                CC_SAFE_DELETE(_mapData);
-                _mapData = other._mapData;
-                break;
-            case Type::INT_KEY_MAP:
-                CC_SAFE_DELETE(_intKeyMapData);
-                _intKeyMapData = other._intKeyMapData;
-                break;
-            default:
-                break;
-        }
-        _type = other._type;
-        
-        other._vectorData = nullptr;
-        other._mapData = nullptr;
-        other._intKeyMapData = nullptr;
+        auto field = other._field;
+        auto inlineStringLength = other._inlineStringLength;
+        auto type = other._type;
+
+        other._field.doubleVal = 0.0;
+        other._inlineStringLength = 0;
         other._type = Type::NONE;
+
+        clear();
+        _field = field;
+        _inlineStringLength = inlineStringLength;
+        _type = type;
     }
     
     return *this;
@@ -272,147 +224,154 @@ Value& Value::operator= (Value&& other)
 
 Value& Value::operator= (unsigned char v)
 {
-    clear();
-    _type = Type::BYTE;
-    _baseData.byteVal = v;
+    reset(Type::BYTE);
+    _field.byteVal = v;
     return *this;
 }
 
 Value& Value::operator= (int v)
 {
-    clear();
-    _type = Type::INTEGER;
-    _baseData.intVal = v;
+    reset(Type::INTEGER);
+    _field.intVal = v;
     return *this;
 }
 
 Value& Value::operator= (float v)
 {
-    clear();
-    _type = Type::FLOAT;
-    _baseData.floatVal = v;
+    reset(Type::FLOAT);
+    _field.floatVal = v;
     return *this;
 }
 
 Value& Value::operator= (double v)
 {
-    clear();
-    _type = Type::DOUBLE;
-    _baseData.doubleVal = v;
+    reset(Type::DOUBLE);
+    _field.doubleVal = v;
     return *this;
 }
 
 Value& Value::operator= (bool v)
 {
-    clear();
-    _type = Type::BOOLEAN;
-    _baseData.boolVal = v;
+    reset(Type::BOOLEAN);
+    _field.boolVal = v;
     return *this;
 }
 
 Value& Value::operator= (const char* v)
 {
-    clear();
-    _type = Type::STRING;
-    _strData = v ? v : "";
-    return *this;
+    // v may point into the string of this value
+    return *this = Value(v);
 }
 
 Value& Value::operator= (const std::string& v)
 {
-    clear();
-    _type = Type::STRING;
-    _strData = v;
-    return *this;
+    if (_type == Type::STRING && _inlineStringLength == HEAP_STRING && v.length() > INLINE_STRING_SIZE)
+    {
+        // reuse the buffer of the current string
+        _field.strVal->assign(v);
+        return *this;
+    }
+
+    return *this = Value(v);
 }
 
 Value& Value::operator= (const ValueVector& v)
 {
-    clear();
-    _type = Type::VECTOR;
-    _vectorData = new ValueVector();
-    *_vectorData = v;
+    ValueVector* data = new ValueVector(v);
+    reset(Type::VECTOR);
+    _field.vectorVal = data;
     return *this;
 }
 
 Value& Value::operator= (ValueVector&& v)
 {
-    clear();
-    _type = Type::VECTOR;
-    _vectorData = new ValueVector();
-    *_vectorData = std::move(v);
+    ValueVector* data = new ValueVector(std::move(v));
+    reset(Type::VECTOR);
+    _field.vectorVal = data;
     return *this;
 }
 
 Value& Value::operator= (const ValueMap& v)
 {
-    clear();
-    _type = Type::MAP;
-    _mapData = new ValueMap();
-    *_mapData = v;
+    ValueMap* data = new ValueMap(v);
+    reset(Type::MAP);
+    _field.mapVal = data;
     return *this;
 }
 
 Value& Value::operator= (ValueMap&& v)
 {
-    clear();
-    _type = Type::MAP;
-    _mapData = new ValueMap();
-    *_mapData = std::move(v);
+    ValueMap* data = new ValueMap(std::move(v));
+    reset(Type::MAP);
+    _field.mapVal = data;
     return *this;
 }
 
 Value& Value::operator= (const ValueMapIntKey& v)
 {
-    clear();
-    _type = Type::INT_KEY_MAP;
-    _intKeyMapData = new ValueMapIntKey();
-    *_intKeyMapData = v;
+    ValueMapIntKey* data = new ValueMapIntKey(v);
+    reset(Type::INT_KEY_MAP);
+    _field.intKeyMapVal = data;
     return *this;
 }
 
 Value& Value::operator= (ValueMapIntKey&& v)
 {
-    clear();
-    _type = Type::INT_KEY_MAP;
-    _intKeyMapData = new ValueMapIntKey();
-    *_intKeyMapData = std::move(v);
+    ValueMapIntKey* data = new ValueMapIntKey(std::move(v));
+    reset(Type::INT_KEY_MAP);
+    _field.intKeyMapVal = data;
+    return *this;
+}
+
+Value& Value::operator= (const ValueFlatMap& v)
+{
+    ValueFlatMap* data = new ValueFlatMap(v);
+    reset(Type::FLAT_MAP);
+    _field.flatMapVal = data;
+    return *this;
+}
+
+Value& Value::operator= (ValueFlatMap&& v)
+{
+    ValueFlatMap* data = new ValueFlatMap(std::move(v));
+    reset(Type::FLAT_MAP);
+    _field.flatMapVal = data;
     return *this;
 }
 
 ///
 unsigned char Value::asByte() const
 {
-    CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
+    CCASSERT(_type != Type::VECTOR && _type != Type::MAP && _type != Type::FLAT_MAP, "");
     
     if (_type == Type::BYTE)
     {
-        return _baseData.byteVal;
+        return _field.byteVal;
     }
     
     if (_type == Type::INTEGER)
     {
-        return static_cast<unsigned char>(_baseData.intVal);
+        return static_cast<unsigned char>(_field.intVal);
     }
     
     if (_type == Type::STRING)
     {
-        return static_cast<unsigned char>(atoi(_strData.c_str()));
+        return static_cast<unsigned char>(atoi(getStringData()));
     }
     
     if (_type == Type::FLOAT)
     {
-        return static_cast<unsigned char>(_baseData.floatVal);
+        return static_cast<unsigned char>(_field.floatVal);
     }
     
     if (_type == Type::DOUBLE)
     {
-        return static_cast<unsigned char>(_baseData.doubleVal);
+        return static_cast<unsigned char>(_field.doubleVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1 : 0;
+        return _field.boolVal ? 1 : 0;
     }
     
     return 0;
@@ -420,35 +379,35 @@ unsigned char Value::asByte() const
 
 int Value::asInt() const
 {
-    CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
+    CCASSERT(_type != Type::VECTOR && _type != Type::MAP && _type != Type::FLAT_MAP, "");
     if (_type == Type::INTEGER)
     {
-        return _baseData.intVal;
+        return _field.intVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return _baseData.byteVal;
+        return _field.byteVal;
     }
     
     if (_type == Type::STRING)
     {
-        return atoi(_strData.c_str());
+        return atoi(getStringData());
     }
     
     if (_type == Type::FLOAT)
     {
-        return static_cast<int>(_baseData.floatVal);
+        return static_cast<int>(_field.floatVal);
     }
     
     if (_type == Type::DOUBLE)
     {
-        return static_cast<int>(_baseData.doubleVal);
+        return static_cast<int>(_field.doubleVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1 : 0;
+        return _field.boolVal ? 1 : 0;
     }
     
     return 0;
@@ -456,35 +415,35 @@ int Value::asInt() const
 
 float Value::asFloat() const
 {
-    CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
+    CCASSERT(_type != Type::VECTOR && _type != Type::MAP && _type != Type::FLAT_MAP, "");
     if (_type == Type::FLOAT)
     {
-        return _baseData.floatVal;
+        return _field.floatVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return static_cast<float>(_baseData.byteVal);
+        return static_cast<float>(_field.byteVal);
     }
     
     if (_type == Type::STRING)
     {
-        return atof(_strData.c_str());
+        return atof(getStringData());
     }
     
     if (_type == Type::INTEGER)
     {
-        return static_cast<float>(_baseData.intVal);
+        return static_cast<float>(_field.intVal);
     }
     
     if (_type == Type::DOUBLE)
     {
-        return static_cast<float>(_baseData.doubleVal);
+        return static_cast<float>(_field.doubleVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1.0f : 0.0f;
+        return _field.boolVal ? 1.0f : 0.0f;
     }
     
     return 0.0f;
@@ -492,35 +451,35 @@ float Value::asFloat() const
 
 double Value::asDouble() const
 {
-    CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
+    CCASSERT(_type != Type::VECTOR && _type != Type::MAP && _type != Type::FLAT_MAP, "");
     if (_type == Type::DOUBLE)
     {
-        return _baseData.doubleVal;
+        return _field.doubleVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return static_cast<double>(_baseData.byteVal);
+        return static_cast<double>(_field.byteVal);
     }
     
     if (_type == Type::STRING)
     {
-        return static_cast<double>(atof(_strData.c_str()));
+        return static_cast<double>(atof(getStringData()));
     }
     
     if (_type == Type::INTEGER)
     {
-        return static_cast<double>(_baseData.intVal);
+        return static_cast<double>(_field.intVal);
     }
     
     if (_type == Type::FLOAT)
     {
-        return static_cast<double>(_baseData.floatVal);
+        return static_cast<double>(_field.floatVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1.0 : 0.0;
+        return _field.boolVal ? 1.0 : 0.0;
     }
     
     return 0.0;
@@ -528,35 +487,36 @@ double Value::asDouble() const
 
 bool Value::asBool() const
 {
-    CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
+    CCASSERT(_type != Type::VECTOR && _type != Type::MAP && _type != Type::FLAT_MAP, "");
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal;
+        return _field.boolVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return _baseData.byteVal == 0 ? false : true;
+        return _field.byteVal == 0 ? false : true;
     }
     
     if (_type == Type::STRING)
     {
-        return (_strData == "0" || _strData == "false") ? false : true;
+        const char* str = getStringData();
+        return (strcmp(str, "0") == 0 || strcmp(str, "false") == 0) ? false : true;
     }
     
     if (_type == Type::INTEGER)
     {
-        return _baseData.intVal == 0 ? false : true;
+        return _field.intVal == 0 ? false : true;
     }
     
     if (_type == Type::FLOAT)
     {
-        return _baseData.floatVal == 0.0f ? false : true;
+        return _field.floatVal == 0.0f ? false : true;
     }
     
     if (_type == Type::DOUBLE)
     {
-        return _baseData.doubleVal == 0.0 ? false : true;
+        return _field.doubleVal == 0.0 ? false : true;
     }
     
     return true;
@@ -564,11 +524,11 @@ bool Value::asBool() const
 
 std::string Value::asString() const
 {
-    CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
+    CCASSERT(_type != Type::VECTOR && _type != Type::MAP && _type != Type::FLAT_MAP, "");
     
     if (_type == Type::STRING)
     {
-        return _strData;
+        return std::string(getStringData(), getStringLength());
     }
     
     std::stringstream ret;
@@ -576,19 +536,19 @@ std::string Value::asString() const
     
     switch (_type) {
         case Type::BYTE:
-            ret << _baseData.byteVal;
+            ret << _field.byteVal;
             break;
         case Type::INTEGER:
-            ret << _baseData.intVal;
+            ret << _field.intVal;
             break;
         case Type::FLOAT:
-            ret << std::fixed << std::setprecision( 7 )<< _baseData.floatVal;
+            ret << std::fixed << std::setprecision( 7 )<< _field.floatVal;
             break;
         case Type::DOUBLE:
-            ret << std::fixed << std::setprecision( 16 ) << _baseData.doubleVal;
+            ret << std::fixed << std::setprecision( 16 ) << _field.doubleVal;
             break;
         case Type::BOOLEAN:
-            ret << (_baseData.boolVal ? "true" : "false");
+            ret << (_field.boolVal ? "true" : "false");
             break;
         default:
             break;
@@ -598,47 +558,106 @@ std::string Value::asString() const
 
 ValueVector& Value::asValueVector()
 {
-	if (nullptr == _vectorData)
-		_vectorData = new ValueVector();
-	return *_vectorData;
+    CCASSERT(_type == Type::NONE || _type == Type::VECTOR, "Value holds another type, use convertToValueVector() to replace it");
+    if (_type != Type::VECTOR)
+        return convertToValueVector();
+    return *_field.vectorVal;
 }
 
 const ValueVector& Value::asValueVector() const
 {
 	static const ValueVector EMPTY_VALUEVECTOR;
-	if (nullptr == _vectorData)
-		return EMPTY_VALUEVECTOR;
-	return *_vectorData; 
+    if (_type != Type::VECTOR)
+        return EMPTY_VALUEVECTOR;
+    return *_field.vectorVal; 
 }
 
 ValueMap& Value::asValueMap()
 {
-	if (nullptr == _mapData)
-		_mapData = new ValueMap();
-	return *_mapData;
+    CCASSERT(_type == Type::NONE || _type == Type::MAP, "Value holds another type, use convertToValueMap() to replace it");
+    if (_type != Type::MAP)
+        return convertToValueMap();
+    return *_field.mapVal;
 }
 
 const ValueMap& Value::asValueMap() const
 {
 	static const ValueMap EMPTY_VALUEMAP;
-	if (nullptr == _mapData)
-		return EMPTY_VALUEMAP;
-	return *_mapData;
+    if (_type != Type::MAP)
+        return EMPTY_VALUEMAP;
+    return *_field.mapVal;
 }
 
 ValueMapIntKey& Value::asIntKeyMap()
 {
-	if (nullptr == _intKeyMapData)
-		_intKeyMapData = new ValueMapIntKey();
-	return *_intKeyMapData;
+    CCASSERT(_type == Type::NONE || _type == Type::INT_KEY_MAP, "Value holds another type, use convertToIntKeyMap() to replace it");
+    if (_type != Type::INT_KEY_MAP)
+        return convertToIntKeyMap();
+    return *_field.intKeyMapVal;
 }
 
 const ValueMapIntKey& Value::asIntKeyMap() const
 {
 	static const ValueMapIntKey EMPTY_VALUEMAP_INT_KEY;
-	if (nullptr == _intKeyMapData)
-		return EMPTY_VALUEMAP_INT_KEY;
-	return *_intKeyMapData;
+    if (_type != Type::INT_KEY_MAP)
+        return EMPTY_VALUEMAP_INT_KEY;
+    return *_field.intKeyMapVal;
+}
+
+ValueFlatMap& Value::asValueFlatMap()
+{
+    CCASSERT(_type == Type::NONE || _type == Type::FLAT_MAP, "Value holds another type, use convertToValueFlatMap() to replace it");
+    if (_type != Type::FLAT_MAP)
+        return convertToValueFlatMap();
+    return *_field.flatMapVal;
+}
+
+const ValueFlatMap& Value::asValueFlatMap() const
+{
+    static const ValueFlatMap EMPTY_VALUEFLATMAP;
+    if (_type != Type::FLAT_MAP)
+        return EMPTY_VALUEFLATMAP;
+    return *_field.flatMapVal;
+}
+
+ValueVector& Value::convertToValueVector()
+{
+    if (_type != Type::VECTOR)
+    {
+        reset(Type::VECTOR);
+        _field.vectorVal = new ValueVector();
+    }
+    return *_field.vectorVal;
+}
+
+ValueMap& Value::convertToValueMap()
+{
+    if (_type != Type::MAP)
+    {
+        reset(Type::MAP);
+        _field.mapVal = new ValueMap();
+    }
+    return *_field.mapVal;
+}
+
+ValueMapIntKey& Value::convertToIntKeyMap()
+{
+    if (_type != Type::INT_KEY_MAP)
+    {
+        reset(Type::INT_KEY_MAP);
+        _field.intKeyMapVal = new ValueMapIntKey();
+    }
+    return *_field.intKeyMapVal;
+}
+
+ValueFlatMap& Value::convertToValueFlatMap()
+{
+    if (_type != Type::FLAT_MAP)
+    {
+        reset(Type::FLAT_MAP);
+        _field.flatMapVal = new ValueFlatMap();
+    }
+    return *_field.flatMapVal;
 }
 
 static std::string getTabs(int depth)
@@ -721,6 +740,9 @@ static std::string visit(const Value& v, int depth)
         case Value::Type::INT_KEY_MAP:
             ret << visitMap(v.asIntKeyMap(), depth);
             break;
+        case Value::Type::FLAT_MAP:
+            ret << visitMap(v.asValueFlatMap(), depth);
+            break;
         default:
             CCASSERT(false, "Invalid type!");
             break;
@@ -738,12 +760,61 @@ std::string Value::getDescription()
 
 void Value::clear()
 {
+    switch (_type) {
+        case Type::STRING:
+            if (_inlineStringLength == HEAP_STRING)
+                delete _field.strVal;
+            break;
+        case Type::VECTOR:
+            delete _field.vectorVal;
+            break;
+        case Type::MAP:
+            delete _field.mapVal;
+            break;
+        case Type::INT_KEY_MAP:
+            delete _field.intKeyMapVal;
+            break;
+        case Type::FLAT_MAP:
+            delete _field.flatMapVal;
+            break;
+        default:
+            break;
+    }
+
     _type = Type::NONE;
-    _baseData.doubleVal = 0.0;
-    _strData.clear();
-    CC_SAFE_DELETE(_vectorData);
-    CC_SAFE_DELETE(_mapData);
-    CC_SAFE_DELETE(_intKeyMapData);
+    _field.doubleVal = 0.0;
+    _inlineStringLength = 0;
+}
+
+void Value::reset(Type type)
+{
+    clear();
+    _type = type;
+}
+
+void Value::setString(const char* str, size_t length)
+{
+    if (length <= INLINE_STRING_SIZE)
+    {
+        memcpy(_field.inlineStringVal, str, length);
+        _field.inlineStringVal[length] = '\0';
+        _inlineStringLength = static_cast<unsigned char>(length);
+    }
+    else
+    {
+        _field.strVal = new std::string(str, length);
+        _inlineStringLength = HEAP_STRING;
+    }
+}
+
+const char* Value::getStringData() const
+{
+    return _inlineStringLength == HEAP_STRING ? _field.strVal->c_str() : _field.inlineStringVal;
+}
+
+size_t Value::getStringLength() const
+{
+    return _inlineStringLength == HEAP_STRING ? _field.strVal->length() : _inlineStringLength;
 }
 
 NS_CC_END
@@ -34,6 +34,7 @@
 NS_CC_BEGIN
 
 class Value;
+class ValueFlatMap;
 
 typedef std::vector<Value> ValueVector;
 typedef std::unordered_map<std::string, Value> ValueMap;
@@ -61,6 +62,9 @@ public:
     
     explicit Value(const ValueMapIntKey& v);
     explicit Value(ValueMapIntKey&& v);
+
+    explicit Value(const ValueFlatMap& v);
+    explicit Value(ValueFlatMap&& v);
     
     Value(const Value& other);
     Value(Value&& other);
@@ -86,6 +90,9 @@ public:
     
     Value& operator= (const ValueMapIntKey& v);
     Value& operator= (ValueMapIntKey&& v);
+
+    Value& operator= (const ValueFlatMap& v);
+    Value& operator= (ValueFlatMap&& v);
     
     unsigned char asByte() const;
     int asInt() const;
@@ -93,7 +100,11 @@ public:
     double asDouble() const;
     bool asBool() const;
     std::string asString() const;
-    
+
+    /** The non const container accessors turn a null value into an empty container. Calling them on a value
+     of another type asserts; without assertions the value is replaced by an empty container, as the convertTo
+     accessors do. Use the convertTo accessors to replace such a value on purpose.
+     */
     ValueVector& asValueVector();
     const ValueVector& asValueVector() const;
     
@@ -103,6 +114,15 @@ public:
     ValueMapIntKey& asIntKeyMap();
     const ValueMapIntKey& asIntKeyMap() const;
 
+    ValueFlatMap& asValueFlatMap();
+    const ValueFlatMap& asValueFlatMap() const;
+
+    /** Makes the value an empty container, unless it already holds a container of this type, and returns it */
+    ValueVector& convertToValueVector();
+    ValueMap& convertToValueMap();
+    ValueMapIntKey& convertToIntKeyMap();
+    ValueFlatMap& convertToValueFlatMap();
+
     inline bool isNull() const { return _type == Type::NONE; }
     
     enum class Type
@@ -116,7 +136,8 @@ public:
         STRING,
         VECTOR,
         MAP,
-        INT_KEY_MAP
+        INT_KEY_MAP,
+        FLAT_MAP
     };
 
     inline Type getType() const { return _type; };
@@ -125,7 +146,16 @@ public:
     
 private:
     void clear();
-    
+    void reset(Type type);
+    void setString(const char* str, size_t length);
+    const char* getStringData() const;
+    size_t getStringLength() const;
+
+    //! strings up to this length are stored inside the Value, without a heap allocation
+    static const size_t INLINE_STRING_SIZE = 23;
+    //! _inlineStringLength of a string allocated on the heap
+    static const unsigned char HEAP_STRING = 0xff;
+
     union
     {
         unsigned char byteVal;
@@ -133,13 +163,16 @@ private:
         float floatVal;
         double doubleVal;
         bool boolVal;
-    }_baseData;
-    
-    std::string _strData;
-    ValueVector* _vectorData;
-    ValueMap* _mapData;
-    ValueMapIntKey* _intKeyMapData;
 
+        char inlineStringVal[INLINE_STRING_SIZE + 1];
+        std::string* strVal;
+        ValueVector* vectorVal;
+        ValueMap* mapVal;
+        ValueMapIntKey* intKeyMapVal;
+        ValueFlatMap* flatMapVal;
+    }_field;
+
+    unsigned char _inlineStringLength;
     Type _type;
 };
 
@@ -0,0 +1,361 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "CCValueFlatMap.h"
+#include <string.h>
+
+NS_CC_BEGIN
+
+static const size_t MIN_SLOTS_COUNT = 8;
+
+ValueFlatMap::ValueFlatMap()
+{
+}
+
+// copy of a value where the nested ValueMap are turned into ValueFlatMap
+static Value toFlatValue(const Value& value)
+{
+    switch (value.getType())
+    {
+        case Value::Type::MAP:
+            return Value(ValueFlatMap(value.asValueMap()));
+        case Value::Type::VECTOR:
+        {
+            ValueVector array;
+            array.reserve(value.asValueVector().size());
+            for (const auto& element : value.asValueVector())
+            {
+                array.push_back(toFlatValue(element));
+            }
+            return Value(std::move(array));
+        }
+        default:
+            return value;
+    }
+}
+
+// copy of a value where the nested ValueFlatMap are turned into ValueMap
+static Value toMapValue(const Value& value)
+{
+    switch (value.getType())
+    {
+        case Value::Type::FLAT_MAP:
+            return Value(value.asValueFlatMap().toValueMap());
+        case Value::Type::VECTOR:
+        {
+            ValueVector array;
+            array.reserve(value.asValueVector().size());
+            for (const auto& element : value.asValueVector())
+            {
+                array.push_back(toMapValue(element));
+            }
+            return Value(std::move(array));
+        }
+        default:
+            return value;
+    }
+}
+
+ValueFlatMap::ValueFlatMap(const ValueMap& dict)
+{
+    reserve(dict.size());
+    for (const auto& iter : dict)
+    {
+        insert(value_type(iter.first, toFlatValue(iter.second)));
+    }
+}
+
+ValueFlatMap::ValueFlatMap(const ValueFlatMap& other)
+: _entries(other._entries)
+, _hashes(other._hashes)
+, _slots(other._slots)
+{
+}
+
+ValueFlatMap::ValueFlatMap(ValueFlatMap&& other)
+: _entries(std::move(other._entries))
+, _hashes(std::move(other._hashes))
+, _slots(std::move(other._slots))
+{
+}
+
+ValueFlatMap& ValueFlatMap::operator= (const ValueFlatMap& other)
+{
+    if (this != &other)
+    {
+        _entries = other._entries;
+        _hashes = other._hashes;
+        _slots = other._slots;
+    }
+    return *this;
+}
+
+ValueFlatMap& ValueFlatMap::operator= (ValueFlatMap&& other)
+{
+    if (this != &other)
+    {
+        _entries = std::move(other._entries);
+        _hashes = std::move(other._hashes);
+        _slots = std::move(other._slots);
+    }
+    return *this;
+}
+
+uint32_t ValueFlatMap::hash(const char* key, size_t length)
+{
+    // FNV-1a
+    uint32_t ret = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        ret ^= static_cast<unsigned char>(key[i]);
+        ret *= 16777619u;
+    }
+    return ret;
+}
+
+void ValueFlatMap::reserve(size_t count)
+{
+    _entries.reserve(count);
+    _hashes.reserve(count);
+
+    // keep the load factor under 3/4
+    size_t slotsCount = _slots.empty() ? MIN_SLOTS_COUNT : _slots.size();
+    while (count * 4 > slotsCount * 3)
+    {
+        slotsCount *= 2;
+    }
+    if (slotsCount != _slots.size())
+    {
+        rehash(slotsCount);
+    }
+}
+
+void ValueFlatMap::clear()
+{
+    _entries.clear();
+    _hashes.clear();
+    _slots.clear();
+}
+
+void ValueFlatMap::rehash(size_t slotsCount)
+{
+    _slots.assign(slotsCount, 0);
+
+    size_t mask = slotsCount - 1;
+    for (size_t i = 0; i < _hashes.size(); ++i)
+    {
+        size_t slot = _hashes[i] & mask;
+        while (_slots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+size_t ValueFlatMap::findSlot(const char* key, size_t length, uint32_t keyHash) const
+{
+    size_t mask = _slots.size() - 1;
+    for (size_t slot = keyHash & mask; ; slot = (slot + 1) & mask)
+    {
+        uint32_t index = _slots[slot];
+        if (index == 0)
+        {
+            return slot;
+        }
+
+        --index;
+        const std::string& entryKey = _entries[index].first;
+        if (_hashes[index] == keyHash && entryKey.length() == length && memcmp(entryKey.data(), key, length) == 0)
+        {
+            return slot;
+        }
+    }
+}
+
+ssize_t ValueFlatMap::findIndex(const char* key, size_t length) const
+{
+    if (_entries.empty())
+    {
+        return -1;
+    }
+
+    uint32_t index = _slots[findSlot(key, length, hash(key, length))];
+    return static_cast<ssize_t>(index) - 1;
+}
+
+ValueFlatMap::iterator ValueFlatMap::find(const std::string& key)
+{
+    ssize_t index = findIndex(key.data(), key.length());
+    return index < 0 ? _entries.end() : _entries.begin() + index;
+}
+
+ValueFlatMap::const_iterator ValueFlatMap::find(const std::string& key) const
+{
+    ssize_t index = findIndex(key.data(), key.length());
+    return index < 0 ? _entries.end() : _entries.begin() + index;
+}
+
+ValueFlatMap::iterator ValueFlatMap::find(const char* key)
+{
+    ssize_t index = findIndex(key, strlen(key));
+    return index < 0 ? _entries.end() : _entries.begin() + index;
+}
+
+ValueFlatMap::const_iterator ValueFlatMap::find(const char* key) const
+{
+    ssize_t index = findIndex(key, strlen(key));
+    return index < 0 ? _entries.end() : _entries.begin() + index;
+}
+
+Value& ValueFlatMap::at(const std::string& key)
+{
+    auto iter = find(key);
+    CCASSERT(iter != end(), "ValueFlatMap: key not found");
+    return iter->second;
+}
+
+const Value& ValueFlatMap::at(const std::string& key) const
+{
+    auto iter = find(key);
+    CCASSERT(iter != end(), "ValueFlatMap: key not found");
+    return iter->second;
+}
+
+Value& ValueFlatMap::operator[] (const std::string& key)
+{
+    auto iter = find(key);
+    if (iter != end())
+    {
+        return iter->second;
+    }
+    return insertEntry(value_type(key, Value())).first->second;
+}
+
+std::pair<ValueFlatMap::iterator, bool> ValueFlatMap::insert(const value_type& entry)
+{
+    auto iter = find(entry.first);
+    if (iter != end())
+    {
+        return std::make_pair(iter, false);
+    }
+    return insertEntry(value_type(entry));
+}
+
+std::pair<ValueFlatMap::iterator, bool> ValueFlatMap::insert(value_type&& entry)
+{
+    auto iter = find(entry.first);
+    if (iter != end())
+    {
+        return std::make_pair(iter, false);
+    }
+    return insertEntry(std::move(entry));
+}
+
+std::pair<ValueFlatMap::iterator, bool> ValueFlatMap::insertEntry(value_type&& entry)
+{
+    // the key is known to be missing, grow the table to keep the load factor under 3/4
+    if ((_entries.size() + 1) * 4 > _slots.size() * 3)
+    {
+        rehash(_slots.empty() ? MIN_SLOTS_COUNT : _slots.size() * 2);
+    }
+
+    uint32_t keyHash = hash(entry.first.data(), entry.first.length());
+    size_t slot = findSlot(entry.first.data(), entry.first.length(), keyHash);
+
+    _entries.push_back(std::move(entry));
+    _hashes.push_back(keyHash);
+    _slots[slot] = static_cast<uint32_t>(_entries.size());
+
+    return std::make_pair(_entries.end() - 1, true);
+}
+
+size_t ValueFlatMap::erase(const std::string& key)
+{
+    ssize_t index = findIndex(key.data(), key.length());
+    if (index < 0)
+    {
+        return 0;
+    }
+
+    eraseIndex(index);
+    return 1;
+}
+
+ValueFlatMap::iterator ValueFlatMap::erase(iterator position)
+{
+    size_t index = position - _entries.begin();
+    eraseIndex(index);
+    return _entries.begin() + index;
+}
+
+void ValueFlatMap::eraseIndex(size_t index)
+{
+    size_t mask = _slots.size() - 1;
+
+    // empty the slot of the entry, shifting back the following entries of the probe sequence
+    size_t hole = findSlot(_entries[index].first.data(), _entries[index].first.length(), _hashes[index]);
+    for (size_t slot = (hole + 1) & mask; _slots[slot] != 0; slot = (slot + 1) & mask)
+    {
+        size_t ideal = _hashes[_slots[slot] - 1] & mask;
+        if (((slot - ideal) & mask) >= ((slot - hole) & mask))
+        {
+            _slots[hole] = _slots[slot];
+            hole = slot;
+        }
+    }
+    _slots[hole] = 0;
+
+    // move the last entry into the hole of the entries
+    size_t last = _entries.size() - 1;
+    if (index != last)
+    {
+        for (size_t slot = _hashes[last] & mask; ; slot = (slot + 1) & mask)
+        {
+            if (_slots[slot] == last + 1)
+            {
+                _slots[slot] = static_cast<uint32_t>(index + 1);
+                break;
+            }
+        }
+        _entries[index] = std::move(_entries[last]);
+        _hashes[index] = _hashes[last];
+    }
+    _entries.pop_back();
+    _hashes.pop_back();
+}
+
+ValueMap ValueFlatMap::toValueMap() const
+{
+    ValueMap ret;
+    ret.reserve(_entries.size());
+    for (const auto& entry : _entries)
+    {
+        ret.insert(std::make_pair(entry.first, toMapValue(entry.second)));
+    }
+    return ret;
+}
+
+NS_CC_END
@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __cocos2d_libs__CCValueFlatMap__
+#define __cocos2d_libs__CCValueFlatMap__
+
+#include "CCValue.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+NS_CC_BEGIN
+
+/** @brief A string to Value map with the same interface as ValueMap, stored in flat arrays.
+
+ The entries are kept contiguously in a vector and indexed by an open addressing hash table,
+ so a map costs three allocations whatever its size, instead of one per key, and the lookups
+ don't follow any pointer. Keys can be looked up with a C string, without building a std::string.
+
+ Iterating visits the entries in insertion order. Erasing moves the last entry into the hole,
+ and invalidates the iterators and references to the last entry.
+ */
+class CC_DLL ValueFlatMap
+{
+public:
+    typedef std::pair<std::string, Value> value_type;
+    typedef std::vector<value_type>::iterator iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    ValueFlatMap();
+    /** Copies a ValueMap, the dictionaries nested in it become ValueFlatMap too */
+    explicit ValueFlatMap(const ValueMap& dict);
+    ValueFlatMap(const ValueFlatMap& other);
+    ValueFlatMap(ValueFlatMap&& other);
+
+    ValueFlatMap& operator= (const ValueFlatMap& other);
+    ValueFlatMap& operator= (ValueFlatMap&& other);
+
+    iterator begin() { return _entries.begin(); }
+    const_iterator begin() const { return _entries.begin(); }
+
+    iterator end() { return _entries.end(); }
+    const_iterator end() const { return _entries.end(); }
+
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+
+    /** Reserves room for count entries, so that they can be inserted without rehashing */
+    void reserve(size_t count);
+    void clear();
+
+    iterator find(const std::string& key);
+    const_iterator find(const std::string& key) const;
+    iterator find(const char* key);
+    const_iterator find(const char* key) const;
+
+    size_t count(const std::string& key) const { return find(key) != end() ? 1 : 0; }
+
+    /** Returns the value of the key, asserts if there is none */
+    Value& at(const std::string& key);
+    const Value& at(const std::string& key) const;
+
+    /** Returns the value of the key, inserting a null Value if there is none */
+    Value& operator[] (const std::string& key);
+
+    std::pair<iterator, bool> insert(const value_type& entry);
+    std::pair<iterator, bool> insert(value_type&& entry);
+
+    /** Returns the number of erased entries */
+    size_t erase(const std::string& key);
+    /** Returns the iterator of the entry that took the place of the erased one */
+    iterator erase(iterator position);
+
+    /** Converts the map to a ValueMap, the nested ValueFlatMap become ValueMap too */
+    ValueMap toValueMap() const;
+
+private:
+    static uint32_t hash(const char* key, size_t length);
+
+    size_t findSlot(const char* key, size_t length, uint32_t keyHash) const;
+    ssize_t findIndex(const char* key, size_t length) const;
+    std::pair<iterator, bool> insertEntry(value_type&& entry);
+    void eraseIndex(size_t index);
+    void rehash(size_t slotsCount);
+
+    std::vector<value_type> _entries;
+    //! hash of the key of each entry
+    std::vector<uint32_t> _hashes;
+    //! open addressing table, 0 for an empty slot, the index of the entry + 1 otherwise
+    std::vector<uint32_t> _slots;
+};
+
+NS_CC_END
+
+#endif /* defined(__cocos2d_libs__CCValueFlatMap__) */
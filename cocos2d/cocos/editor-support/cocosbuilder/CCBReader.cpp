@@ -17,12 +17,31 @@
 #include "CCBSequenceProperty.h"
 #include "CCBKeyframe.h"
 #include <sstream>
+#include <unordered_map>
 
 using namespace cocos2d;
 using namespace cocos2d::extension;
 
 namespace cocosbuilder {
 
+/*************************************************************************
+ Implementation of CCBTemplate
+ *************************************************************************/
+
+/**
+ * A decoded ccbi file: its string cache, and every value the reader and the node loaders read from it, in order.
+ * Floats are kept as their bits, strings read by readUTF8() as indexes in the string cache.
+ */
+class CCBTemplate
+{
+public:
+    std::vector<std::string> strings;
+    std::vector<int> values;
+};
+
+static bool __ccbTemplateCacheEnabled = true;
+static std::unordered_map<std::string, std::shared_ptr<CCBTemplate>> __ccbTemplates;
+
 /*************************************************************************
  Implementation of CCBFile
  *************************************************************************/
@@ -62,6 +81,8 @@ CCBReader::CCBReader(NodeLoaderLibrary * pNodeLoaderLibrary, CCBMemberVariableAs
 , _bytes(nullptr)
 , _currentByte(-1)
 , _currentBit(-1)
+, _replaying(false)
+, _replayIndex(0)
 , _owner(nullptr)
 , _animationManager(nullptr)
 , _animatedProps(nullptr)
@@ -79,6 +100,8 @@ CCBReader::CCBReader(CCBReader * ccbReader)
 , _bytes(nullptr)
 , _currentByte(-1)
 , _currentBit(-1)
+, _replaying(false)
+, _replayIndex(0)
 , _owner(nullptr)
 , _animationManager(nullptr)
 , _animatedProps(nullptr)
@@ -101,6 +124,8 @@ CCBReader::CCBReader()
 , _bytes(nullptr)
 , _currentByte(-1)
 , _currentBit(-1)
+, _replaying(false)
+, _replayIndex(0)
 , _owner(nullptr)
 , _animationManager(nullptr)
 , _nodeLoaderLibrary(nullptr)
@@ -222,9 +247,9 @@ Node* CCBReader::readNodeGraphFromFile(const char *pCCBFileName, Ref *pOwner, co
 
     std::string strPath = FileUtils::getInstance()->fullPathForFilename(strCCBFileName.c_str());
 
-    auto dataPtr = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(strPath));
+    loadFile(strPath);
     
-    Node *ret =  this->readNodeGraphFromData(dataPtr, pOwner, parentSize);
+    Node *ret =  this->readLoadedNodeGraph(pOwner, parentSize);
     
     return ret;
 }
@@ -235,6 +260,46 @@ Node* CCBReader::readNodeGraphFromData(std::shared_ptr<cocos2d::Data> data, Ref
     _bytes =_data->getBytes();
     _currentByte = 0;
     _currentBit = 0;
+    _template = nullptr;
+    _templatePath.clear();
+    _replaying = false;
+
+    return readLoadedNodeGraph(pOwner, parentSize);
+}
+
+void CCBReader::loadFile(const std::string& pPath)
+{
+    _currentByte = 0;
+    _currentBit = 0;
+    _template = nullptr;
+    _templatePath.clear();
+    _replaying = false;
+    _replayIndex = 0;
+
+    if (__ccbTemplateCacheEnabled)
+    {
+        auto iter = __ccbTemplates.find(pPath);
+        if (iter != __ccbTemplates.end())
+        {
+            // The bytes are not needed, the values are replayed from the template
+            _template = iter->second;
+            _replaying = true;
+            _data = nullptr;
+            _bytes = nullptr;
+            return;
+        }
+
+        // Record the values decoded from the file, the template is cached once the file has been read
+        _template = std::make_shared<CCBTemplate>();
+        _templatePath = pPath;
+    }
+
+    _data = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(pPath));
+    _bytes = _data->getBytes();
+}
+
+Node* CCBReader::readLoadedNodeGraph(Ref *pOwner, const Size &parentSize)
+{
     _owner = pOwner;
     CC_SAFE_RETAIN(_owner);
 
@@ -317,6 +382,11 @@ Node* CCBReader::readFileWithCleanUp(bool bCleanUp, CCBAnimationManagerMapPtr am
 
     Node *pNode = readNodeGraph(nullptr);
 
+    if (pNode && !_replaying && !_templatePath.empty())
+    {
+        __ccbTemplates[_templatePath] = _template;
+    }
+
     _animationManagers->insert(pNode, _animationManager);
 
     if (bCleanUp)
@@ -328,10 +398,17 @@ Node* CCBReader::readFileWithCleanUp(bool bCleanUp, CCBAnimationManagerMapPtr am
 }
 
 bool CCBReader::readStringCache() {
-    int numStrings = this->readInt(false);
+    // A replayed template has its strings already
+    if (_replaying) {
+        return true;
+    }
+
+    std::vector<std::string>& strings = _template ? _template->strings : _stringCache;
+
+    int numStrings = this->decodeInt(false);
 
     for(int i = 0; i < numStrings; i++) {
-        this->_stringCache.push_back(this->readUTF8());
+        strings.push_back(this->decodeUTF8());
     }
 
     return true;
@@ -339,17 +416,20 @@ bool CCBReader::readStringCache() {
 
 bool CCBReader::readHeader()
 {
-    /* If no bytes loaded, don't crash about it. */
-    if(this->_bytes == nullptr) {
-        return false;
-    }
+    /* A replayed template was checked when it was recorded. */
+    if(!_replaying) {
+        /* If no bytes loaded, don't crash about it. */
+        if(this->_bytes == nullptr) {
+            return false;
+        }
 
-    /* Read magic bytes */
-    int magicBytes = *((int*)(this->_bytes + this->_currentByte));
-    this->_currentByte += 4;
+        /* Read magic bytes */
+        int magicBytes = *((int*)(this->_bytes + this->_currentByte));
+        this->_currentByte += 4;
 
-    if(CC_SWAP_INT32_BIG_TO_HOST(magicBytes) != (*reinterpret_cast<const int*>("ccbi"))) {
-        return false; 
+        if(CC_SWAP_INT32_BIG_TO_HOST(magicBytes) != (*reinterpret_cast<const int*>("ccbi"))) {
+            return false; 
+        }
     }
 
     /* Read version. */
@@ -367,6 +447,22 @@ bool CCBReader::readHeader()
 }
 
 unsigned char CCBReader::readByte()
+{
+    if (_replaying)
+    {
+        CCASSERT(_replayIndex < _template->values.size(), "read past the end of the ccbi template");
+        return (unsigned char)_template->values[_replayIndex++];
+    }
+
+    unsigned char byte = decodeByte();
+    if (_template)
+    {
+        _template->values.push_back(byte);
+    }
+    return byte;
+}
+
+unsigned char CCBReader::decodeByte()
 {
     unsigned char byte = this->_bytes[this->_currentByte];
     this->_currentByte++;
@@ -379,11 +475,28 @@ bool CCBReader::readBool()
 }
 
 std::string CCBReader::readUTF8()
+{
+    if (_replaying)
+    {
+        CCASSERT(_replayIndex < _template->values.size(), "read past the end of the ccbi template");
+        return _template->strings[_template->values[_replayIndex++]];
+    }
+
+    std::string ret = decodeUTF8();
+    if (_template)
+    {
+        _template->values.push_back((int)_template->strings.size());
+        _template->strings.push_back(ret);
+    }
+    return ret;
+}
+
+std::string CCBReader::decodeUTF8()
 {
     std::string ret;
 
-    int b0 = this->readByte();
-    int b1 = this->readByte();
+    int b0 = this->decodeByte();
+    int b1 = this->decodeByte();
 
     int numBytes = b0 << 8 | b1;
 
@@ -425,6 +538,21 @@ void CCBReader::alignBits() {
 }
 
 int CCBReader::readInt(bool pSigned) {
+    if (_replaying)
+    {
+        CCASSERT(_replayIndex < _template->values.size(), "read past the end of the ccbi template");
+        return _template->values[_replayIndex++];
+    }
+
+    int num = decodeInt(pSigned);
+    if (_template)
+    {
+        _template->values.push_back(num);
+    }
+    return num;
+}
+
+int CCBReader::decodeInt(bool pSigned) {
     // Read encoded int
     int numBits = 0;
     while(!this->getBit()) {
@@ -459,7 +587,28 @@ int CCBReader::readInt(bool pSigned) {
 
 float CCBReader::readFloat()
 {
-    FloatType type = static_cast<FloatType>(this->readByte());
+    float f;
+
+    if (_replaying)
+    {
+        CCASSERT(_replayIndex < _template->values.size(), "read past the end of the ccbi template");
+        memcpy(&f, &_template->values[_replayIndex++], sizeof(float));
+        return f;
+    }
+
+    f = decodeFloat();
+    if (_template)
+    {
+        int bits;
+        memcpy(&bits, &f, sizeof(float));
+        _template->values.push_back(bits);
+    }
+    return f;
+}
+
+float CCBReader::decodeFloat()
+{
+    FloatType type = static_cast<FloatType>(this->decodeByte());
     
     switch (type)
     {
@@ -472,7 +621,7 @@ float CCBReader::readFloat()
         case FloatType::_05:
             return 0.5f;
         case FloatType::INTEGER:
-            return (float)this->readInt(true);
+            return (float)this->decodeInt(true);
         default:
             {
                 /* using a memcpy since the compiler isn't
@@ -503,7 +652,7 @@ float CCBReader::readFloat()
 std::string CCBReader::readCachedString()
 {
     int n = this->readInt(false);
-    return this->_stringCache[n];
+    return _template ? _template->strings[n] : this->_stringCache[n];
 }
 
 Node * CCBReader::readNodeGraph(Node * pParent)
@@ -1083,4 +1232,23 @@ void CCBReader::setResolutionScale(float scale)
     __ccbResolutionScale = scale;
 }
 
+void CCBReader::setTemplateCacheEnabled(bool enabled)
+{
+    __ccbTemplateCacheEnabled = enabled;
+    if (!enabled)
+    {
+        purgeTemplateCache();
+    }
+}
+
+bool CCBReader::isTemplateCacheEnabled()
+{
+    return __ccbTemplateCacheEnabled;
+}
+
+void CCBReader::purgeTemplateCache()
+{
+    __ccbTemplates.clear();
+}
+
 };
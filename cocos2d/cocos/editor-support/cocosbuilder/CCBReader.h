@@ -60,6 +60,7 @@ class CCBMemberVariableAssigner;
 class CCBSelectorResolver;
 class CCBAnimationManager;
 class CCBKeyframe;
+class CCBTemplate;
 
 /**
  * @brief Parse CCBI file which is generated by CocosBuilder
@@ -339,6 +340,22 @@ public:
      */
     static float getResolutionScale();
     static void setResolutionScale(float scale);
+    /**
+     * Whether the ccbi files read by readNodeGraphFromFile(), and the sub ccb files they embed, are decoded once.
+     * The first read of a file records every value decoded from it; the next reads replay those values through the
+     * node loaders instead of decoding the bytes again. True by default.
+     * Disable it when a custom NodeLoader reads a different sequence of values for the same file.
+     * @js NA
+     * @lua NA
+     */
+    static void setTemplateCacheEnabled(bool enabled);
+    static bool isTemplateCacheEnabled();
+    /**
+     * Drop the recorded ccbi files, for instance after replacing them on disk
+     * @js NA
+     * @lua NA
+     */
+    static void purgeTemplateCache();
     /**
      * @js NA
      * @lua NA
@@ -362,6 +379,16 @@ private:
     bool getBit();
     void alignBits();
 
+    /* The decoding of the values of the byte stream, readInt() and the others replay or record what they return. */
+    int decodeInt(bool pSigned);
+    unsigned char decodeByte();
+    float decodeFloat();
+    std::string decodeUTF8();
+
+    /* Prepare to read the ccbi file at pPath, from its template if it is cached. */
+    void loadFile(const std::string& pPath);
+    cocos2d::Node* readLoadedNodeGraph(cocos2d::Ref *pOwner, const cocos2d::Size &parentSize);
+
     bool init();
     
     friend class NodeLoader;
@@ -371,7 +398,12 @@ private:
     unsigned char *_bytes;
     int _currentByte;
     int _currentBit;
-    
+
+    std::shared_ptr<CCBTemplate> _template;     // the template being recorded or replayed, if any
+    std::string _templatePath;                  // where the template being recorded is cached
+    bool _replaying;
+    size_t _replayIndex;
+
     std::vector<std::string> _stringCache;
     std::set<std::string> _loadedSpriteSheets;
     
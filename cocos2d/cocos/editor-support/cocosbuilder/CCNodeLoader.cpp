@@ -927,17 +927,12 @@ Node * NodeLoader::parsePropTypeCCBFile(Node * pNode, Node * pParent, CCBReader
     // Load sub file
     std::string path = FileUtils::getInstance()->fullPathForFilename(ccbFileName.c_str());
 
-    auto dataPtr = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(path));
-    
     CCBReader * reader = new CCBReader(pCCBReader);
     reader->autorelease();
     reader->getAnimationManager()->setRootContainerSize(pParent->getContentSize());
     
     
-    reader->_data = dataPtr;
-    reader->_bytes = dataPtr->getBytes();
-    reader->_currentByte = 0;
-    reader->_currentBit = 0;
+    reader->loadFile(path);
     CC_SAFE_RETAIN(pCCBReader->_owner);
     reader->_owner = pCCBReader->_owner;
     
@@ -87,7 +87,12 @@ Armature::Armature()
     , _batchNode(nullptr)
     , _parentBone(nullptr)
     , _armatureTransformDirty(true)
+    , _poseDelta(0)
     , _animation(nullptr)
+    , _skinBatchingEnabled(true)
+    , _skinQuadsCount(0)
+    , _skinQuadsFlushed(0)
+    , _skinCommandsCount(0)
 {
 }
 
@@ -162,7 +167,8 @@ bool Armature::init(const std::string& name)
                 while (0);
             }
 
-            update(0);
+            _animation->update(0);
+            evaluatePose();
             updateOffsetPoint();
         }
         else
@@ -370,8 +376,33 @@ void Armature::update(float dt)
 {
     _animation->update(dt);
 
+    _poseDelta = dt;
+    if (PoseBatch::getInstance()->addJob(this, this))
+        return;
+
+    evaluatePose();
+}
+
+bool Armature::isPoseThreadSafe() const
+{
+#if ENABLE_PHYSICS_BOX2D_DETECT || ENABLE_PHYSICS_CHIPMUNK_DETECT
+    return false;
+#else
+    // particles and child armatures are updated by their bone, and can touch the scheduler or the scene graph
+    for (const auto &element : _boneDic)
+    {
+        DisplayType type = element.second->getDisplayRenderNodeType();
+        if (type == CS_DISPLAY_PARTICLE || type == CS_DISPLAY_ARMATURE)
+            return false;
+    }
+    return true;
+#endif
+}
+
+void Armature::evaluatePose()
+{
     for(const auto &bone : _topBoneList) {
-        bone->update(dt);
+        bone->update(_poseDelta);
     }
 
     _armatureTransformDirty = false;
@@ -384,6 +415,25 @@ void Armature::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool t
 //        CC_NODE_DRAW_SETUP();
     }
 
+    if (_skinBatchingEnabled)
+    {
+        // sized before the commands keep pointers to the quads
+        ssize_t skinCount = getSkinCount();
+        if ((ssize_t)_skinQuads.size() < skinCount)
+        {
+            _skinQuads.resize(skinCount);
+            _quadSkins.resize(skinCount);
+            _skinQuadCommands.resize(skinCount);
+        }
+
+        _skinQuadsCount = 0;
+        _skinQuadsFlushed = 0;
+        _skinCommandsCount = 0;
+
+        batchSkins(this, renderer, transform, transformUpdated);
+        flushSkinQuads(renderer, transform);
+        return;
+    }
 
     for (auto& object : _children)
     {
@@ -431,6 +481,131 @@ void Armature::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool t
     }
 }
 
+ssize_t Armature::getSkinCount() const
+{
+    ssize_t count = 0;
+
+    for (auto& object : _children)
+    {
+        if (Bone *bone = dynamic_cast<Bone *>(object))
+        {
+            Node *node = bone->getDisplayRenderNode();
+
+            if (nullptr == node)
+                continue;
+
+            switch (bone->getDisplayRenderNodeType())
+            {
+            case CS_DISPLAY_SPRITE:
+                count++;
+                break;
+            case CS_DISPLAY_ARMATURE:
+                count += static_cast<Armature *>(node)->getSkinCount();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    return count;
+}
+
+void Armature::batchSkins(Armature *armature, cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
+{
+    for (auto& object : armature->_children)
+    {
+        if (Bone *bone = dynamic_cast<Bone *>(object))
+        {
+            Node *node = bone->getDisplayRenderNode();
+
+            if (nullptr == node)
+                continue;
+
+            switch (bone->getDisplayRenderNodeType())
+            {
+            case CS_DISPLAY_SPRITE:
+            {
+                Skin *skin = static_cast<Skin *>(node);
+                skin->updateTransform();
+
+                bool blendDirty = bone->isBlendDirty();
+
+                if (blendDirty)
+                {
+                    skin->setBlendFunc(bone->getBlendFunc());
+                }
+
+                // the quad of an invisible skin is empty
+                if (skin->isVisible())
+                {
+                    _skinQuads[_skinQuadsCount] = skin->getQuad();
+                    _quadSkins[_skinQuadsCount] = skin;
+                    _skinQuadsCount++;
+                }
+            }
+            break;
+            case CS_DISPLAY_ARMATURE:
+            {
+                // the skins of a child armature are in the space of this armature too
+                Armature *childArmature = static_cast<Armature *>(node);
+                if (childArmature->isSkinBatchingEnabled())
+                {
+                    batchSkins(childArmature, renderer, transform, transformUpdated);
+                }
+                else
+                {
+                    flushSkinQuads(renderer, transform);
+                    node->draw(renderer, transform, transformUpdated);
+                }
+            }
+            break;
+            default:
+            {
+                flushSkinQuads(renderer, transform);
+                node->visit(renderer, transform, transformUpdated);
+            }
+            break;
+            }
+        }
+        else if(Node *node = dynamic_cast<Node *>(object))
+        {
+            flushSkinQuads(renderer, transform);
+            node->visit(renderer, transform, transformUpdated);
+        }
+    }
+}
+
+void Armature::flushSkinQuads(cocos2d::Renderer *renderer, const kmMat4 &transform)
+{
+    ssize_t runStart = _skinQuadsFlushed;
+
+    for (ssize_t i = runStart + 1; i <= _skinQuadsCount; i++)
+    {
+        Skin *runSkin = _quadSkins[runStart];
+        Skin *skin = i < _skinQuadsCount ? _quadSkins[i] : nullptr;
+
+        // a run of quads with the same material ends
+        if (!skin
+            || skin->getTexture() != runSkin->getTexture()
+            || skin->getShaderProgram() != runSkin->getShaderProgram()
+            || skin->getBlendFunc().src != runSkin->getBlendFunc().src
+            || skin->getBlendFunc().dst != runSkin->getBlendFunc().dst
+            || skin->getGlobalZOrder() != runSkin->getGlobalZOrder()
+            || i - runStart == Renderer::VBO_SIZE - 1)
+        {
+            QuadCommand &command = _skinQuadCommands[_skinCommandsCount++];
+            command.init(runSkin->getGlobalZOrder(), runSkin->getTexture()->getName(), runSkin->getShaderProgram(), runSkin->getBlendFunc(),
+                &_skinQuads[runStart], i - runStart, transform);
+            renderer->addCommand(&command);
+
+            runStart = i;
+        }
+    }
+
+    _skinQuadsFlushed = _skinQuadsCount;
+}
+
 void Armature::onEnter()
 {
     Node::onEnter();
@@ -31,6 +31,10 @@ THE SOFTWARE.
 #include "cocostudio/CCArmatureAnimation.h"
 #include "cocostudio/CCSpriteFrameCacheHelper.h"
 #include "cocostudio/CCArmatureDataManager.h"
+#include "CCPoseBatch.h"
+#include "renderer/CCQuadCommand.h"
+
+#include <vector>
 
 class b2Body;
 struct cpBody;
@@ -66,7 +70,11 @@ CC_DEPRECATED_ATTRIBUTE typedef Armature CCArmature;
 CC_DEPRECATED_ATTRIBUTE typedef ArmatureDataManager CCArmatureDataManager;
 CC_DEPRECATED_ATTRIBUTE typedef cocos2d::tweenfunc::TweenType CCTweenType;
 
-class  Armature : public cocos2d::Node, public cocos2d::BlendProtocol
+/**
+ * When the cocos2d::PoseBatch is enabled, update() advances the animation and fires its events right away,
+ * but the transforms of the bones are computed with the other armatures at the end of the update phase.
+ */
+class  Armature : public cocos2d::Node, public cocos2d::BlendProtocol, public cocos2d::PoseJob
 {
 
 public:
@@ -160,6 +168,19 @@ public:
     virtual void draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated) override;
     virtual void update(float dt) override;
 
+    /**
+     * Armatures showing particles or other armatures, or using the physics detection, are evaluated on the main thread
+     * @js NA
+     * @lua NA
+     */
+    virtual bool isPoseThreadSafe() const override;
+    /**
+     * Computes the transforms of the bones and of their displays
+     * @js NA
+     * @lua NA
+     */
+    virtual void evaluatePose() override;
+
     virtual void onEnter() override;
     virtual void onExit() override; 
 
@@ -212,6 +233,14 @@ public:
     virtual void setBatchNode(BatchNode *batchNode) { _batchNode = batchNode; }
     virtual BatchNode *getBatchNode() const { return _batchNode; }
 
+    /**
+     * Whether the skins of the armature and of its child armatures are copied into one quad buffer and drawn by one
+     * QuadCommand per run of skins with the same texture, shader, blending and global z order. True by default.
+     * Disable it for armatures whose skins or child armatures override draw().
+     */
+    virtual void setSkinBatchingEnabled(bool enabled) { _skinBatchingEnabled = enabled; }
+    virtual bool isSkinBatchingEnabled() const { return _skinBatchingEnabled; }
+
 #if ENABLE_PHYSICS_BOX2D_DETECT
     virtual b2Fixture *getShapeList();
     /**
@@ -251,6 +280,25 @@ protected:
      */
     Bone *createBone(const std::string& boneName );
 
+    /*
+     * The number of skins of the armature and of its child armatures, the most quads batchSkins() can write
+     * @js NA
+     * @lua NA
+     */
+    ssize_t getSkinCount() const;
+    /*
+     * Copy the quads of the skins of armature to _skinQuads, and visit the other displays in order
+     * @js NA
+     * @lua NA
+     */
+    void batchSkins(Armature *armature, cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated);
+    /*
+     * Add the QuadCommands of the quads copied since the last flush
+     * @js NA
+     * @lua NA
+     */
+    void flushSkinQuads(cocos2d::Renderer *renderer, const kmMat4 &transform);
+
 protected:
     ArmatureData *_armatureData;
 
@@ -261,6 +309,7 @@ protected:
     float _version;
 
     mutable bool _armatureTransformDirty;
+    float _poseDelta;
 
     cocos2d::Map<std::string, Bone*> _boneDic;                    //! The dictionary of the bones, include all bones in the armature, no matter it is the direct bone or the indirect bone. It is different from m_pChindren.
 
@@ -273,6 +322,14 @@ protected:
 
     ArmatureAnimation *_animation;
 
+    bool _skinBatchingEnabled;
+    std::vector<cocos2d::V3F_C4B_T2F_Quad> _skinQuads;      //! The quads of the skins drawn this frame, in draw order
+    std::vector<Skin *> _quadSkins;                         //! The skin of every quad in _skinQuads
+    std::vector<cocos2d::QuadCommand> _skinQuadCommands;    //! One per run of quads with the same material
+    ssize_t _skinQuadsCount;
+    ssize_t _skinQuadsFlushed;
+    size_t _skinCommandsCount;
+
 #if ENABLE_PHYSICS_BOX2D_DETECT
     b2Body *_body;
 #elif ENABLE_PHYSICS_CHIPMUNK_DETECT
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "CCDirector.h"
 #include "CCScheduler.h"
+#include "CCAutoreleasePool.h"
 
 #include "tinyxml2.h"
 
@@ -35,6 +36,10 @@ THE SOFTWARE.
 #include "cocostudio/CCArmatureDefine.h"
 #include "cocostudio/CCDatas.h"
 
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+
 using namespace cocos2d;
 
 
@@ -136,6 +141,137 @@ static const char *COLOR_INFO = "color";
 static const char *CONFIG_FILE_PATH = "config_file_path";
 static const char *CONTENT_SCALE = "content_scale";
 
+static const char *BINARY_EXTENSION = ".csab";
+
+
+/*
+ * Binary armature file (.csab), written by DataReaderHelper::bakeBinaryFile().
+ *
+ * Little endian, every field is 4 bytes. The header is followed by these sections, in this order:
+ * strings (zero terminated, padded to 4 bytes, offset 0 is the empty string), easing parameters (floats),
+ * then the record arrays: armatures, bones, displays, animations, movements, movement bones, frames,
+ * textures, contours, contour vertices and config files (string offsets).
+ * A record refers to its children as a range of the next array, so all the keyframes of a file
+ * are one flat array of BinaryFrame.
+ */
+static const char BINARY_MAGIC[4] = {'C', 'S', 'A', 'B'};
+static const uint32_t BINARY_VERSION = 1;
+
+struct BinaryHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t stringBytes;
+    uint32_t floatCount;
+    uint32_t armatureCount;
+    uint32_t boneCount;
+    uint32_t displayCount;
+    uint32_t animationCount;
+    uint32_t movementCount;
+    uint32_t movementBoneCount;
+    uint32_t frameCount;
+    uint32_t textureCount;
+    uint32_t contourCount;
+    uint32_t vertexCount;
+    uint32_t configFileCount;
+};
+
+struct BinaryRange
+{
+    uint32_t first;
+    uint32_t count;
+};
+
+struct BinaryNode
+{
+    float x, y;
+    float skewX, skewY;
+    float scaleX, scaleY;
+    float tweenRotate;
+    int32_t zOrder;
+    int32_t isUseColorInfo;
+    int32_t a, r, g, b;
+};
+
+struct BinaryArmature
+{
+    uint32_t name;
+    float dataVersion;
+    BinaryRange bones;
+};
+
+struct BinaryBone
+{
+    BinaryNode node;
+    uint32_t name;
+    uint32_t parentName;
+    BinaryRange displays;
+};
+
+struct BinaryDisplay
+{
+    int32_t displayType;
+    uint32_t displayName;
+    BinaryNode skinData;
+};
+
+struct BinaryAnimation
+{
+    uint32_t name;
+    BinaryRange movements;
+};
+
+struct BinaryMovement
+{
+    uint32_t name;
+    int32_t duration;
+    float scale;
+    int32_t durationTo;
+    int32_t durationTween;
+    int32_t loop;
+    int32_t tweenEasing;
+    BinaryRange movementBones;
+};
+
+struct BinaryMovementBone
+{
+    uint32_t name;
+    float delay;
+    float scale;
+    float duration;
+    BinaryRange frames;
+};
+
+struct BinaryFrame
+{
+    BinaryNode node;
+    int32_t frameID;
+    int32_t duration;
+    int32_t tweenEasing;
+    BinaryRange easingParams;
+    int32_t isTween;
+    int32_t displayIndex;
+    uint32_t blendSrc;
+    uint32_t blendDst;
+    uint32_t strEvent;
+    uint32_t strMovement;
+    uint32_t strSound;
+    uint32_t strSoundEffect;
+};
+
+struct BinaryTexture
+{
+    uint32_t name;
+    float width, height;
+    float pivotX, pivotY;
+    BinaryRange contours;
+};
+
+struct BinaryVertex
+{
+    float x, y;
+};
+
 namespace cocostudio {
 
 
@@ -146,6 +282,17 @@ std::vector<std::string> DataReaderHelper::_configFileList;
 
 DataReaderHelper *DataReaderHelper::_dataReaderHelper = nullptr;
 
+static std::string getBinaryFileContent(const std::string& fullPath)
+{
+    // getStringFromFile() stops at the first zero byte
+    Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
+    if (data.isNull())
+    {
+        return "";
+    }
+    return std::string((const char *)data.getBytes(), data.getSize());
+}
+
 
 
 //! Async load
@@ -153,6 +300,9 @@ void DataReaderHelper::loadData()
 {
     AsyncStruct *pAsyncStruct = nullptr;
 
+    // The data objects are created on this thread with new and handed over to the cocos thread,
+    // nothing is autoreleased here: draining a pool would release objects the cocos thread may be retaining.
+
     while (true)
     {
         std::queue<AsyncStruct *> *pQueue = _asyncStructQueue;
@@ -181,6 +331,7 @@ void DataReaderHelper::loadData()
         // generate data info
         DataInfo *pDataInfo = new DataInfo();
         pDataInfo->asyncStruct = pAsyncStruct;
+        pDataInfo->bakedData = nullptr;
         pDataInfo->filename = pAsyncStruct->filename;
         pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
 
@@ -192,6 +343,10 @@ void DataReaderHelper::loadData()
         {
             DataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
         }
+        else if(pAsyncStruct->configType == CocoStudio_Binary)
+        {
+            DataReaderHelper::addDataFromBinaryCache(pAsyncStruct->fileContent, pDataInfo);
+        }
 
         // put the image info into the queue
         _dataInfoMutex.lock();
@@ -294,11 +449,16 @@ void DataReaderHelper::addDataFromFile(const std::string& filePath)
 
     // Read content from file
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-    std::string contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+    std::string contentStr;
+    if (str != BINARY_EXTENSION)
+    {
+        contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+    }
 
     DataInfo dataInfo;
     dataInfo.filename = filePathStr;
     dataInfo.asyncStruct = nullptr;
+    dataInfo.bakedData = nullptr;
     dataInfo.baseFilePath = basefilePath;
     if (str == ".xml")
     {
@@ -308,6 +468,10 @@ void DataReaderHelper::addDataFromFile(const std::string& filePath)
     {
         DataReaderHelper::addDataFromJsonCache(contentStr, &dataInfo);
     }
+    else if(str == BINARY_EXTENSION)
+    {
+        DataReaderHelper::addDataFromBinaryCache(getBinaryFileContent(fullPath), &dataInfo);
+    }
 }
 
 void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const std::string& plistPath, const std::string& filePath, Ref *target, SEL_SCHEDULE selector)
@@ -391,9 +555,6 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
 
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
 
-    // XXX fileContent is being leaked
-    data->fileContent = FileUtils::getInstance()->getStringFromFile(fullPath);
-
     if (str == ".xml")
     {
         data->configType = DragonBone_XML;
@@ -402,6 +563,20 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
     {
         data->configType = CocoStudio_JSON;
     }
+    else if(str == BINARY_EXTENSION)
+    {
+        data->configType = CocoStudio_Binary;
+    }
+
+    // XXX fileContent is being leaked
+    if (data->configType == CocoStudio_Binary)
+    {
+        data->fileContent = getBinaryFileContent(fullPath);
+    }
+    else
+    {
+        data->fileContent = FileUtils::getInstance()->getStringFromFile(fullPath);
+    }
 
 
     // add async struct into queue
@@ -448,6 +623,13 @@ void DataReaderHelper::addDataAsyncCallBack(float dt)
         }
 
 
+        // the loading thread kept its references to the added data, it is safe to drop them here
+        for (auto& data : pDataInfo->pendingReleases)
+        {
+            data->release();
+        }
+        pDataInfo->pendingReleases.clear();
+
         Ref* target = pAsyncStruct->target;
         SEL_SCHEDULE selector = pAsyncStruct->selector;
 
@@ -472,6 +654,18 @@ void DataReaderHelper::addDataAsyncCallBack(float dt)
 }
 
 
+void DataReaderHelper::releaseAddedData(Ref *data, DataInfo *dataInfo)
+{
+    if (dataInfo && dataInfo->asyncStruct)
+    {
+        dataInfo->pendingReleases.push_back(data);
+    }
+    else
+    {
+        data->release();
+    }
+}
+
 void DataReaderHelper::removeConfigFile(const std::string& configFile)
 {
     std::vector<std::string>::iterator it = _configFileList.end();
@@ -516,7 +710,11 @@ void DataReaderHelper::addDataFromCache(const std::string& pFileContent, DataInf
             _dataReaderHelper->_addDataMutex.lock();
         }
         ArmatureDataManager::getInstance()->addArmatureData(armatureData->name.c_str(), armatureData, dataInfo->filename.c_str());
-        armatureData->release();
+        if (dataInfo->bakedData)
+        {
+            dataInfo->bakedData->armatures.pushBack(armatureData);
+        }
+        releaseAddedData(armatureData, dataInfo);
         if (dataInfo->asyncStruct)
         {
             _dataReaderHelper->_addDataMutex.unlock();
@@ -539,7 +737,11 @@ void DataReaderHelper::addDataFromCache(const std::string& pFileContent, DataInf
             _dataReaderHelper->_addDataMutex.lock();
         }
         ArmatureDataManager::getInstance()->addAnimationData(animationData->name.c_str(), animationData, dataInfo->filename.c_str());
-        animationData->release();
+        if (dataInfo->bakedData)
+        {
+            dataInfo->bakedData->animations.pushBack(animationData);
+        }
+        releaseAddedData(animationData, dataInfo);
         if (dataInfo->asyncStruct)
         {
             _dataReaderHelper->_addDataMutex.unlock();
@@ -562,7 +764,11 @@ void DataReaderHelper::addDataFromCache(const std::string& pFileContent, DataInf
             _dataReaderHelper->_addDataMutex.lock();
         }
         ArmatureDataManager::getInstance()->addTextureData(textureData->name.c_str(), textureData, dataInfo->filename.c_str());
-        textureData->release();
+        if (dataInfo->bakedData)
+        {
+            dataInfo->bakedData->textures.pushBack(textureData);
+        }
+        releaseAddedData(textureData, dataInfo);
         if (dataInfo->asyncStruct)
         {
             _dataReaderHelper->_addDataMutex.unlock();
@@ -1205,7 +1411,11 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
             _dataReaderHelper->_addDataMutex.lock();
         }
         ArmatureDataManager::getInstance()->addArmatureData(armatureData->name.c_str(), armatureData);
-        armatureData->release();
+        if (dataInfo->bakedData)
+        {
+            dataInfo->bakedData->armatures.pushBack(armatureData);
+        }
+        releaseAddedData(armatureData, dataInfo);
         if (dataInfo->asyncStruct)
         {
             _dataReaderHelper->_addDataMutex.unlock();
@@ -1224,7 +1434,11 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
             _dataReaderHelper->_addDataMutex.lock();
         }
         ArmatureDataManager::getInstance()->addAnimationData(animationData->name.c_str(), animationData);
-        animationData->release();
+        if (dataInfo->bakedData)
+        {
+            dataInfo->bakedData->animations.pushBack(animationData);
+        }
+        releaseAddedData(animationData, dataInfo);
         if (dataInfo->asyncStruct)
         {
             _dataReaderHelper->_addDataMutex.unlock();
@@ -1243,7 +1457,11 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
             _dataReaderHelper->_addDataMutex.lock();
         }
         ArmatureDataManager::getInstance()->addTextureData(textureData->name.c_str(), textureData);
-        textureData->release();
+        if (dataInfo->bakedData)
+        {
+            dataInfo->bakedData->textures.pushBack(textureData);
+        }
+        releaseAddedData(textureData, dataInfo);
         if (dataInfo->asyncStruct)
         {
             _dataReaderHelper->_addDataMutex.unlock();
@@ -1252,7 +1470,19 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
 
     // Auto load sprite file
     bool autoLoad = dataInfo->asyncStruct == nullptr ? ArmatureDataManager::getInstance()->isAutoLoadSpriteFile() : dataInfo->asyncStruct->autoLoadSpriteFile;
-    if (autoLoad)
+    if (dataInfo->bakedData)
+    {
+        length = DICTOOL->getArrayCount_json(json, CONFIG_FILE_PATH);
+        for (int i = 0; i < length; i++)
+        {
+            const char *path = DICTOOL->getStringValueFromArray_json(json, CONFIG_FILE_PATH, i);
+            if (path != nullptr)
+            {
+                dataInfo->bakedData->configFiles.push_back(path);
+            }
+        }
+    }
+    else if (autoLoad)
     {
         length =  DICTOOL->getArrayCount_json(json, CONFIG_FILE_PATH); // json[CONFIG_FILE_PATH].IsNull() ? 0 : json[CONFIG_FILE_PATH].Size();
         for (int i = 0; i < length; i++)
@@ -1582,6 +1812,7 @@ FrameData *DataReaderHelper::decodeFrame(const rapidjson::Value& json, DataInfo
     int length = DICTOOL->getArrayCount_json(json, A_EASING_PARAM);
     if (length != 0)
     {
+        frameData->easingParamNumber = length;
         frameData->easingParams = new float[length];
         
         for (int i = 0; i < length; i++)
@@ -1687,4 +1918,733 @@ void DataReaderHelper::decodeNode(BaseData *node, const rapidjson::Value& json,
 
 }
 
+
+namespace {
+
+//! Collects the decoded data into the flat record arrays of the binary format
+class BinaryWriter
+{
+public:
+    BinaryWriter()
+    {
+        _strings.push_back('\0');
+    }
+
+    void addArmature(ArmatureData *armatureData)
+    {
+        BinaryArmature armature;
+        armature.name = addString(armatureData->name);
+        armature.dataVersion = armatureData->dataVersion;
+        armature.bones.first = (uint32_t)_bones.size();
+        armature.bones.count = (uint32_t)armatureData->boneDataDic.size();
+        _armatures.push_back(armature);
+
+        for (auto& element : armatureData->boneDataDic)
+        {
+            BoneData *boneData = element.second;
+
+            BinaryBone bone;
+            writeNode(boneData, bone.node);
+            bone.name = addString(boneData->name);
+            bone.parentName = addString(boneData->parentName);
+            bone.displays.first = (uint32_t)_displays.size();
+            bone.displays.count = (uint32_t)boneData->displayDataList.size();
+            _bones.push_back(bone);
+
+            for (auto& displayData : boneData->displayDataList)
+            {
+                BinaryDisplay display;
+                memset(&display, 0, sizeof(display));
+                display.displayType = displayData->displayType;
+                display.displayName = addString(displayData->displayName);
+                if (SpriteDisplayData *spriteDisplayData = dynamic_cast<SpriteDisplayData *>(displayData))
+                {
+                    writeNode(&spriteDisplayData->skinData, display.skinData);
+                }
+                _displays.push_back(display);
+            }
+        }
+    }
+
+    void addAnimation(AnimationData *animationData)
+    {
+        BinaryAnimation animation;
+        animation.name = addString(animationData->name);
+        animation.movements.first = (uint32_t)_movements.size();
+        animation.movements.count = 0;
+
+        // the movement names keep the order of the file
+        for (auto& movementName : animationData->movementNames)
+        {
+            MovementData *movementData = animationData->getMovement(movementName);
+            if (!movementData)
+            {
+                continue;
+            }
+            ++animation.movements.count;
+
+            BinaryMovement movement;
+            movement.name = addString(movementData->name);
+            movement.duration = movementData->duration;
+            movement.scale = movementData->scale;
+            movement.durationTo = movementData->durationTo;
+            movement.durationTween = movementData->durationTween;
+            movement.loop = movementData->loop ? 1 : 0;
+            movement.tweenEasing = movementData->tweenEasing;
+            movement.movementBones.first = (uint32_t)_movementBones.size();
+            movement.movementBones.count = (uint32_t)movementData->movBoneDataDic.size();
+            _movements.push_back(movement);
+
+            for (auto& element : movementData->movBoneDataDic)
+            {
+                MovementBoneData *movementBoneData = element.second;
+
+                BinaryMovementBone movementBone;
+                movementBone.name = addString(movementBoneData->name);
+                movementBone.delay = movementBoneData->delay;
+                movementBone.scale = movementBoneData->scale;
+                movementBone.duration = movementBoneData->duration;
+                movementBone.frames.first = (uint32_t)_frames.size();
+                movementBone.frames.count = (uint32_t)movementBoneData->frameList.size();
+                _movementBones.push_back(movementBone);
+
+                for (auto& frameData : movementBoneData->frameList)
+                {
+                    BinaryFrame frame;
+                    writeNode(frameData, frame.node);
+                    frame.frameID = frameData->frameID;
+                    frame.duration = frameData->duration;
+                    frame.tweenEasing = frameData->tweenEasing;
+                    frame.easingParams.first = (uint32_t)_floats.size();
+                    frame.easingParams.count = frameData->easingParams ? (uint32_t)frameData->easingParamNumber : 0;
+                    _floats.insert(_floats.end(), frameData->easingParams, frameData->easingParams + frame.easingParams.count);
+                    frame.isTween = frameData->isTween ? 1 : 0;
+                    frame.displayIndex = frameData->displayIndex;
+                    frame.blendSrc = frameData->blendFunc.src;
+                    frame.blendDst = frameData->blendFunc.dst;
+                    frame.strEvent = addString(frameData->strEvent);
+                    frame.strMovement = addString(frameData->strMovement);
+                    frame.strSound = addString(frameData->strSound);
+                    frame.strSoundEffect = addString(frameData->strSoundEffect);
+                    _frames.push_back(frame);
+                }
+            }
+        }
+
+        _animations.push_back(animation);
+    }
+
+    void addTexture(TextureData *textureData)
+    {
+        BinaryTexture texture;
+        texture.name = addString(textureData->name);
+        texture.width = textureData->width;
+        texture.height = textureData->height;
+        texture.pivotX = textureData->pivotX;
+        texture.pivotY = textureData->pivotY;
+        texture.contours.first = (uint32_t)_contours.size();
+        texture.contours.count = (uint32_t)textureData->contourDataList.size();
+        _textures.push_back(texture);
+
+        for (auto& contourData : textureData->contourDataList)
+        {
+            BinaryRange contour;
+            contour.first = (uint32_t)_vertices.size();
+            contour.count = (uint32_t)contourData->vertexList.size();
+            _contours.push_back(contour);
+
+            for (auto& point : contourData->vertexList)
+            {
+                BinaryVertex vertex = {point.x, point.y};
+                _vertices.push_back(vertex);
+            }
+        }
+    }
+
+    void addConfigFile(const std::string& path)
+    {
+        _configFiles.push_back(addString(path));
+    }
+
+    bool save(const std::string& path)
+    {
+        while (_strings.size() % 4 != 0)
+        {
+            _strings.push_back('\0');
+        }
+
+        BinaryHeader header;
+        memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+        header.version = BINARY_VERSION;
+        header.stringBytes = (uint32_t)_strings.size();
+        header.floatCount = (uint32_t)_floats.size();
+        header.armatureCount = (uint32_t)_armatures.size();
+        header.boneCount = (uint32_t)_bones.size();
+        header.displayCount = (uint32_t)_displays.size();
+        header.animationCount = (uint32_t)_animations.size();
+        header.movementCount = (uint32_t)_movements.size();
+        header.movementBoneCount = (uint32_t)_movementBones.size();
+        header.frameCount = (uint32_t)_frames.size();
+        header.textureCount = (uint32_t)_textures.size();
+        header.contourCount = (uint32_t)_contours.size();
+        header.vertexCount = (uint32_t)_vertices.size();
+        header.configFileCount = (uint32_t)_configFiles.size();
+
+        FILE *file = fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+            && writeArray(file, _strings)
+            && writeArray(file, _floats)
+            && writeArray(file, _armatures)
+            && writeArray(file, _bones)
+            && writeArray(file, _displays)
+            && writeArray(file, _animations)
+            && writeArray(file, _movements)
+            && writeArray(file, _movementBones)
+            && writeArray(file, _frames)
+            && writeArray(file, _textures)
+            && writeArray(file, _contours)
+            && writeArray(file, _vertices)
+            && writeArray(file, _configFiles);
+
+        return fclose(file) == 0 && ok;
+    }
+
+private:
+    uint32_t addString(const std::string& str)
+    {
+        if (str.empty())
+        {
+            return 0;
+        }
+
+        auto iter = _stringOffsets.find(str);
+        if (iter != _stringOffsets.end())
+        {
+            return iter->second;
+        }
+
+        uint32_t offset = (uint32_t)_strings.size();
+        _strings.insert(_strings.end(), str.begin(), str.end());
+        _strings.push_back('\0');
+        _stringOffsets[str] = offset;
+        return offset;
+    }
+
+    static void writeNode(const BaseData *data, BinaryNode& node)
+    {
+        node.x = data->x;
+        node.y = data->y;
+        node.skewX = data->skewX;
+        node.skewY = data->skewY;
+        node.scaleX = data->scaleX;
+        node.scaleY = data->scaleY;
+        node.tweenRotate = data->tweenRotate;
+        node.zOrder = data->zOrder;
+        node.isUseColorInfo = data->isUseColorInfo ? 1 : 0;
+        node.a = data->a;
+        node.r = data->r;
+        node.g = data->g;
+        node.b = data->b;
+    }
+
+    template <typename T>
+    static bool writeArray(FILE *file, const std::vector<T>& array)
+    {
+        return array.empty() || fwrite(array.data(), sizeof(T), array.size(), file) == array.size();
+    }
+
+    std::vector<char> _strings;
+    std::unordered_map<std::string, uint32_t> _stringOffsets;
+    std::vector<float> _floats;
+    std::vector<BinaryArmature> _armatures;
+    std::vector<BinaryBone> _bones;
+    std::vector<BinaryDisplay> _displays;
+    std::vector<BinaryAnimation> _animations;
+    std::vector<BinaryMovement> _movements;
+    std::vector<BinaryMovementBone> _movementBones;
+    std::vector<BinaryFrame> _frames;
+    std::vector<BinaryTexture> _textures;
+    std::vector<BinaryRange> _contours;
+    std::vector<BinaryVertex> _vertices;
+    std::vector<uint32_t> _configFiles;
+};
+
+//! The sections of a binary armature file, read in place
+class BinaryReader
+{
+public:
+    bool init(const char *bytes, size_t size)
+    {
+        if (size < sizeof(BinaryHeader))
+        {
+            return false;
+        }
+
+        _header = reinterpret_cast<const BinaryHeader *>(bytes);
+        if (memcmp(_header->magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 || _header->version != BINARY_VERSION
+            || _header->stringBytes == 0 || _header->stringBytes % 4 != 0)
+        {
+            return false;
+        }
+
+        size_t offset = sizeof(BinaryHeader);
+        _strings = bytes + offset;
+        offset += _header->stringBytes;
+
+        if (!getSection(bytes, size, offset, _header->floatCount, _floats)
+            || !getSection(bytes, size, offset, _header->armatureCount, _armatures)
+            || !getSection(bytes, size, offset, _header->boneCount, _bones)
+            || !getSection(bytes, size, offset, _header->displayCount, _displays)
+            || !getSection(bytes, size, offset, _header->animationCount, _animations)
+            || !getSection(bytes, size, offset, _header->movementCount, _movements)
+            || !getSection(bytes, size, offset, _header->movementBoneCount, _movementBones)
+            || !getSection(bytes, size, offset, _header->frameCount, _frames)
+            || !getSection(bytes, size, offset, _header->textureCount, _textures)
+            || !getSection(bytes, size, offset, _header->contourCount, _contours)
+            || !getSection(bytes, size, offset, _header->vertexCount, _vertices)
+            || !getSection(bytes, size, offset, _header->configFileCount, _configFiles)
+            || offset != size
+            || _strings[_header->stringBytes - 1] != '\0')
+        {
+            return false;
+        }
+
+        return validate();
+    }
+
+    const BinaryHeader *_header;
+    const char *_strings;
+    const float *_floats;
+    const BinaryArmature *_armatures;
+    const BinaryBone *_bones;
+    const BinaryDisplay *_displays;
+    const BinaryAnimation *_animations;
+    const BinaryMovement *_movements;
+    const BinaryMovementBone *_movementBones;
+    const BinaryFrame *_frames;
+    const BinaryTexture *_textures;
+    const BinaryRange *_contours;
+    const BinaryVertex *_vertices;
+    const uint32_t *_configFiles;
+
+    const char *getString(uint32_t offset) const
+    {
+        return _strings + offset;
+    }
+
+private:
+    template <typename T>
+    static bool getSection(const char *bytes, size_t size, size_t& offset, uint32_t count, const T *&section)
+    {
+        if ((size - offset) / sizeof(T) < count)
+        {
+            return false;
+        }
+        section = reinterpret_cast<const T *>(bytes + offset);
+        offset += count * sizeof(T);
+        return true;
+    }
+
+    static bool checkRange(const BinaryRange& range, uint32_t count)
+    {
+        return range.first <= count && range.count <= count - range.first;
+    }
+
+    bool checkString(uint32_t offset) const
+    {
+        return offset < _header->stringBytes;
+    }
+
+    //! Checks every reference once, so the data objects can be built without any further test
+    bool validate() const
+    {
+        for (uint32_t i = 0; i < _header->armatureCount; i++)
+        {
+            if (!checkString(_armatures[i].name) || !checkRange(_armatures[i].bones, _header->boneCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->boneCount; i++)
+        {
+            if (!checkString(_bones[i].name) || !checkString(_bones[i].parentName) || !checkRange(_bones[i].displays, _header->displayCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->displayCount; i++)
+        {
+            if (!checkString(_displays[i].displayName))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->animationCount; i++)
+        {
+            if (!checkString(_animations[i].name) || !checkRange(_animations[i].movements, _header->movementCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->movementCount; i++)
+        {
+            if (!checkString(_movements[i].name) || !checkRange(_movements[i].movementBones, _header->movementBoneCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->movementBoneCount; i++)
+        {
+            if (!checkString(_movementBones[i].name) || !checkRange(_movementBones[i].frames, _header->frameCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->frameCount; i++)
+        {
+            const BinaryFrame& frame = _frames[i];
+            if (!checkRange(frame.easingParams, _header->floatCount) || !checkString(frame.strEvent) || !checkString(frame.strMovement)
+                || !checkString(frame.strSound) || !checkString(frame.strSoundEffect))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->textureCount; i++)
+        {
+            if (!checkString(_textures[i].name) || !checkRange(_textures[i].contours, _header->contourCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->contourCount; i++)
+        {
+            if (!checkRange(_contours[i], _header->vertexCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < _header->configFileCount; i++)
+        {
+            if (!checkString(_configFiles[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+void readBinaryNode(BaseData *node, const BinaryNode& binary)
+{
+    node->x = binary.x * s_PositionReadScale;
+    node->y = binary.y * s_PositionReadScale;
+    node->skewX = binary.skewX;
+    node->skewY = binary.skewY;
+    node->scaleX = binary.scaleX;
+    node->scaleY = binary.scaleY;
+    node->tweenRotate = binary.tweenRotate;
+    node->zOrder = binary.zOrder;
+    node->isUseColorInfo = binary.isUseColorInfo != 0;
+    node->a = binary.a;
+    node->r = binary.r;
+    node->g = binary.g;
+    node->b = binary.b;
+}
+
+}
+
+bool DataReaderHelper::bakeBinaryFile(const std::string& filePath, const std::string& binaryPath)
+{
+    size_t startPos = filePath.find_last_of(".");
+    std::string str = startPos == std::string::npos ? "" : filePath.substr(startPos);
+    if (str != ".xml" && str != ".json" && str != ".ExportJson")
+    {
+        CCLOG("%s can't be converted to a binary armature file", filePath.c_str());
+        return false;
+    }
+
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+    std::string contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+    if (contentStr.empty())
+    {
+        CCLOG("can't read %s", filePath.c_str());
+        return false;
+    }
+
+    BakedData bakedData;
+
+    DataInfo dataInfo;
+    dataInfo.asyncStruct = nullptr;
+    dataInfo.bakedData = &bakedData;
+    dataInfo.filename = filePath;
+    // particle plists are stored relative to the file, the loader adds its base path
+    dataInfo.baseFilePath = "";
+    dataInfo.contentScale = 1.0f;
+    dataInfo.flashToolVersion = 0;
+    dataInfo.cocoStudioVersion = 0;
+
+    // positions are stored without the read scale, it is applied when the binary file is loaded
+    float positionReadScale = s_PositionReadScale;
+    s_PositionReadScale = 1;
+    if (str == ".xml")
+    {
+        addDataFromCache(contentStr, &dataInfo);
+    }
+    else
+    {
+        addDataFromJsonCache(contentStr, &dataInfo);
+    }
+    s_PositionReadScale = positionReadScale;
+
+    BinaryWriter writer;
+    for (auto& armatureData : bakedData.armatures)
+    {
+        writer.addArmature(armatureData);
+    }
+    for (auto& animationData : bakedData.animations)
+    {
+        writer.addAnimation(animationData);
+    }
+    for (auto& textureData : bakedData.textures)
+    {
+        writer.addTexture(textureData);
+    }
+    for (auto& configFile : bakedData.configFiles)
+    {
+        writer.addConfigFile(configFile);
+    }
+
+    if (!writer.save(binaryPath))
+    {
+        CCLOG("can't write %s", binaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void DataReaderHelper::addDataFromBinaryCache(const std::string& fileContent, DataInfo *dataInfo)
+{
+    // the records are read in place, they need a 4 bytes aligned buffer
+    std::vector<uint32_t> alignedContent;
+    const char *bytes = fileContent.data();
+    if (reinterpret_cast<uintptr_t>(bytes) % 4 != 0)
+    {
+        alignedContent.resize((fileContent.size() + 3) / 4);
+        memcpy(alignedContent.data(), bytes, fileContent.size());
+        bytes = reinterpret_cast<const char *>(alignedContent.data());
+    }
+
+    BinaryReader reader;
+    if (!reader.init(bytes, fileContent.size()))
+    {
+        CCLOG("%s is not a valid binary armature file", dataInfo->filename.c_str());
+        return;
+    }
+    const BinaryHeader *header = reader._header;
+
+    const std::string& baseFilePath = dataInfo->asyncStruct ? dataInfo->asyncStruct->baseFilePath : dataInfo->baseFilePath;
+
+    // Armatures
+    for (uint32_t i = 0; i < header->armatureCount; i++)
+    {
+        const BinaryArmature& armature = reader._armatures[i];
+
+        ArmatureData *armatureData = new ArmatureData();
+        armatureData->init();
+        armatureData->name = reader.getString(armature.name);
+        armatureData->dataVersion = armature.dataVersion;
+
+        for (uint32_t j = armature.bones.first; j < armature.bones.first + armature.bones.count; j++)
+        {
+            const BinaryBone& bone = reader._bones[j];
+
+            BoneData *boneData = new BoneData();
+            boneData->init();
+            readBinaryNode(boneData, bone.node);
+            boneData->name = reader.getString(bone.name);
+            boneData->parentName = reader.getString(bone.parentName);
+            boneData->displayDataList.reserve(bone.displays.count);
+
+            for (uint32_t k = bone.displays.first; k < bone.displays.first + bone.displays.count; k++)
+            {
+                const BinaryDisplay& display = reader._displays[k];
+
+                DisplayData *displayData = nullptr;
+                switch (display.displayType)
+                {
+                case CS_DISPLAY_ARMATURE:
+                    displayData = new ArmatureDisplayData();
+                    displayData->displayName = reader.getString(display.displayName);
+                    break;
+                case CS_DISPLAY_PARTICLE:
+                    displayData = new ParticleDisplayData();
+                    displayData->displayName = baseFilePath + reader.getString(display.displayName);
+                    break;
+                default:
+                    displayData = new SpriteDisplayData();
+                    displayData->displayName = reader.getString(display.displayName);
+                    readBinaryNode(&static_cast<SpriteDisplayData *>(displayData)->skinData, display.skinData);
+                    break;
+                }
+                displayData->displayType = (DisplayType)display.displayType;
+
+                boneData->addDisplayData(displayData);
+                displayData->release();
+            }
+
+            armatureData->addBoneData(boneData);
+            boneData->release();
+        }
+
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.lock();
+        }
+        ArmatureDataManager::getInstance()->addArmatureData(armatureData->name, armatureData, dataInfo->filename);
+        releaseAddedData(armatureData, dataInfo);
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.unlock();
+        }
+    }
+
+    // Animations
+    std::vector<FrameData *> frameDatas;
+    for (uint32_t i = 0; i < header->animationCount; i++)
+    {
+        const BinaryAnimation& animation = reader._animations[i];
+
+        AnimationData *animationData = new AnimationData();
+        animationData->name = reader.getString(animation.name);
+
+        for (uint32_t j = animation.movements.first; j < animation.movements.first + animation.movements.count; j++)
+        {
+            const BinaryMovement& movement = reader._movements[j];
+
+            MovementData *movementData = new MovementData();
+            movementData->name = reader.getString(movement.name);
+            movementData->duration = movement.duration;
+            movementData->scale = movement.scale;
+            movementData->durationTo = movement.durationTo;
+            movementData->durationTween = movement.durationTween;
+            movementData->loop = movement.loop != 0;
+            movementData->tweenEasing = (TweenType)movement.tweenEasing;
+
+            for (uint32_t k = movement.movementBones.first; k < movement.movementBones.first + movement.movementBones.count; k++)
+            {
+                const BinaryMovementBone& movementBone = reader._movementBones[k];
+
+                MovementBoneData *movementBoneData = new MovementBoneData();
+                movementBoneData->init();
+                movementBoneData->name = reader.getString(movementBone.name);
+                movementBoneData->delay = movementBone.delay;
+                movementBoneData->scale = movementBone.scale;
+                movementBoneData->duration = movementBone.duration;
+                movementBoneData->frameList.reserve(movementBone.frames.count);
+
+                // the frames of a movement bone share one allocation
+                frameDatas.resize(movementBone.frames.count);
+                FrameData::newFrames(frameDatas.data(), frameDatas.size());
+
+                const BinaryFrame *frames = reader._frames + movementBone.frames.first;
+                for (uint32_t f = 0; f < movementBone.frames.count; f++)
+                {
+                    const BinaryFrame& frame = frames[f];
+
+                    FrameData *frameData = frameDatas[f];
+                    readBinaryNode(frameData, frame.node);
+                    frameData->frameID = frame.frameID;
+                    frameData->duration = frame.duration;
+                    frameData->tweenEasing = (TweenType)frame.tweenEasing;
+                    if (frame.easingParams.count > 0)
+                    {
+                        frameData->easingParamNumber = frame.easingParams.count;
+                        frameData->easingParams = new float[frame.easingParams.count];
+                        memcpy(frameData->easingParams, reader._floats + frame.easingParams.first, frame.easingParams.count * sizeof(float));
+                    }
+                    frameData->isTween = frame.isTween != 0;
+                    frameData->displayIndex = frame.displayIndex;
+                    frameData->blendFunc.src = frame.blendSrc;
+                    frameData->blendFunc.dst = frame.blendDst;
+                    if (frame.strEvent) frameData->strEvent = reader.getString(frame.strEvent);
+                    if (frame.strMovement) frameData->strMovement = reader.getString(frame.strMovement);
+                    if (frame.strSound) frameData->strSound = reader.getString(frame.strSound);
+                    if (frame.strSoundEffect) frameData->strSoundEffect = reader.getString(frame.strSoundEffect);
+
+                    movementBoneData->addFrameData(frameData);
+                    frameData->release();
+                }
+                // the key frame track Tween reads is built here, on the loading thread, rather than on the first play
+                movementBoneData->updateFrameTrack();
+
+                movementData->addMovementBoneData(movementBoneData);
+                movementBoneData->release();
+            }
+
+            animationData->addMovement(movementData);
+            movementData->release();
+        }
+
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.lock();
+        }
+        ArmatureDataManager::getInstance()->addAnimationData(animationData->name, animationData, dataInfo->filename);
+        releaseAddedData(animationData, dataInfo);
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.unlock();
+        }
+    }
+
+    // Textures
+    for (uint32_t i = 0; i < header->textureCount; i++)
+    {
+        const BinaryTexture& texture = reader._textures[i];
+
+        TextureData *textureData = new TextureData();
+        textureData->init();
+        textureData->name = reader.getString(texture.name);
+        textureData->width = texture.width;
+        textureData->height = texture.height;
+        textureData->pivotX = texture.pivotX;
+        textureData->pivotY = texture.pivotY;
+
+        for (uint32_t j = texture.contours.first; j < texture.contours.first + texture.contours.count; j++)
+        {
+            const BinaryRange& contour = reader._contours[j];
+
+            ContourData *contourData = new ContourData();
+            contourData->init();
+            contourData->vertexList.reserve(contour.count);
+            for (uint32_t k = contour.first; k < contour.first + contour.count; k++)
+            {
+                contourData->vertexList.push_back(Point(reader._vertices[k].x, reader._vertices[k].y));
+            }
+
+            textureData->contourDataList.pushBack(contourData);
+            contourData->release();
+        }
+
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.lock();
+        }
+        ArmatureDataManager::getInstance()->addTextureData(textureData->name, textureData, dataInfo->filename);
+        releaseAddedData(textureData, dataInfo);
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.unlock();
+        }
+    }
+
+    // Auto load sprite file
+    bool autoLoad = dataInfo->asyncStruct == nullptr ? ArmatureDataManager::getInstance()->isAutoLoadSpriteFile() : dataInfo->asyncStruct->autoLoadSpriteFile;
+    if (autoLoad)
+    {
+        for (uint32_t i = 0; i < header->configFileCount; i++)
+        {
+            std::string filePath = reader.getString(reader._configFiles[i]);
+            filePath = filePath.erase(filePath.find_last_of("."));
+
+            if (dataInfo->asyncStruct)
+            {
+                dataInfo->configFileQueue.push(filePath);
+            }
+            else
+            {
+                std::string plistPath = filePath + ".plist";
+                std::string pngPath =  filePath + ".png";
+
+                ArmatureDataManager::getInstance()->addSpriteFrameFromFile((dataInfo->baseFilePath + plistPath).c_str(), (dataInfo->baseFilePath + pngPath).c_str());
+            }
+        }
+    }
+}
+
 }
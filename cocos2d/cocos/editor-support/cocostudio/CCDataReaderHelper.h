@@ -55,7 +55,8 @@ protected:
 	enum ConfigType
 	{
 		DragonBone_XML,
-		CocoStudio_JSON
+		CocoStudio_JSON,
+		CocoStudio_Binary
 	};
 
 	typedef struct _AsyncStruct
@@ -72,15 +73,26 @@ protected:
         std::string    plistPath;
 	} AsyncStruct;
 
+	//! Everything decoded from a file, kept by bakeBinaryFile() to write it back
+	typedef struct _BakedData
+	{
+		cocos2d::Vector<ArmatureData *> armatures;
+		cocos2d::Vector<AnimationData *> animations;
+		cocos2d::Vector<TextureData *> textures;
+		std::vector<std::string> configFiles;
+	} BakedData;
+
 	typedef struct _DataInfo
 	{
 		AsyncStruct *asyncStruct;
+		BakedData *bakedData;
 		std::queue<std::string>      configFileQueue;
         float contentScale;
         std::string    filename;
         std::string    baseFilePath;
         float flashToolVersion;
         float cocoStudioVersion;
+        std::vector<cocos2d::Ref*> pendingReleases;     // released in the cocos thread once the file is loaded
 	} DataInfo;
 
 public:
@@ -115,6 +127,17 @@ public:
     void addDataAsyncCallBack(float dt);
 
     void removeConfigFile(const std::string& configFile);
+
+    /**
+     * Decodes an armature file (.xml, .json or .ExportJson) and writes its data in the binary format
+     * read by addDataFromBinaryCache(). The data is also added to the ArmatureDataManager, as addDataFromFile() does.
+     * Positions are written without the position read scale, which is applied when the binary file is loaded.
+     *
+     * @param filePath The file to convert
+     * @param binaryPath Where to write the binary file, usually the same path with the .csab extension
+     * @return false if the file can't be decoded or written
+     */
+    static bool bakeBinaryFile(const std::string& filePath, const std::string& binaryPath);
 public:
 
     /**
@@ -172,9 +195,23 @@ public:
 
     static void decodeNode(BaseData *node, const rapidjson::Value& json, DataInfo *dataInfo);
 
+public:
+    /**
+     * Adds the data of a binary armature file (.csab) written by bakeBinaryFile().
+     * The keyframes are stored as flat arrays of fixed size records, they are copied
+     * into the data objects and the key frame track of every MovementBoneData without any text parsing.
+     */
+    static void addDataFromBinaryCache(const std::string& fileContent, DataInfo *dataInfo = nullptr);
+
 protected:
 	void loadData();
 
+    /**
+     * Drops the reference of the reader on data added to ArmatureDataManager. The loading thread
+     * leaves it to the cocos thread, which may already be retaining the data.
+     */
+    static void releaseAddedData(cocos2d::Ref *data, DataInfo *dataInfo);
+
 
 
 
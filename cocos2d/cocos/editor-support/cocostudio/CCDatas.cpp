@@ -26,6 +26,9 @@ THE SOFTWARE.
 #include "cocostudio/CCUtilMath.h"
 #include "cocostudio/CCTransformHelp.h"
 
+#include <atomic>
+#include <new>
+
 using namespace cocos2d;
 
 namespace cocostudio {
@@ -246,6 +249,70 @@ BoneData *ArmatureData::getBoneData(const std::string& boneName)
     return static_cast<BoneData*>(boneDataDic.at(boneName));
 }
 
+//! Every FrameData is preceded by a header pointing to the block it was constructed in, nullptr if it was allocated alone
+static const size_t FRAME_HEADER_SIZE = 16;
+
+struct FrameBlock
+{
+    std::atomic<size_t> liveFrames;
+};
+
+static_assert(sizeof(FrameBlock) <= FRAME_HEADER_SIZE && sizeof(FrameBlock *) <= FRAME_HEADER_SIZE, "FrameData header too small");
+
+static FrameBlock *&getFrameBlock(void *frame)
+{
+    return *reinterpret_cast<FrameBlock **>(static_cast<char *>(frame) - FRAME_HEADER_SIZE);
+}
+
+void *FrameData::operator new(size_t size)
+{
+    void *frame = static_cast<char *>(::operator new(FRAME_HEADER_SIZE + size)) + FRAME_HEADER_SIZE;
+    getFrameBlock(frame) = nullptr;
+    return frame;
+}
+
+void FrameData::operator delete(void *ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    FrameBlock *block = getFrameBlock(ptr);
+    if (!block)
+    {
+        ::operator delete(static_cast<char *>(ptr) - FRAME_HEADER_SIZE);
+    }
+    else if (--block->liveFrames == 0)
+    {
+        block->~FrameBlock();
+        ::operator delete(block);
+    }
+}
+
+void FrameData::newFrames(FrameData **frames, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // the header of every frame keeps it aligned as the global operator new would
+    size_t stride = FRAME_HEADER_SIZE + (sizeof(FrameData) + FRAME_HEADER_SIZE - 1) / FRAME_HEADER_SIZE * FRAME_HEADER_SIZE;
+    char *memory = static_cast<char *>(::operator new(FRAME_HEADER_SIZE + count * stride));
+
+    FrameBlock *block = new (memory) FrameBlock();
+    block->liveFrames = count;
+
+    char *slot = memory + FRAME_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++, slot += stride)
+    {
+        void *frame = slot + FRAME_HEADER_SIZE;
+        getFrameBlock(frame) = block;
+        frames[i] = ::new (frame) FrameData();
+    }
+}
+
 FrameData::FrameData(void)
     : frameID(0)
     , duration(1)
@@ -299,6 +366,7 @@ MovementBoneData::MovementBoneData()
     , scale(1.0f)
     , duration(0)
     , name("")
+    , canSkipFrames(false)
 {
 }
 
@@ -321,6 +389,56 @@ FrameData *MovementBoneData::getFrameData(int index)
     return frameList.at(index);
 }
 
+void MovementBoneData::updateFrameTrack()
+{
+    frameIDs.clear();
+    frameEvents.clear();
+    frameDisplayIndices.clear();
+    frameTweenRotates.clear();
+    frameColorInfos.clear();
+    frameIDs.reserve(frameList.size());
+    frameEvents.reserve(frameList.size());
+    frameDisplayIndices.reserve(frameList.size());
+    frameTweenRotates.reserve(frameList.size());
+    frameColorInfos.reserve(frameList.size());
+    for (auto& values : frameValues)
+    {
+        values.clear();
+        values.reserve(frameList.size());
+    }
+
+    canSkipFrames = true;
+    for (auto& frameData : frameList)
+    {
+        if (!frameIDs.empty() && frameData->frameID < frameIDs.back())
+        {
+            canSkipFrames = false;
+        }
+
+        frameIDs.push_back(frameData->frameID);
+        frameEvents.push_back(frameData->strEvent.length() != 0);
+        frameDisplayIndices.push_back(frameData->displayIndex);
+        frameTweenRotates.push_back(frameData->tweenRotate);
+        frameColorInfos.push_back(frameData->isUseColorInfo);
+
+        frameValues[FRAME_X].push_back(frameData->x);
+        frameValues[FRAME_Y].push_back(frameData->y);
+        frameValues[FRAME_SCALE_X].push_back(frameData->scaleX);
+        frameValues[FRAME_SCALE_Y].push_back(frameData->scaleY);
+        frameValues[FRAME_SKEW_X].push_back(frameData->skewX);
+        frameValues[FRAME_SKEW_Y].push_back(frameData->skewY);
+        frameValues[FRAME_COLOR_A].push_back(frameData->a);
+        frameValues[FRAME_COLOR_R].push_back(frameData->r);
+        frameValues[FRAME_COLOR_G].push_back(frameData->g);
+        frameValues[FRAME_COLOR_B].push_back(frameData->b);
+
+        if (frameEvents.back())
+        {
+            canSkipFrames = false;
+        }
+    }
+}
+
 
 
 MovementData::MovementData(void)
@@ -329,6 +329,16 @@ public:
      */
     ~FrameData();
 
+    /**
+     * Constructs count frames in a single allocation, as the binary loader does for the frames of a MovementBoneData.
+     * Every frame starts with a reference count of 1, as with new, and is destroyed by its last release().
+     * The memory is freed with the last frame of the block.
+     */
+    static void newFrames(FrameData **frames, size_t count);
+
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
     virtual void copy(const BaseData *baseData);
 public:
     int frameID;
@@ -380,6 +390,29 @@ public:
 
     void addFrameData(FrameData *frameData);
     FrameData *getFrameData(int index);
+
+    /**
+     * Rebuild the key frame track from frameList.
+     * Tween rebuilds it by itself when the number of frames changed, call it after changing the frameID,
+     * strEvent, display index or tweened values of frames which have been played already.
+     */
+    void updateFrameTrack();
+
+    //! The tweened values of the frames, each one has its own array in frameValues
+    enum FrameValue
+    {
+        FRAME_X,
+        FRAME_Y,
+        FRAME_SCALE_X,
+        FRAME_SCALE_Y,
+        FRAME_SKEW_X,
+        FRAME_SKEW_Y,
+        FRAME_COLOR_A,
+        FRAME_COLOR_R,
+        FRAME_COLOR_G,
+        FRAME_COLOR_B,
+        FRAME_VALUE_COUNT
+    };
 public:
     float delay;             //! movement delay percent, this value can produce a delay effect
     float scale;             //! scale this movement
@@ -387,6 +420,19 @@ public:
     std::string name;    //! bone name
 
     cocos2d::Vector<FrameData*> frameList;
+
+    /**
+    * The key frame track, the frameID, whether there is an event and the tweened values of every frame in frameList
+    * kept in flat arrays, so Tween can find the current key frame and tween to the next one without visiting
+    * the FrameData objects.
+    */
+    std::vector<int> frameIDs;
+    std::vector<bool> frameEvents;
+    std::vector<int> frameDisplayIndices;
+    std::vector<float> frameValues[FRAME_VALUE_COUNT];
+    std::vector<float> frameTweenRotates;
+    std::vector<bool> frameColorInfos;
+    bool canSkipFrames;      //! The frame ids are sorted and no frame has an event, so Tween can binary search the track
 };
 
 /**
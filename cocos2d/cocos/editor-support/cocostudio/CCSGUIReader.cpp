@@ -24,8 +24,11 @@ THE SOFTWARE.
 #include "cocostudio/CCSGUIReader.h"
 #include "ui/CocosGUI.h"
 #include "cocostudio/CCActionManagerEx.h"
+#include "json/writer.h"
+#include "json/stringbuffer.h"
 #include <fstream>
 #include <iostream>
+#include <thread>
 #include "WidgetReader/ButtonReader/ButtonReader.h"
 #include "WidgetReader/CheckBoxReader/CheckBoxReader.h"
 #include "WidgetReader/SliderReader/SliderReader.h"
@@ -49,7 +52,8 @@ namespace cocostudio {
 static GUIReader* sharedReader = nullptr;
 
 GUIReader::GUIReader():
-m_strFilePath("")
+m_strFilePath(""),
+_widgetCacheEnabled(true)
 {
     ObjectFactory* factoryCreate = ObjectFactory::getInstance();
     
@@ -177,15 +181,90 @@ void GUIReader::registerTypeAndCallBack(const std::string& classType,
 }
 
 
+void GUIReader::setWidgetCacheEnabled(bool enabled)
+{
+    _widgetCacheEnabled = enabled;
+    if (!enabled)
+    {
+        purgeWidgetCache();
+    }
+}
+
+void GUIReader::purgeWidgetCache()
+{
+    _widgetPrototypes.clear();
+    _widgetPrototypeTextures.clear();
+    _widgetPrototypeActions.clear();
+}
+
 Widget* GUIReader::widgetFromJsonFile(const char *fileName)
 {
+    if (_widgetCacheEnabled)
+    {
+        Widget* prototype = _widgetPrototypes.at(fileName);
+        if (prototype)
+        {
+            // the sprite sheets may have been purged since the prototype was built
+            for (const auto& plist : _widgetPrototypeTextures[fileName])
+            {
+                SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plist);
+            }
+            Widget* widget = prototype->clone();
+
+            // the actions may have been released since, and a parsed file always registers them again
+            const std::string& actionsJson = _widgetPrototypeActions[fileName];
+            if (!actionsJson.empty())
+            {
+                rapidjson::Document actions;
+                actions.Parse<0>(actionsJson.c_str());
+                if (!actions.HasParseError())
+                {
+                    ActionManagerEx::getInstance()->initWithDictionary(fileName, actions, widget);
+                }
+            }
+            return widget;
+        }
+    }
+
 	std::string jsonpath;
 	rapidjson::Document jsonDict;
     jsonpath = CCFileUtils::getInstance()->fullPathForFilename(fileName);
-    size_t pos = jsonpath.find_last_of('/');
-	m_strFilePath = jsonpath.substr(0,pos+1);
     std::string contentStr = FileUtils::getInstance()->getStringFromFile(jsonpath);
 	jsonDict.Parse<0>(contentStr.c_str());
+    return widgetFromJsonDocument(jsonDict, jsonpath, fileName);
+}
+
+void GUIReader::widgetFromJsonFileAsync(const char *fileName, const std::function<void(Widget*)>& callback)
+{
+    std::string file = fileName;
+    Scheduler* scheduler = Director::getInstance()->getScheduler();
+
+    if (_widgetCacheEnabled && _widgetPrototypes.at(file))
+    {
+        scheduler->performFunctionInCocosThread([file, callback](){
+            callback(GUIReader::getInstance()->widgetFromJsonFile(file.c_str()));
+        });
+        return;
+    }
+
+    std::string jsonpath = FileUtils::getInstance()->fullPathForFilename(fileName);
+
+    // reading and parsing are the slow part for big files, the widgets are built in the cocos thread
+    std::thread([file, jsonpath, callback, scheduler](){
+        std::shared_ptr<rapidjson::Document> jsonDict = std::make_shared<rapidjson::Document>();
+        std::string contentStr = FileUtils::getInstance()->getStringFromFile(jsonpath);
+        jsonDict->Parse<0>(contentStr.c_str());
+
+        scheduler->performFunctionInCocosThread([file, jsonpath, callback, jsonDict](){
+            callback(GUIReader::getInstance()->widgetFromJsonDocument(*jsonDict, jsonpath, file.c_str()));
+        });
+    }).detach();
+}
+
+Widget* GUIReader::widgetFromJsonDocument(const rapidjson::Document& jsonDict, const std::string& jsonpath, const char* fileName)
+{
+    size_t pos = jsonpath.find_last_of('/');
+	m_strFilePath = jsonpath.substr(0,pos+1);
     if (jsonDict.HasParseError())
     {
         CCLOG("GetParseError %s\n",jsonDict.GetParseError());
@@ -213,6 +292,31 @@ Widget* GUIReader::widgetFromJsonFile(const char *fileName)
         widget = pReader->createWidget(jsonDict, m_strFilePath.c_str(), fileName);
     }
     
+    // custom widgets might not clone all of their properties
+    if (widget && _widgetCacheEnabled && !pReader->isCustomWidgetRead())
+    {
+        _widgetPrototypes.insert(fileName, widget->clone());
+
+        std::vector<std::string>& textures = _widgetPrototypeTextures[fileName];
+        textures.clear();
+        int texturesCount = DICTOOL->getArrayCount_json(jsonDict, "textures");
+        for (int i=0; i<texturesCount; i++)
+        {
+            textures.push_back(m_strFilePath + DICTOOL->getStringValueFromArray_json(jsonDict, "textures", i));
+        }
+
+        std::string& actionsJson = _widgetPrototypeActions[fileName];
+        actionsJson.clear();
+        const rapidjson::Value& actions = DICTOOL->getSubDictionary_json(jsonDict, "animation");
+        if (actions.IsObject())
+        {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            actions.Accept(writer);
+            actionsJson = buffer.GetString();
+        }
+    }
+    
     CC_SAFE_DELETE(pReader);
     return widget;
 }
@@ -1017,6 +1121,8 @@ Widget* WidgetPropertiesReader0300::widgetFromJsonDictionary(const rapidjson::Va
     }
     else
     {
+        _customWidgetRead = true;
+
         // 1st., custom widget parse properties of parent widget with parent widget reader
         if (dynamic_cast<Button*>(widget))
         {
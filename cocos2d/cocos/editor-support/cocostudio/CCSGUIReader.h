@@ -47,6 +47,23 @@ public:
     static void destroyInstance();
     
     cocos2d::ui::Widget* widgetFromJsonFile(const char* fileName);
+    /**
+     *  Read and parse the file in a thread, then build the widget in the cocos thread and pass it to callback
+     *  @js NA
+     */
+    void widgetFromJsonFileAsync(const char* fileName, const std::function<void(cocos2d::ui::Widget*)>& callback);
+    /**
+     *  Whether widgetFromJsonFile() keeps a prototype of the widget built from every file, and returns clones of
+     *  it instead of parsing the file again. Files with custom widgets are always parsed. True by default.
+     *  @js NA
+     */
+    void setWidgetCacheEnabled(bool enabled);
+    bool isWidgetCacheEnabled() const { return _widgetCacheEnabled; }
+    /**
+     *  Release the cached prototypes
+     *  @js NA
+     */
+    void purgeWidgetCache();
     int getVersionInteger(const char* str);
     /**
      *  @js NA
@@ -67,9 +84,16 @@ public:
 protected:
     GUIReader();
     ~GUIReader();
+
+    cocos2d::ui::Widget* widgetFromJsonDocument(const rapidjson::Document& jsonDict, const std::string& jsonPath, const char* fileName);
     
     std::string m_strFilePath;
     cocos2d::ValueMap _fileDesignSizes;
+
+    bool _widgetCacheEnabled;
+    cocos2d::Map<std::string, cocos2d::ui::Widget*> _widgetPrototypes;
+    std::unordered_map<std::string, std::vector<std::string>> _widgetPrototypeTextures;     // the sprite sheets used by each prototype
+    std::unordered_map<std::string, std::string> _widgetPrototypeActions;                   // the "animation" object of each prototype, registered again for every clone
     
     typedef std::map<std::string, SEL_ParseEvent>  ParseCallBackMap;
     ParseCallBackMap _mapParseSelector;
@@ -85,6 +109,11 @@ public:
 class WidgetPropertiesReader : public cocos2d::Ref
 {
 public:
+    WidgetPropertiesReader() : _customWidgetRead(false) {}
+    
+    /* Whether a widget of a class registered with GUIReader::registerTypeAndCallBack() was read */
+    bool isCustomWidgetRead() const { return _customWidgetRead; }
+    
     virtual cocos2d::ui::Widget* createWidget(const rapidjson::Value& dic, const char* fullPath, const char* fileName)=0;
     virtual cocos2d::ui::Widget* widgetFromJsonDictionary(const rapidjson::Value& data) = 0;
     virtual void setPropsForAllWidgetFromJsonDictionary(WidgetReaderProtocol* reader, cocos2d::ui::Widget* widget, const rapidjson::Value& options) = 0;
@@ -93,6 +122,7 @@ public:
                                                               const rapidjson::Value& customOptions) = 0;
 protected:
     std::string m_strFilePath;
+    bool _customWidgetRead;
 };
 
 
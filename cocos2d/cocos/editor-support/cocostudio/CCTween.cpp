@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "cocostudio/CCUtilMath.h"
 #include "cocostudio/CCTransformHelp.h"
 
+#include <algorithm>
+
 
 namespace cocostudio {
 
@@ -56,6 +58,7 @@ Tween::Tween()
     , _from(nullptr)
     , _to(nullptr)
     , _between(nullptr)
+    , _fromEasingParams(nullptr)
     , _bone(nullptr)
 
     , _frameTweenEasing(Linear)
@@ -64,7 +67,10 @@ Tween::Tween()
     , _animation(nullptr)
     , _passLastFrame(false)
 {
-
+    for (int i = 0; i < MovementBoneData::FRAME_VALUE_COUNT; i++)
+    {
+        _fromValues[i] = _betweenValues[i] = 0;
+    }
 }
 
 
@@ -310,6 +316,79 @@ void Tween::setBetween(FrameData *from, FrameData *to, bool limit)
     }
     while (0);
 
+    _fromValues[MovementBoneData::FRAME_X] = _from->x;
+    _fromValues[MovementBoneData::FRAME_Y] = _from->y;
+    _fromValues[MovementBoneData::FRAME_SCALE_X] = _from->scaleX;
+    _fromValues[MovementBoneData::FRAME_SCALE_Y] = _from->scaleY;
+    _fromValues[MovementBoneData::FRAME_SKEW_X] = _from->skewX;
+    _fromValues[MovementBoneData::FRAME_SKEW_Y] = _from->skewY;
+    _fromValues[MovementBoneData::FRAME_COLOR_A] = _from->a;
+    _fromValues[MovementBoneData::FRAME_COLOR_R] = _from->r;
+    _fromValues[MovementBoneData::FRAME_COLOR_G] = _from->g;
+    _fromValues[MovementBoneData::FRAME_COLOR_B] = _from->b;
+
+    _betweenValues[MovementBoneData::FRAME_X] = _between->x;
+    _betweenValues[MovementBoneData::FRAME_Y] = _between->y;
+    _betweenValues[MovementBoneData::FRAME_SCALE_X] = _between->scaleX;
+    _betweenValues[MovementBoneData::FRAME_SCALE_Y] = _between->scaleY;
+    _betweenValues[MovementBoneData::FRAME_SKEW_X] = _between->skewX;
+    _betweenValues[MovementBoneData::FRAME_SKEW_Y] = _between->skewY;
+    _betweenValues[MovementBoneData::FRAME_COLOR_A] = _between->a;
+    _betweenValues[MovementBoneData::FRAME_COLOR_R] = _between->r;
+    _betweenValues[MovementBoneData::FRAME_COLOR_G] = _between->g;
+    _betweenValues[MovementBoneData::FRAME_COLOR_B] = _between->b;
+    _fromEasingParams = _from->easingParams;
+
+    if (!from->isTween)
+    {
+        _tweenData->copy(from);
+        _tweenData->isTween = true;
+    }
+
+    arriveKeyFrame(from);
+}
+
+void Tween::setBetweenKeyFrames(int fromIndex, int toIndex)
+{
+    const MovementBoneData &track = *_movementBoneData;
+    FrameData *from = track.frameList.at(fromIndex);
+
+    //! The frames setBetween() copies to _from, and subtracts from the "to" frame
+    int copyIndex = fromIndex;
+    int subtractIndex = fromIndex;
+    if (track.frameDisplayIndices[fromIndex] < 0 && track.frameDisplayIndices[toIndex] >= 0)
+    {
+        copyIndex = subtractIndex = toIndex;
+    }
+    else if (track.frameDisplayIndices[toIndex] < 0 && track.frameDisplayIndices[fromIndex] >= 0)
+    {
+        subtractIndex = toIndex;
+    }
+
+    for (int i = 0; i < MovementBoneData::FRAME_VALUE_COUNT; i++)
+    {
+        const std::vector<float> &values = track.frameValues[i];
+        _fromValues[i] = values[copyIndex];
+        _betweenValues[i] = values[toIndex] - values[subtractIndex];
+    }
+
+    _between->isUseColorInfo = _between->isUseColorInfo || track.frameColorInfos[subtractIndex] || track.frameColorInfos[toIndex];
+    if (!_between->isUseColorInfo)
+    {
+        for (int i = MovementBoneData::FRAME_COLOR_A; i < MovementBoneData::FRAME_VALUE_COUNT; i++)
+        {
+            _betweenValues[i] = 0;
+        }
+    }
+
+    if (track.frameTweenRotates[toIndex])
+    {
+        _betweenValues[MovementBoneData::FRAME_SKEW_X] += track.frameTweenRotates[toIndex] * M_PI * 2;
+        _betweenValues[MovementBoneData::FRAME_SKEW_Y] -= track.frameTweenRotates[toIndex] * M_PI * 2;
+    }
+
+    _fromEasingParams = track.frameList.at(copyIndex)->easingParams;
+
     if (!from->isTween)
     {
         _tweenData->copy(from);
@@ -362,12 +441,18 @@ FrameData *Tween::tweenNodeTo(float percent, FrameData *node)
         percent = 0;
     }
 
-    node->x = _from->x + percent * _between->x;
-    node->y = _from->y + percent * _between->y;
-    node->scaleX = _from->scaleX + percent * _between->scaleX;
-    node->scaleY = _from->scaleY + percent * _between->scaleY;
-    node->skewX = _from->skewX + percent * _between->skewX;
-    node->skewY = _from->skewY + percent * _between->skewY;
+    float values[MovementBoneData::FRAME_COLOR_A];
+    for (int i = 0; i < MovementBoneData::FRAME_COLOR_A; i++)
+    {
+        values[i] = _fromValues[i] + percent * _betweenValues[i];
+    }
+
+    node->x = values[MovementBoneData::FRAME_X];
+    node->y = values[MovementBoneData::FRAME_Y];
+    node->scaleX = values[MovementBoneData::FRAME_SCALE_X];
+    node->scaleY = values[MovementBoneData::FRAME_SCALE_Y];
+    node->skewX = values[MovementBoneData::FRAME_SKEW_X];
+    node->skewY = values[MovementBoneData::FRAME_SKEW_Y];
 
     _bone->setTransformDirty(true);
 
@@ -381,10 +466,16 @@ FrameData *Tween::tweenNodeTo(float percent, FrameData *node)
 
 void Tween::tweenColorTo(float percent, FrameData *node)
 {
-    node->a = _from->a + percent * _between->a;
-    node->r = _from->r + percent * _between->r;
-    node->g = _from->g + percent * _between->g;
-    node->b = _from->b + percent * _between->b;
+    float values[MovementBoneData::FRAME_VALUE_COUNT - MovementBoneData::FRAME_COLOR_A];
+    for (int i = 0; i < MovementBoneData::FRAME_VALUE_COUNT - MovementBoneData::FRAME_COLOR_A; i++)
+    {
+        values[i] = _fromValues[MovementBoneData::FRAME_COLOR_A + i] + percent * _betweenValues[MovementBoneData::FRAME_COLOR_A + i];
+    }
+
+    node->a = values[MovementBoneData::FRAME_COLOR_A - MovementBoneData::FRAME_COLOR_A];
+    node->r = values[MovementBoneData::FRAME_COLOR_R - MovementBoneData::FRAME_COLOR_A];
+    node->g = values[MovementBoneData::FRAME_COLOR_G - MovementBoneData::FRAME_COLOR_A];
+    node->b = values[MovementBoneData::FRAME_COLOR_B - MovementBoneData::FRAME_COLOR_A];
     _bone->updateColor();
 }
 
@@ -408,17 +499,23 @@ float Tween::updateFrameData(float currentPercent)
         long length = _movementBoneData->frameList.size();
         cocos2d::Vector<FrameData *> &frames = _movementBoneData->frameList;
 
+        if ((long)_movementBoneData->frameIDs.size() != length)
+        {
+            _movementBoneData->updateFrameTrack();
+        }
+        const std::vector<int> &frameIDs = _movementBoneData->frameIDs;
+
         FrameData *from = nullptr;
         FrameData *to = nullptr;
 
-        if (playedTime < frames.at(0)->frameID)
+        if (playedTime < frameIDs[0])
         {
             from = to = frames.at(0);
             setBetween(from, to);
             return _currentPercent;
         }
         
-        if(playedTime >= frames.at(length - 1)->frameID)
+        if(playedTime >= frameIDs[length - 1])
         {
             // If _passLastFrame is true and playedTime >= frames[length - 1]->frameID, then do not need to go on. 
             if (_passLastFrame)
@@ -435,38 +532,50 @@ float Tween::updateFrameData(float currentPercent)
         }
 
 
-        do
+        if (_movementBoneData->canSkipFrames)
         {
-            _fromIndex = _toIndex;
-            from = frames.at(_fromIndex);
-            _totalDuration  = from->frameID;
-
+            _fromIndex = seekKeyFrame(playedTime);
             _toIndex = _fromIndex + 1;
             if (_toIndex >= length)
             {
                 _toIndex = 0;
             }
-
-            to = frames.at(_toIndex);
-
-            //! Guaranteed to trigger frame event
-            if(from->strEvent.length() != 0 && !_animation->isIgnoreFrameEvent())
-            {
-                _animation->frameEvent(_bone, from->strEvent.c_str(), from->frameID, playedTime);
-            }
-
-            if (playedTime == from->frameID || (_passLastFrame && _fromIndex == length-1))
+        }
+        else
+        {
+            do
             {
-                break;
+                _fromIndex = _toIndex;
+
+                _toIndex = _fromIndex + 1;
+                if (_toIndex >= length)
+                {
+                    _toIndex = 0;
+                }
+
+                //! Guaranteed to trigger frame event
+                if(_movementBoneData->frameEvents[_fromIndex] && !_animation->isIgnoreFrameEvent())
+                {
+                    FrameData *eventFrame = frames.at(_fromIndex);
+                    _animation->frameEvent(_bone, eventFrame->strEvent.c_str(), eventFrame->frameID, playedTime);
+                }
+
+                if (playedTime == frameIDs[_fromIndex] || (_passLastFrame && _fromIndex == length-1))
+                {
+                    break;
+                }
             }
+            while (playedTime < frameIDs[_fromIndex] || playedTime >= frameIDs[_toIndex]);
         }
-        while (playedTime < from->frameID || playedTime >= to->frameID);
 
-        _betweenDuration = to->frameID - from->frameID;
+        from = frames.at(_fromIndex);
+
+        _totalDuration = frameIDs[_fromIndex];
+        _betweenDuration = frameIDs[_toIndex] - frameIDs[_fromIndex];
 
         _frameTweenEasing = from->tweenEasing;
 
-        setBetween(from, to, false);
+        setBetweenKeyFrames(_fromIndex, _toIndex);
 
     }
     currentPercent = _betweenDuration == 0 ? 0 : (playedTime - _totalDuration) / (float)_betweenDuration;
@@ -478,10 +587,36 @@ float Tween::updateFrameData(float currentPercent)
     TweenType tweenType = (_frameTweenEasing != Linear) ? _frameTweenEasing : _tweenEasing;
     if (tweenType != cocos2d::tweenfunc::TWEEN_EASING_MAX && tweenType != Linear && !_passLastFrame)
     {
-        currentPercent = cocos2d::tweenfunc::tweenTo(currentPercent, tweenType, _from->easingParams);
+        currentPercent = cocos2d::tweenfunc::tweenTo(currentPercent, tweenType, _fromEasingParams);
     }
 
     return currentPercent;
 }
 
+int Tween::seekKeyFrame(float playedTime) const
+{
+    /*
+     *  The sequential search stops at the first frame whose frameID equals playedTime, or else at the frame
+     *  playedTime is in. Those frames are one run of the sorted frame ids, the search stops at _toIndex if
+     *  it is in the run, and at the first frame of the run otherwise.
+     */
+    const std::vector<int> &frameIDs = _movementBoneData->frameIDs;
+    int length = (int)frameIDs.size();
+
+    //! While playing, playedTime has usually just passed the next frame
+    if (frameIDs[_toIndex] <= playedTime && (_toIndex == length - 1 || playedTime < frameIDs[_toIndex + 1]))
+    {
+        return _toIndex;
+    }
+
+    int last =(int)(std::upper_bound(frameIDs.begin(), frameIDs.end(), playedTime) - frameIDs.begin()) - 1;
+    int first = last;
+    if (frameIDs[last] == playedTime)
+    {
+        first = (int)(std::lower_bound(frameIDs.begin(), frameIDs.end(), playedTime) - frameIDs.begin());
+    }
+
+    return (_toIndex >= first && _toIndex <= last) ? _toIndex : first;
+}
+
 }
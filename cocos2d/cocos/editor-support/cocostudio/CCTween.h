@@ -107,6 +107,11 @@ protected:
      */
     virtual void setBetween(FrameData *from, FrameData *to, bool limit = true);
 
+    /**
+     * Same as setBetween(frameList[fromIndex], frameList[toIndex], false), reading the values from the key frame track
+     */
+    void setBetweenKeyFrames(int fromIndex, int toIndex);
+
     /**
      * According to the percent to calculate current FrameData with tween effect
      */
@@ -121,6 +126,11 @@ protected:
      * Update display index and process the key frame event when arrived a key frame
      */
     virtual void arriveKeyFrame(FrameData *keyFrameData);
+
+    /**
+     * Find the key frame the sequential search from _toIndex would stop at, when the frames of the track can be skipped
+     */
+    int seekKeyFrame(float playedTime) const;
 protected:
     //! A weak reference to the current MovementBoneData. The data is in the data pool
     MovementBoneData *_movementBoneData;
@@ -130,6 +140,11 @@ protected:
     FrameData *_to;                 //! To frame data, used for calculate between value
     FrameData *_between;            //! Between frame data, used for calculate current FrameData(m_pNode) value
 
+    //! The tweened values of _from and _between, in the order of MovementBoneData::FrameValue so they are interpolated in one loop
+    float _fromValues[MovementBoneData::FRAME_VALUE_COUNT];
+    float _betweenValues[MovementBoneData::FRAME_VALUE_COUNT];
+    float *_fromEasingParams;       //! The easing params of the frame _from was set from
+
 
     Bone *_bone;                    //! A weak reference to the Bone
 
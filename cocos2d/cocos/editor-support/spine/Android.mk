@@ -16,6 +16,7 @@ Bone.cpp \
 BoneData.cpp \
 CCSkeleton.cpp \
 CCSkeletonAnimation.cpp \
+CCSkeletonDataCache.cpp \
 Json.cpp \
 RegionAttachment.cpp \
 Skeleton.cpp \
@@ -33,6 +33,7 @@
 
 #include <spine/CCSkeleton.h>
 #include <spine/spine-cocos2dx.h>
+#include <spine/CCSkeletonDataCache.h>
 
 USING_NS_CC;
 using std::min;
@@ -60,6 +61,9 @@ Skeleton* Skeleton::createWithFile (const char* skeletonDataFile, const char* at
 
 void Skeleton::initialize () {
 	atlas = 0;
+	batchQuads = true;
+	ownsSkeletonData = false;
+	cachedSkeletonData = false;
 	debugSlots = false;
 	debugBones = false;
 	timeScale = 1;
@@ -103,20 +107,16 @@ Skeleton::Skeleton (const char* skeletonDataFile, spAtlas* aAtlas, float scale)
 Skeleton::Skeleton (const char* skeletonDataFile, const char* atlasFile, float scale) {
 	initialize();
 
-	atlas = spAtlas_readAtlasFile(atlasFile);
-	CCAssert(atlas, "Error reading atlas file.");
+	spSkeletonData* skeletonData = SkeletonDataCache::getInstance()->retainSkeletonData(skeletonDataFile, atlasFile, scale);
+	CCAssert(skeletonData, "Error reading skeleton data file.");
 
-	spSkeletonJson* json = spSkeletonJson_create(atlas);
-	json->scale = scale == 0 ? (1 / Director::getInstance()->getContentScaleFactor()) : scale;
-	spSkeletonData* skeletonData = spSkeletonJson_readSkeletonDataFile(json, skeletonDataFile);
-	CCAssert(skeletonData, json->error ? json->error : "Error reading skeleton data file.");
-	spSkeletonJson_dispose(json);
-
-	setSkeletonData(skeletonData, true);
+	setSkeletonData(skeletonData, false);
+	cachedSkeletonData = true;
 }
 
 Skeleton::~Skeleton () {
 	if (ownsSkeletonData) spSkeletonData_dispose(skeleton->data);
+	if (cachedSkeletonData) SkeletonDataCache::getInstance()->releaseSkeletonData(skeleton->data);
 	if (atlas) spAtlas_dispose(atlas);
 	spSkeleton_dispose(skeleton);
 }
@@ -127,18 +127,27 @@ void Skeleton::update (float deltaTime) {
 
 void Skeleton::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
 {
+    // the batched quads are transformed by the renderer, a custom shader would expect the model view
+    if (batchQuads && getShaderProgram() == ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR))
+    {
+        drawQuads(renderer, transform);
+
+        if (debugBones || debugSlots)
+        {
+            _customCommand.init(_globalZOrder);
+            _customCommand.func = CC_CALLBACK_0(Skeleton::onDrawDebug, this, transform);
+            renderer->addCommand(&_customCommand);
+        }
+        return;
+    }
 
     _customCommand.init(_globalZOrder);
     _customCommand.func = CC_CALLBACK_0(Skeleton::onDraw, this, transform, transformUpdated);
     renderer->addCommand(&_customCommand);
 }
-    
-void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
-{
-    getShaderProgram()->use();
-    getShaderProgram()->setUniformsForBuiltins(transform);
 
-    GL::blendFunc(blendFunc.src, blendFunc.dst);
+void Skeleton::updateSkeletonColor()
+{
 	Color3B color = getColor();
 	skeleton->r = color.r / (float)255;
 	skeleton->g = color.g / (float)255;
@@ -149,6 +158,74 @@ void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
 		skeleton->g *= skeleton->a;
 		skeleton->b *= skeleton->a;
 	}
+}
+
+void Skeleton::drawQuads(cocos2d::Renderer *renderer, const kmMat4 &transform)
+{
+	updateSkeletonColor();
+
+	// the renderer transforms the quads with the model view, like it does for sprites
+	GLProgram* shader = ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP);
+
+	// sized before the commands keep pointers to the quads
+	_quads.resize(skeleton->slotCount);
+
+	// a blend function set with setBlendFunc() replaces the one fitted to the textures
+	bool customBlendFunc = blendFunc.src != BlendFunc::ALPHA_PREMULTIPLIED.src || blendFunc.dst != BlendFunc::ALPHA_PREMULTIPLIED.dst;
+
+	ssize_t quadsCount = 0;
+	ssize_t runStart = 0;
+	size_t commandsCount = 0;
+	Texture2D* runTexture = nullptr;
+	BlendFunc runBlendFunc = BlendFunc::DISABLE;
+
+	for (int i = 0, n = skeleton->slotCount; i <= n; i++) {
+		spSlot* slot = i < n ? skeleton->drawOrder[i] : nullptr;
+		if (slot && (!slot->attachment || slot->attachment->type != ATTACHMENT_REGION)) continue;
+
+		Texture2D* texture = nullptr;
+		BlendFunc blend = BlendFunc::DISABLE;
+		if (slot) {
+			texture = getTextureAtlas((spRegionAttachment*)slot->attachment)->getTexture();
+			// same blending as setFittedBlendingFunc(), with the additive slots adding their color
+			if (customBlendFunc) blend = blendFunc;
+			else blend = texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+			if (slot->data->additiveBlending) blend.dst = GL_ONE;
+		}
+
+		// a run of quads with the same texture and blending ends
+		if (quadsCount > runStart && (!slot || texture != runTexture || blend.src != runBlendFunc.src || blend.dst != runBlendFunc.dst
+				|| quadsCount - runStart == Renderer::VBO_SIZE - 1)) {
+			if (_quadCommands.size() == commandsCount) _quadCommands.resize(commandsCount + 1);
+			_quadCommands[commandsCount++].init(_globalZOrder, runTexture->getName(), shader, runBlendFunc,
+				&_quads[runStart], quadsCount - runStart, transform);
+			runStart = quadsCount;
+		}
+		if (!slot) break;
+
+		runTexture = texture;
+		runBlendFunc = blend;
+
+		V3F_C4B_T2F_Quad& quad = _quads[quadsCount++];
+		quad.tl.vertices.z = 0;
+		quad.tr.vertices.z = 0;
+		quad.bl.vertices.z = 0;
+		quad.br.vertices.z = 0;
+		spRegionAttachment_updateQuad((spRegionAttachment*)slot->attachment, slot, &quad, premultipliedAlpha);
+	}
+
+	// added once _quadCommands doesn't grow anymore
+	for (size_t i = 0; i < commandsCount; i++)
+		renderer->addCommand(&_quadCommands[i]);
+}
+    
+void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
+{
+    getShaderProgram()->use();
+    getShaderProgram()->setUniformsForBuiltins(transform);
+
+    GL::blendFunc(blendFunc.src, blendFunc.dst);
+	updateSkeletonColor();
 
 	int additive = 0;
 	TextureAtlas* textureAtlas = 0;
@@ -175,7 +252,9 @@ void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
 			textureAtlas->removeAllQuads();
 		}
 		textureAtlas = regionTextureAtlas;
-        setFittedBlendingFunc(textureAtlas);
+        // a blend function set with setBlendFunc() replaces the one fitted to the textures
+        if (blendFunc.src == BlendFunc::ALPHA_PREMULTIPLIED.src && blendFunc.dst == BlendFunc::ALPHA_PREMULTIPLIED.dst)
+            setFittedBlendingFunc(textureAtlas);
 
 		ssize_t quadCount = textureAtlas->getTotalQuads();
 		if (textureAtlas->getCapacity() == quadCount) {
@@ -192,6 +271,11 @@ void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
 		textureAtlas->removeAllQuads();
 	}
 
+    onDrawDebug(transform);
+}
+
+void Skeleton::onDrawDebug(const kmMat4 &transform)
+{
     if(debugBones || debugSlots) {
         kmGLPushMatrix();
         kmGLLoadMatrix(&transform);
@@ -40,6 +40,8 @@
 #include "CCProtocols.h"
 #include "CCTextureAtlas.h"
 #include "renderer/CCCustomCommand.h"
+#include "renderer/CCQuadCommand.h"
+#include <vector>
 
 namespace spine {
 
@@ -54,6 +56,11 @@ public:
 	bool debugSlots;
 	bool debugBones;
 	bool premultipliedAlpha;
+	/* Emits the region quads as QuadCommands, one per run of slots with the same atlas page and blending,
+	 * so that the Renderer batches them with the skeletons and sprites drawn before and after. True by default.
+	 * When false, or when a custom shader is set with setShaderProgram(), the skeleton is drawn by a CustomCommand
+	 * with its TextureAtlases. A blend function set with setBlendFunc() is used in both cases. */
+	bool batchQuads;
     cocos2d::BlendFunc blendFunc;
 
 	static Skeleton* createWithData (spSkeletonData* skeletonData, bool ownsSkeletonData = false);
@@ -62,6 +69,8 @@ public:
 
 	Skeleton (spSkeletonData* skeletonData, bool ownsSkeletonData = false);
 	Skeleton (const char* skeletonDataFile, spAtlas* atlas, float scale = 0);
+	/* The skeleton data and the atlas are shared with the other skeletons created from the same files,
+	 * see SkeletonDataCache. */
 	Skeleton (const char* skeletonDataFile, const char* atlasFile, float scale = 0);
 
 	virtual ~Skeleton ();
@@ -69,6 +78,7 @@ public:
 	virtual void update (float deltaTime) override;
 	virtual void draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated) override;
     void onDraw(const kmMat4 &transform, bool transformUpdated);
+    void onDrawDebug(const kmMat4 &transform);
 	void onEnter() override;
 	void onExit() override;
 	virtual cocos2d::Rect getBoundingBox () const override;
@@ -106,12 +116,23 @@ protected:
 
 private:
 	bool ownsSkeletonData;
+	// retained from the SkeletonDataCache
+	bool cachedSkeletonData;
 	spAtlas* atlas;
 	void initialize ();
     // Util function that setting blend-function by nextRenderedTexture's premultiplied flag
     void setFittedBlendingFunc(cocos2d::TextureAtlas * nextRenderedTexture);
+    // Sets the color of the skeleton from the color and opacity of the node
+    void updateSkeletonColor();
+    // Adds the QuadCommands of the region attachments
+    void drawQuads(cocos2d::Renderer *renderer, const kmMat4 &transform);
     
     cocos2d::CustomCommand _customCommand;    
+
+    // quads of the region attachments, in draw order
+    std::vector<cocos2d::V3F_C4B_T2F_Quad> _quads;
+    // one per run of quads with the same texture and blending
+    std::vector<cocos2d::QuadCommand> _quadCommands;
 };
 
 }
@@ -42,8 +42,14 @@ using std::vector;
 
 namespace spine {
 
-static void callback (spAnimationState* state, int trackIndex, spEventType type, spEvent* event, int loopCount) {
-	((SkeletonAnimation*)state->context)->onAnimationStateEvent(trackIndex, type, event, loopCount);
+void SkeletonAnimation::callback (spAnimationState* state, int trackIndex, spEventType type, spEvent* event, int loopCount) {
+	SkeletonAnimation* node = (SkeletonAnimation*)state->context;
+	if (node->queueEvents) {
+		QueuedEvent queued = {trackIndex, type, event, loopCount};
+		node->queuedEvents.push_back(queued);
+		return;
+	}
+	node->onAnimationStateEvent(trackIndex, type, event, loopCount);
 }
 
 SkeletonAnimation* SkeletonAnimation::createWithData (spSkeletonData* skeletonData) {
@@ -68,6 +74,9 @@ void SkeletonAnimation::initialize () {
 	listenerInstance = 0;
 	listenerMethod = 0;
 
+	poseDelta = 0;
+	queueEvents = false;
+
 	ownsAnimationStateData = true;
 	state = spAnimationState_create(spAnimationStateData_create(skeleton->data));
 	state->context = this;
@@ -97,12 +106,47 @@ SkeletonAnimation::~SkeletonAnimation () {
 void SkeletonAnimation::update (float deltaTime) {
 	super::update(deltaTime);
 
-	deltaTime *= timeScale;
-	spAnimationState_update(state, deltaTime);
+	poseDelta = deltaTime * timeScale;
+	if (PoseBatch::getInstance()->addJob(this, this)) return;
+
+	// Not batched: the listeners are called while the state is updated, as they always were.
+	applyPose();
+}
+
+bool SkeletonAnimation::isPoseThreadSafe () const {
+	// The listeners of the track entries are called by spAnimationState_update/apply, they can't be queued.
+	for (int i = 0; i < state->trackCount; ++i) {
+		for (spTrackEntry* entry = state->tracks[i]; entry; entry = entry->next) {
+			if (entry->listener || (entry->previous && entry->previous->listener)) return false;
+		}
+	}
+	return true;
+}
+
+void SkeletonAnimation::evaluatePose () {
+	// Only a thread safe pose is evaluated on a worker, its events wait for mergePose(). Otherwise the PoseBatch
+	// evaluates it on the main thread and the listeners are called right away, in their usual order.
+	queueEvents = isPoseThreadSafe();
+	applyPose();
+	queueEvents = false;
+}
+
+void SkeletonAnimation::applyPose () {
+	spAnimationState_update(state, poseDelta);
 	spAnimationState_apply(state, skeleton);
 	spSkeleton_updateWorldTransform(skeleton);
 }
 
+void SkeletonAnimation::mergePose () {
+	if (queuedEvents.empty()) return;
+
+	// The listener may update this skeleton again, which queues new events.
+	std::vector<QueuedEvent> events;
+	events.swap(queuedEvents);
+	for (const QueuedEvent& queued : events)
+		onAnimationStateEvent(queued.trackIndex, queued.type, queued.event, queued.loopCount);
+}
+
 void SkeletonAnimation::setAnimationStateData (spAnimationStateData* stateData) {
 	CCAssert(stateData, "stateData cannot be null.");
 
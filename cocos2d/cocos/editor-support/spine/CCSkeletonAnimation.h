@@ -36,6 +36,8 @@
 
 #include <spine/spine.h>
 #include <spine/CCSkeleton.h>
+#include "CCPoseBatch.h"
+#include <vector>
 
 namespace spine {
 
@@ -44,8 +46,13 @@ typedef void (cocos2d::Ref::*SEL_AnimationStateEvent)(spine::SkeletonAnimation*
 #define animationStateEvent_selector(_SELECTOR) (SEL_AnimationStateEvent)(&_SELECTOR)
 
 /** Draws an animated skeleton, providing an AnimationState for applying one or more animations and queuing animations to be
-  * played later. */
-class SkeletonAnimation: public Skeleton {
+  * played later.
+  *
+  * When the cocos2d::PoseBatch is enabled, update() only queues the animation state update and the world transform of the
+  * bones, which are evaluated with the other skeletons at the end of the update phase. When the pose is evaluated on a worker
+  * thread, the listener is then called from mergePose(), on the main thread. Otherwise it is called while the animation state
+  * is updated, as when the PoseBatch is disabled. */
+class SkeletonAnimation: public Skeleton, public cocos2d::PoseJob {
 public:
 	spAnimationState* state;
 
@@ -73,6 +80,10 @@ public:
 
 	virtual void onAnimationStateEvent (int trackIndex, spEventType type, spEvent* event, int loopCount);
 
+	virtual bool isPoseThreadSafe () const override;
+	virtual void evaluatePose () override;
+	virtual void mergePose () override;
+
 protected:
 	SkeletonAnimation ();
 
@@ -82,7 +93,19 @@ private:
 	SEL_AnimationStateEvent listenerMethod;
 	bool ownsAnimationStateData;
 
+	struct QueuedEvent {
+		int trackIndex;
+		spEventType type;
+		spEvent* event;
+		int loopCount;
+	};
+	float poseDelta;
+	bool queueEvents;
+	std::vector<QueuedEvent> queuedEvents;
+
 	void initialize ();
+	void applyPose ();
+	static void callback (spAnimationState* state, int trackIndex, spEventType type, spEvent* event, int loopCount);
 };
 
 }
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Spine Runtime Software License - Version 1.1
+ * 
+ * Copyright (c) 2013, Esoteric Software
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms in whole or in part, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. A Spine Essential, Professional, Enterprise, or Education License must
+ *    be purchased from Esoteric Software and the license must remain valid:
+ *    http://esotericsoftware.com/
+ * 2. Redistributions of source code must retain this license, which is the
+ *    above copyright notice, this declaration of conditions and the following
+ *    disclaimer.
+ * 3. Redistributions in binary form must reproduce this license, which is the
+ *    above copyright notice, this declaration of conditions and the following
+ *    disclaimer, in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/CCSkeletonDataCache.h>
+#include <spine/spine-cocos2dx.h>
+#include <thread>
+
+USING_NS_CC;
+
+namespace spine {
+
+static SkeletonDataCache* instance = nullptr;
+
+SkeletonDataCache* SkeletonDataCache::getInstance () {
+	if (!instance) instance = new SkeletonDataCache();
+	return instance;
+}
+
+void SkeletonDataCache::destroyInstance () {
+	CC_SAFE_DELETE(instance);
+}
+
+SkeletonDataCache::SkeletonDataCache () {
+}
+
+SkeletonDataCache::~SkeletonDataCache () {
+	for (auto& entry : skeletonDataEntries)
+		spSkeletonData_dispose(entry.second.skeletonData);
+	for (auto& entry : atlasEntries)
+		spAtlas_dispose(entry.second.atlas);
+}
+
+float SkeletonDataCache::getScale (float scale) const {
+	return scale == 0 ? (1 / Director::getInstance()->getContentScaleFactor()) : scale;
+}
+
+std::string SkeletonDataCache::getKey (const char* skeletonDataFile, const char* atlasFile, float scale) const {
+	return StringUtils::format("%s|%s|%g", skeletonDataFile, atlasFile, scale);
+}
+
+spAtlas* SkeletonDataCache::retainAtlas (const std::string& atlasFile) {
+	auto iter = atlasEntries.find(atlasFile);
+	if (iter != atlasEntries.end()) {
+		iter->second.referenceCount++;
+		return iter->second.atlas;
+	}
+
+	spAtlas* atlas = spAtlas_readAtlasFile(atlasFile.c_str());
+	if (!atlas) {
+		CCLOG("spine: SkeletonDataCache: Error reading atlas file %s.", atlasFile.c_str());
+		return 0;
+	}
+
+	AtlasEntry entry = {atlas, 1};
+	atlasEntries[atlasFile] = entry;
+	return atlas;
+}
+
+void SkeletonDataCache::releaseAtlas (const std::string& atlasFile) {
+	auto iter = atlasEntries.find(atlasFile);
+	if (iter == atlasEntries.end()) return;
+
+	// the atlases are only kept for the skeleton data that use them
+	if (--iter->second.referenceCount == 0) {
+		spAtlas_dispose(iter->second.atlas);
+		atlasEntries.erase(iter);
+	}
+}
+
+void SkeletonDataCache::addSkeletonData (const std::string& key, spSkeletonData* skeletonData, const std::string& atlasFile) {
+	SkeletonDataEntry entry = {skeletonData, atlasFile, 0};
+	skeletonDataEntries[key] = entry;
+	skeletonDataKeys[skeletonData] = key;
+}
+
+spSkeletonData* SkeletonDataCache::retainSkeletonData (const char* skeletonDataFile, const char* atlasFile, float scale) {
+	scale = getScale(scale);
+	std::string key = getKey(skeletonDataFile, atlasFile, scale);
+
+	auto iter = skeletonDataEntries.find(key);
+	if (iter == skeletonDataEntries.end()) {
+		spAtlas* atlas = retainAtlas(atlasFile);
+		if (!atlas) return 0;
+
+		spSkeletonJson* json = spSkeletonJson_create(atlas);
+		json->scale = scale;
+		spSkeletonData* skeletonData = spSkeletonJson_readSkeletonDataFile(json, skeletonDataFile);
+		if (!skeletonData) {
+			CCLOG("spine: SkeletonDataCache: %s", json->error ? json->error : "Error reading skeleton data file.");
+			spSkeletonJson_dispose(json);
+			releaseAtlas(atlasFile);
+			return 0;
+		}
+		spSkeletonJson_dispose(json);
+
+		addSkeletonData(key, skeletonData, atlasFile);
+		iter = skeletonDataEntries.find(key);
+	}
+
+	iter->second.referenceCount++;
+	return iter->second.skeletonData;
+}
+
+void SkeletonDataCache::releaseSkeletonData (spSkeletonData* skeletonData) {
+	auto keyIter = skeletonDataKeys.find(skeletonData);
+	CCASSERT(keyIter != skeletonDataKeys.end(), "SkeletonDataCache: the skeleton data isn't in the cache");
+	if (keyIter == skeletonDataKeys.end()) return;
+
+	SkeletonDataEntry& entry = skeletonDataEntries[keyIter->second];
+	CCASSERT(entry.referenceCount > 0, "SkeletonDataCache: the skeleton data was released too many times");
+	entry.referenceCount--;
+}
+
+void SkeletonDataCache::preloadSkeletonDataAsync (const char* skeletonDataFile, const char* atlasFile, float scale,
+		const std::function<void(spSkeletonData*)>& callback) {
+	scale = getScale(scale);
+	std::string key = getKey(skeletonDataFile, atlasFile, scale);
+
+	auto iter = skeletonDataEntries.find(key);
+	if (iter != skeletonDataEntries.end()) {
+		if (callback) callback(iter->second.skeletonData);
+		return;
+	}
+
+	// The atlas creates the textures of its pages, so it is loaded in the cocos2d thread.
+	// It is retained until the skeleton data is added to the cache.
+	spAtlas* atlas = retainAtlas(atlasFile);
+	if (!atlas) {
+		if (callback) callback(0);
+		return;
+	}
+
+	std::string path = skeletonDataFile;
+	std::string atlasPath = atlasFile;
+	std::thread([=] () {
+		spSkeletonJson* json = spSkeletonJson_create(atlas);
+		json->scale = scale;
+		spSkeletonData* skeletonData = spSkeletonJson_readSkeletonDataFile(json, path.c_str());
+		if (!skeletonData) CCLOG("spine: SkeletonDataCache: %s", json->error ? json->error : "Error reading skeleton data file.");
+		spSkeletonJson_dispose(json);
+
+		Director::getInstance()->getScheduler()->performFunctionInCocosThread([=] () {
+			SkeletonDataCache* cache = SkeletonDataCache::getInstance();
+			spSkeletonData* result = skeletonData;
+
+			auto iter = cache->skeletonDataEntries.find(key);
+			if (iter != cache->skeletonDataEntries.end()) {
+				// loaded synchronously, or preloaded twice, in the meantime
+				if (skeletonData) spSkeletonData_dispose(skeletonData);
+				cache->releaseAtlas(atlasPath);
+				result = iter->second.skeletonData;
+			} else if (skeletonData) {
+				cache->addSkeletonData(key, skeletonData, atlasPath);
+			} else {
+				cache->releaseAtlas(atlasPath);
+			}
+
+			if (callback) callback(result);
+		});
+	}).detach();
+}
+
+void SkeletonDataCache::removeUnusedSkeletonData () {
+	for (auto iter = skeletonDataEntries.begin(); iter != skeletonDataEntries.end(); ) {
+		SkeletonDataEntry& entry = iter->second;
+		if (entry.referenceCount == 0) {
+			skeletonDataKeys.erase(entry.skeletonData);
+			spSkeletonData_dispose(entry.skeletonData);
+			std::string atlasFile = entry.atlasFile;
+			iter = skeletonDataEntries.erase(iter);
+			releaseAtlas(atlasFile);
+		} else {
+			++iter;
+		}
+	}
+}
+
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Spine Runtime Software License - Version 1.1
+ * 
+ * Copyright (c) 2013, Esoteric Software
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms in whole or in part, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. A Spine Essential, Professional, Enterprise, or Education License must
+ *    be purchased from Esoteric Software and the license must remain valid:
+ *    http://esotericsoftware.com/
+ * 2. Redistributions of source code must retain this license, which is the
+ *    above copyright notice, this declaration of conditions and the following
+ *    disclaimer.
+ * 3. Redistributions in binary form must reproduce this license, which is the
+ *    above copyright notice, this declaration of conditions and the following
+ *    disclaimer, in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_CCSKELETONDATACACHE_H_
+#define SPINE_CCSKELETONDATACACHE_H_
+
+#include <spine/spine.h>
+
+#include <string>
+#include <unordered_map>
+#include <functional>
+
+namespace spine {
+
+/** Shares the immutable skeleton data and atlases between the skeletons created from the same files.
+  * The JSON file is parsed once, and every Skeleton instance only creates its own spSkeleton.
+  * The data stays in the cache when it isn't used anymore, until removeUnusedSkeletonData() is called. */
+class SkeletonDataCache {
+public:
+	static SkeletonDataCache* getInstance ();
+	static void destroyInstance ();
+
+	/* Returns the skeleton data of the files, parsing them if they are not in the cache, and increases its reference count.
+	 * Returns 0 if the files could not be read. */
+	spSkeletonData* retainSkeletonData (const char* skeletonDataFile, const char* atlasFile, float scale = 0);
+	/* Decreases the reference count of skeleton data returned by retainSkeletonData(). */
+	void releaseSkeletonData (spSkeletonData* skeletonData);
+
+	/* Loads the atlas and parses the skeleton data in another thread, and adds them to the cache without retaining them.
+	 * The callback is called in the cocos2d thread with the skeleton data, or 0 if the files could not be read. */
+	void preloadSkeletonDataAsync (const char* skeletonDataFile, const char* atlasFile, float scale,
+		const std::function<void(spSkeletonData*)>& callback = nullptr);
+
+	/* Disposes the skeleton data and the atlases that no skeleton uses. */
+	void removeUnusedSkeletonData ();
+
+	/* Returns the number of skeleton data in the cache. */
+	size_t getSkeletonDataCount () const { return skeletonDataEntries.size(); }
+
+private:
+	SkeletonDataCache ();
+	~SkeletonDataCache ();
+
+	struct AtlasEntry {
+		spAtlas* atlas;
+		int referenceCount;
+	};
+
+	struct SkeletonDataEntry {
+		spSkeletonData* skeletonData;
+		std::string atlasFile;
+		int referenceCount;
+	};
+
+	std::string getKey (const char* skeletonDataFile, const char* atlasFile, float scale) const;
+	float getScale (float scale) const;
+	spAtlas* retainAtlas (const std::string& atlasFile);
+	void releaseAtlas (const std::string& atlasFile);
+	void addSkeletonData (const std::string& key, spSkeletonData* skeletonData, const std::string& atlasFile);
+
+	std::unordered_map<std::string, AtlasEntry> atlasEntries;
+	std::unordered_map<std::string, SkeletonDataEntry> skeletonDataEntries;
+	std::unordered_map<spSkeletonData*, std::string> skeletonDataKeys;
+};
+
+}
+
+#endif /* SPINE_CCSKELETONDATACACHE_H_ */
@@ -44,7 +44,8 @@ public:
     LayoutExecutant(){};
     virtual ~LayoutExecutant(){};
     static LayoutExecutant* create();
-    virtual void doLayout(const Size& layoutSize, Vector<Node*> container){};
+    /* startIndex is the first child whose position may have changed, the children before it keep theirs */
+    virtual void doLayout(const Size& layoutSize, const Vector<Node*>& container, ssize_t startIndex){};
 };
 
 class LinearVerticalLayoutExecutant : public LayoutExecutant
@@ -53,7 +54,7 @@ public:
     LinearVerticalLayoutExecutant(){};
     virtual ~LinearVerticalLayoutExecutant(){};
     static LinearVerticalLayoutExecutant* create();
-    virtual void doLayout(const Size& layoutSize, Vector<Node*> container);
+    virtual void doLayout(const Size& layoutSize, const Vector<Node*>& container, ssize_t startIndex);
 };
 
 class LinearHorizontalLayoutExecutant : public LayoutExecutant
@@ -62,7 +63,7 @@ public:
     LinearHorizontalLayoutExecutant(){};
     virtual ~LinearHorizontalLayoutExecutant(){};
     static LinearHorizontalLayoutExecutant* create();
-    virtual void doLayout(const Size& layoutSize, Vector<Node*> container);
+    virtual void doLayout(const Size& layoutSize, const Vector<Node*>& container, ssize_t startIndex);
 };
 
 class RelativeLayoutExecutant : public LayoutExecutant
@@ -71,7 +72,9 @@ public:
     RelativeLayoutExecutant(){};
     virtual ~RelativeLayoutExecutant(){};
     static RelativeLayoutExecutant* create();
-    virtual void doLayout(const Size& layoutSize, Vector<Node*> container);
+    virtual void doLayout(const Size& layoutSize, const Vector<Node*>& container, ssize_t startIndex);
+protected:
+    void placeChild(const Size& layoutSize, Widget* child, RelativeLayoutParameter* layoutParameter, Widget* relativeWidget, RelativeLayoutParameter* relativeWidgetLP);
 };
     
 LayoutExecutant* LayoutExecutant::create()
@@ -122,13 +125,25 @@ RelativeLayoutExecutant* RelativeLayoutExecutant::create()
     return nullptr;
 }
     
-void LinearVerticalLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, Vector<cocos2d::Node *> container)
+void LinearVerticalLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, const Vector<cocos2d::Node *>& container, ssize_t startIndex)
 {
     float topBoundary = layoutSize.height;
     
-    for (auto& subWidget : container)
+    // continue below the last child which is already in place
+    for (ssize_t i = startIndex - 1; i >= 0; i--)
     {
-        Widget* child = dynamic_cast<Widget*>(subWidget);
+        Widget* child = dynamic_cast<Widget*>(container.at(i));
+        LinearLayoutParameter* layoutParameter = child ? dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_LINEAR)) : nullptr;
+        if (layoutParameter)
+        {
+            topBoundary = child->getBottomInParent() - layoutParameter->getMargin().bottom;
+            break;
+        }
+    }
+    
+    for (ssize_t i = startIndex; i < container.size(); i++)
+    {
+        Widget* child = dynamic_cast<Widget*>(container.at(i));
         if (child)
         {
             LinearLayoutParameter* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_LINEAR));
@@ -164,12 +179,25 @@ void LinearVerticalLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, Ve
     }
 }
     
-void LinearHorizontalLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, Vector<cocos2d::Node *> container)
+void LinearHorizontalLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, const Vector<cocos2d::Node *>& container, ssize_t startIndex)
 {
     float leftBoundary = 0.0f;
-    for (auto& subWidget : container)
+    
+    // continue right of the last child which is already in place
+    for (ssize_t i = startIndex - 1; i >= 0; i--)
     {
-        Widget* child = dynamic_cast<Widget*>(subWidget);
+        Widget* child = dynamic_cast<Widget*>(container.at(i));
+        LinearLayoutParameter* layoutParameter = child ? dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_LINEAR)) : nullptr;
+        if (layoutParameter)
+        {
+            leftBoundary = child->getRightInParent() + layoutParameter->getMargin().right;
+            break;
+        }
+    }
+    
+    for (ssize_t i = startIndex; i < container.size(); i++)
+    {
+        Widget* child = dynamic_cast<Widget*>(container.at(i));
         if (child)
         {
             LinearLayoutParameter* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_LINEAR));
@@ -204,359 +232,334 @@ void LinearHorizontalLayoutExecutant::doLayout(const cocos2d::Size &layoutSize,
     }
 }
 
-void RelativeLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, Vector<cocos2d::Node *> container)
+void RelativeLayoutExecutant::doLayout(const cocos2d::Size &layoutSize, const Vector<cocos2d::Node *>& container, ssize_t startIndex)
 {
-    ssize_t unlayoutChildCount = 0;
-    Vector<Widget*> widgetChildren;
+    // a relative child may depend on any sibling, so every child is placed again
+    std::vector<Widget*> widgetChildren;
+    std::vector<RelativeLayoutParameter*> layoutParameters;
+    std::unordered_map<std::string, ssize_t> relativeNames;
     for (auto& subWidget : container)
     {
         Widget* child = dynamic_cast<Widget*>(subWidget);
         if (child)
         {
             RelativeLayoutParameter* layoutParameter = dynamic_cast<RelativeLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_RELATIVE));
-            layoutParameter->_put = false;
-            unlayoutChildCount++;
-            widgetChildren.pushBack(child);
+            if (layoutParameter)
+            {
+                layoutParameter->_put = false;
+                // the first child with a name wins
+                relativeNames.emplace(layoutParameter->getRelativeName(), widgetChildren.size());
+                widgetChildren.push_back(child);
+                layoutParameters.push_back(layoutParameter);
+            }
         }
     }
-    while (unlayoutChildCount > 0)
+    
+    // the sibling each child is placed next to, and must be placed before it
+    ssize_t count = widgetChildren.size();
+    std::vector<ssize_t> relativeIndices(count, -1);
+    std::vector<ssize_t> dependencies(count, -1);
+    for (ssize_t i = 0; i < count; i++)
     {
-        for (auto& subWidget : widgetChildren)
+        const char* relativeName = layoutParameters[i]->getRelativeToWidgetName();
+        if (relativeName && strcmp(relativeName, ""))
         {
-            Widget* child = static_cast<Widget*>(subWidget);
-            RelativeLayoutParameter* layoutParameter = dynamic_cast<RelativeLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_RELATIVE));
-            
-            if (layoutParameter)
+            auto iter = relativeNames.find(relativeName);
+            if (iter != relativeNames.end())
             {
-                if (layoutParameter->_put)
-                {
-                    continue;
-                }
-                Point ap = child->getAnchorPoint();
-                Size cs = child->getSize();
-                RelativeAlign align = layoutParameter->getAlign();
-                const char* relativeName = layoutParameter->getRelativeToWidgetName();
-                Widget* relativeWidget = nullptr;
-                RelativeLayoutParameter* relativeWidgetLP = nullptr;
-                float finalPosX = 0.0f;
-                float finalPosY = 0.0f;
-                if (relativeName && strcmp(relativeName, ""))
-                {
-                    for (auto& sWidget : widgetChildren)
-                    {
-                        if (sWidget)
-                        {
-                            RelativeLayoutParameter* rlayoutParameter = dynamic_cast<RelativeLayoutParameter*>(sWidget->getLayoutParameter(LAYOUT_PARAMETER_RELATIVE));
-                            if (rlayoutParameter && strcmp(rlayoutParameter->getRelativeName(), relativeName) == 0)
-                            {
-                                relativeWidget = sWidget;
-                                relativeWidgetLP = rlayoutParameter;
-                                break;
-                            }
-                        }
-                    }
-                }
-                switch (align)
-                {
-                    case RELATIVE_ALIGN_NONE:
-                    case RELATIVE_ALIGN_PARENT_TOP_LEFT:
-                        finalPosX = ap.x * cs.width;
-                        finalPosY = layoutSize.height - ((1.0f - ap.y) * cs.height);
-                        break;
-                    case RELATIVE_ALIGN_PARENT_TOP_CENTER_HORIZONTAL:
-                        finalPosX = layoutSize.width * 0.5f - cs.width * (0.5f - ap.x);
-                        finalPosY = layoutSize.height - ((1.0f - ap.y) * cs.height);
-                        break;
-                    case RELATIVE_ALIGN_PARENT_TOP_RIGHT:
-                        finalPosX = layoutSize.width - ((1.0f - ap.x) * cs.width);
-                        finalPosY = layoutSize.height - ((1.0f - ap.y) * cs.height);
-                        break;
-                    case RELATIVE_ALIGN_PARENT_LEFT_CENTER_VERTICAL:
-                        finalPosX = ap.x * cs.width;
-                        finalPosY = layoutSize.height * 0.5f - cs.height * (0.5f - ap.y);
-                        break;
-                    case RELATIVE_CENTER_IN_PARENT:
-                        finalPosX = layoutSize.width * 0.5f - cs.width * (0.5f - ap.x);
-                        finalPosY = layoutSize.height * 0.5f - cs.height * (0.5f - ap.y);
-                        break;
-                    case RELATIVE_ALIGN_PARENT_RIGHT_CENTER_VERTICAL:
-                        finalPosX = layoutSize.width - ((1.0f - ap.x) * cs.width);
-                        finalPosY = layoutSize.height * 0.5f - cs.height * (0.5f - ap.y);
-                        break;
-                    case RELATIVE_ALIGN_PARENT_LEFT_BOTTOM:
-                        finalPosX = ap.x * cs.width;
-                        finalPosY = ap.y * cs.height;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_BOTTOM_CENTER_HORIZONTAL:
-                        finalPosX = layoutSize.width * 0.5f - cs.width * (0.5f - ap.x);
-                        finalPosY = ap.y * cs.height;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_RIGHT_BOTTOM:
-                        finalPosX = layoutSize.width - ((1.0f - ap.x) * cs.width);
-                        finalPosY = ap.y * cs.height;
-                        break;
-                        
-                    case RELATIVE_LOCATION_ABOVE_LEFTALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationBottom = relativeWidget->getTopInParent();
-                            float locationLeft = relativeWidget->getLeftInParent();
-                            finalPosY = locationBottom + ap.y * cs.height;
-                            finalPosX = locationLeft + ap.x * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_ABOVE_CENTER:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            Size rbs = relativeWidget->getSize();
-                            float locationBottom = relativeWidget->getTopInParent();
-                            
-                            finalPosY = locationBottom + ap.y * cs.height;
-                            finalPosX = relativeWidget->getLeftInParent() + rbs.width * 0.5f + ap.x * cs.width - cs.width * 0.5f;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_ABOVE_RIGHTALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationBottom = relativeWidget->getTopInParent();
-                            float locationRight = relativeWidget->getRightInParent();
-                            finalPosY = locationBottom + ap.y * cs.height;
-                            finalPosX = locationRight - (1.0f - ap.x) * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_LEFT_OF_TOPALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationTop = relativeWidget->getTopInParent();
-                            float locationRight = relativeWidget->getLeftInParent();
-                            finalPosY = locationTop - (1.0f - ap.y) * cs.height;
-                            finalPosX = locationRight - (1.0f - ap.x) * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_LEFT_OF_CENTER:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            Size rbs = relativeWidget->getSize();
-                            float locationRight = relativeWidget->getLeftInParent();
-                            finalPosX = locationRight - (1.0f - ap.x) * cs.width;
-                            
-                            finalPosY = relativeWidget->getBottomInParent() + rbs.height * 0.5f + ap.y * cs.height - cs.height * 0.5f;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_LEFT_OF_BOTTOMALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationBottom = relativeWidget->getBottomInParent();
-                            float locationRight = relativeWidget->getLeftInParent();
-                            finalPosY = locationBottom + ap.y * cs.height;
-                            finalPosX = locationRight - (1.0f - ap.x) * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_RIGHT_OF_TOPALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationTop = relativeWidget->getTopInParent();
-                            float locationLeft = relativeWidget->getRightInParent();
-                            finalPosY = locationTop - (1.0f - ap.y) * cs.height;
-                            finalPosX = locationLeft + ap.x * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_RIGHT_OF_CENTER:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            Size rbs = relativeWidget->getSize();
-                            float locationLeft = relativeWidget->getRightInParent();
-                            finalPosX = locationLeft + ap.x * cs.width;
-                            
-                            finalPosY = relativeWidget->getBottomInParent() + rbs.height * 0.5f + ap.y * cs.height - cs.height * 0.5f;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_RIGHT_OF_BOTTOMALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationBottom = relativeWidget->getBottomInParent();
-                            float locationLeft = relativeWidget->getRightInParent();
-                            finalPosY = locationBottom + ap.y * cs.height;
-                            finalPosX = locationLeft + ap.x * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_BELOW_LEFTALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationTop = relativeWidget->getBottomInParent();
-                            float locationLeft = relativeWidget->getLeftInParent();
-                            finalPosY = locationTop - (1.0f - ap.y) * cs.height;
-                            finalPosX = locationLeft + ap.x * cs.width;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_BELOW_CENTER:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            Size rbs = relativeWidget->getSize();
-                            float locationTop = relativeWidget->getBottomInParent();
-                            
-                            finalPosY = locationTop - (1.0f - ap.y) * cs.height;
-                            finalPosX = relativeWidget->getLeftInParent() + rbs.width * 0.5f + ap.x * cs.width - cs.width * 0.5f;
-                        }
-                        break;
-                    case RELATIVE_LOCATION_BELOW_RIGHTALIGN:
-                        if (relativeWidget)
-                        {
-                            if (relativeWidgetLP && !relativeWidgetLP->_put)
-                            {
-                                continue;
-                            }
-                            float locationTop = relativeWidget->getBottomInParent();
-                            float locationRight = relativeWidget->getRightInParent();
-                            finalPosY = locationTop - (1.0f - ap.y) * cs.height;
-                            finalPosX = locationRight - (1.0f - ap.x) * cs.width;
-                        }
-                        break;
-                    default:
-                        break;
-                }
-                Margin relativeWidgetMargin;
-                Margin mg = layoutParameter->getMargin();
-                if (relativeWidgetLP)
+                relativeIndices[i] = iter->second;
+                if (layoutParameters[i]->getAlign() >= RELATIVE_LOCATION_ABOVE_LEFTALIGN)
                 {
-                    relativeWidgetMargin = relativeWidgetLP->getMargin();
+                    dependencies[i] = iter->second;
                 }
-                //handle margin
-                switch (align)
-                {
-                    case RELATIVE_ALIGN_NONE:
-                    case RELATIVE_ALIGN_PARENT_TOP_LEFT:
-                        finalPosX += mg.left;
-                        finalPosY -= mg.top;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_TOP_CENTER_HORIZONTAL:
-                        finalPosY -= mg.top;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_TOP_RIGHT:
-                        finalPosX -= mg.right;
-                        finalPosY -= mg.top;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_LEFT_CENTER_VERTICAL:
-                        finalPosX += mg.left;
-                        break;
-                    case RELATIVE_CENTER_IN_PARENT:
-                        break;
-                    case RELATIVE_ALIGN_PARENT_RIGHT_CENTER_VERTICAL:
-                        finalPosX -= mg.right;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_LEFT_BOTTOM:
-                        finalPosX += mg.left;
-                        finalPosY += mg.bottom;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_BOTTOM_CENTER_HORIZONTAL:
-                        finalPosY += mg.bottom;
-                        break;
-                    case RELATIVE_ALIGN_PARENT_RIGHT_BOTTOM:
-                        finalPosX -= mg.right;
-                        finalPosY += mg.bottom;
-                        break;
-                        
-                    case RELATIVE_LOCATION_ABOVE_LEFTALIGN:
-                        finalPosY += mg.bottom;
-                        finalPosX += mg.left;
-                        break;
-                    case RELATIVE_LOCATION_ABOVE_RIGHTALIGN:
-                        finalPosY += mg.bottom;
-                        finalPosX -= mg.right;
-                        break;
-                    case RELATIVE_LOCATION_ABOVE_CENTER:
-                        finalPosY += mg.bottom;
-                        break;
-                        
-                    case RELATIVE_LOCATION_LEFT_OF_TOPALIGN:
-                        finalPosX -= mg.right;
-                        finalPosY -= mg.top;
-                        break;
-                    case RELATIVE_LOCATION_LEFT_OF_BOTTOMALIGN:
-                        finalPosX -= mg.right;
-                        finalPosY += mg.bottom;
-                        break;
-                    case RELATIVE_LOCATION_LEFT_OF_CENTER:
-                        finalPosX -= mg.right;
-                        break;
-                        
-                    case RELATIVE_LOCATION_RIGHT_OF_TOPALIGN:
-                        finalPosX += mg.left;
-                        finalPosY -= mg.top;
-                        break;
-                    case RELATIVE_LOCATION_RIGHT_OF_BOTTOMALIGN:
-                        finalPosX += mg.left;
-                        finalPosY += mg.bottom;
-                        break;
-                    case RELATIVE_LOCATION_RIGHT_OF_CENTER:
-                        finalPosX += mg.left;
-                        break;
-                        
-                    case RELATIVE_LOCATION_BELOW_LEFTALIGN:
-                        finalPosY -= mg.top;
-                        finalPosX += mg.left;
-                        break;
-                    case RELATIVE_LOCATION_BELOW_RIGHTALIGN:
-                        finalPosY -= mg.top;
-                        finalPosX -= mg.right;
-                        break;
-                    case RELATIVE_LOCATION_BELOW_CENTER:
-                        finalPosY -= mg.top;
-                        break;
-                    default:
-                        break;
-                }
-                child->setPosition(Point(finalPosX, finalPosY));
-                layoutParameter->_put = true;
-                unlayoutChildCount--;
             }
         }
     }
-    widgetChildren.clear();
+    
+    // place every chain of dependencies from its end
+    std::vector<ssize_t> chain;
+    std::vector<bool> chained(count, false);
+    for (ssize_t i = 0; i < count; i++)
+    {
+        ssize_t index = i;
+        while (index >= 0 && !layoutParameters[index]->_put)
+        {
+            if (chained[index])
+            {
+                CCLOG("Relative layout of widget '%s' depends on itself", layoutParameters[index]->getRelativeName());
+                break;
+            }
+            chain.push_back(index);
+            chained[index] = true;
+            index = dependencies[index];
+        }
+        while (!chain.empty())
+        {
+            ssize_t childIndex = chain.back();
+            chain.pop_back();
+            chained[childIndex] = false;
+            Widget* relativeWidget = relativeIndices[childIndex] >= 0 ? widgetChildren[relativeIndices[childIndex]] : nullptr;
+            RelativeLayoutParameter* relativeWidgetLP = relativeIndices[childIndex] >= 0 ? layoutParameters[relativeIndices[childIndex]] : nullptr;
+            placeChild(layoutSize, widgetChildren[childIndex], layoutParameters[childIndex], relativeWidget, relativeWidgetLP);
+        }
+    }
+}
+
+void RelativeLayoutExecutant::placeChild(const Size& layoutSize, Widget* child, RelativeLayoutParameter* layoutParameter, Widget* relativeWidget, RelativeLayoutParameter* relativeWidgetLP)
+{
+    Point ap = child->getAnchorPoint();
+    Size cs = child->getSize();
+    RelativeAlign align = layoutParameter->getAlign();
+    float finalPosX = 0.0f;
+    float finalPosY = 0.0f;
+    switch (align)
+    {
+        case RELATIVE_ALIGN_NONE:
+        case RELATIVE_ALIGN_PARENT_TOP_LEFT:
+            finalPosX = ap.x * cs.width;
+            finalPosY = layoutSize.height - ((1.0f - ap.y) * cs.height);
+            break;
+        case RELATIVE_ALIGN_PARENT_TOP_CENTER_HORIZONTAL:
+            finalPosX = layoutSize.width * 0.5f - cs.width * (0.5f - ap.x);
+            finalPosY = layoutSize.height - ((1.0f - ap.y) * cs.height);
+            break;
+        case RELATIVE_ALIGN_PARENT_TOP_RIGHT:
+            finalPosX = layoutSize.width - ((1.0f - ap.x) * cs.width);
+            finalPosY = layoutSize.height - ((1.0f - ap.y) * cs.height);
+            break;
+        case RELATIVE_ALIGN_PARENT_LEFT_CENTER_VERTICAL:
+            finalPosX = ap.x * cs.width;
+            finalPosY = layoutSize.height * 0.5f - cs.height * (0.5f - ap.y);
+            break;
+        case RELATIVE_CENTER_IN_PARENT:
+            finalPosX = layoutSize.width * 0.5f - cs.width * (0.5f - ap.x);
+            finalPosY = layoutSize.height * 0.5f - cs.height * (0.5f - ap.y);
+            break;
+        case RELATIVE_ALIGN_PARENT_RIGHT_CENTER_VERTICAL:
+            finalPosX = layoutSize.width - ((1.0f - ap.x) * cs.width);
+            finalPosY = layoutSize.height * 0.5f - cs.height * (0.5f - ap.y);
+            break;
+        case RELATIVE_ALIGN_PARENT_LEFT_BOTTOM:
+            finalPosX = ap.x * cs.width;
+            finalPosY = ap.y * cs.height;
+            break;
+        case RELATIVE_ALIGN_PARENT_BOTTOM_CENTER_HORIZONTAL:
+            finalPosX = layoutSize.width * 0.5f - cs.width * (0.5f - ap.x);
+            finalPosY = ap.y * cs.height;
+            break;
+        case RELATIVE_ALIGN_PARENT_RIGHT_BOTTOM:
+            finalPosX = layoutSize.width - ((1.0f - ap.x) * cs.width);
+            finalPosY = ap.y * cs.height;
+            break;
+            
+        case RELATIVE_LOCATION_ABOVE_LEFTALIGN:
+            if (relativeWidget)
+            {
+                float locationBottom = relativeWidget->getTopInParent();
+                float locationLeft = relativeWidget->getLeftInParent();
+                finalPosY = locationBottom + ap.y * cs.height;
+                finalPosX = locationLeft + ap.x * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_ABOVE_CENTER:
+            if (relativeWidget)
+            {
+                Size rbs = relativeWidget->getSize();
+                float locationBottom = relativeWidget->getTopInParent();
+                
+                finalPosY = locationBottom + ap.y * cs.height;
+                finalPosX = relativeWidget->getLeftInParent() + rbs.width * 0.5f + ap.x * cs.width - cs.width * 0.5f;
+            }
+            break;
+        case RELATIVE_LOCATION_ABOVE_RIGHTALIGN:
+            if (relativeWidget)
+            {
+                float locationBottom = relativeWidget->getTopInParent();
+                float locationRight = relativeWidget->getRightInParent();
+                finalPosY = locationBottom + ap.y * cs.height;
+                finalPosX = locationRight - (1.0f - ap.x) * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_LEFT_OF_TOPALIGN:
+            if (relativeWidget)
+            {
+                float locationTop = relativeWidget->getTopInParent();
+                float locationRight = relativeWidget->getLeftInParent();
+                finalPosY = locationTop - (1.0f - ap.y) * cs.height;
+                finalPosX = locationRight - (1.0f - ap.x) * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_LEFT_OF_CENTER:
+            if (relativeWidget)
+            {
+                Size rbs = relativeWidget->getSize();
+                float locationRight = relativeWidget->getLeftInParent();
+                finalPosX = locationRight - (1.0f - ap.x) * cs.width;
+                
+                finalPosY = relativeWidget->getBottomInParent() + rbs.height * 0.5f + ap.y * cs.height - cs.height * 0.5f;
+            }
+            break;
+        case RELATIVE_LOCATION_LEFT_OF_BOTTOMALIGN:
+            if (relativeWidget)
+            {
+                float locationBottom = relativeWidget->getBottomInParent();
+                float locationRight = relativeWidget->getLeftInParent();
+                finalPosY = locationBottom + ap.y * cs.height;
+                finalPosX = locationRight - (1.0f - ap.x) * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_RIGHT_OF_TOPALIGN:
+            if (relativeWidget)
+            {
+                float locationTop = relativeWidget->getTopInParent();
+                float locationLeft = relativeWidget->getRightInParent();
+                finalPosY = locationTop - (1.0f - ap.y) * cs.height;
+                finalPosX = locationLeft + ap.x * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_RIGHT_OF_CENTER:
+            if (relativeWidget)
+            {
+                Size rbs = relativeWidget->getSize();
+                float locationLeft = relativeWidget->getRightInParent();
+                finalPosX = locationLeft + ap.x * cs.width;
+                
+                finalPosY = relativeWidget->getBottomInParent() + rbs.height * 0.5f + ap.y * cs.height - cs.height * 0.5f;
+            }
+            break;
+        case RELATIVE_LOCATION_RIGHT_OF_BOTTOMALIGN:
+            if (relativeWidget)
+            {
+                float locationBottom = relativeWidget->getBottomInParent();
+                float locationLeft = relativeWidget->getRightInParent();
+                finalPosY = locationBottom + ap.y * cs.height;
+                finalPosX = locationLeft + ap.x * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_BELOW_LEFTALIGN:
+            if (relativeWidget)
+            {
+                float locationTop = relativeWidget->getBottomInParent();
+                float locationLeft = relativeWidget->getLeftInParent();
+                finalPosY = locationTop - (1.0f - ap.y) * cs.height;
+                finalPosX = locationLeft + ap.x * cs.width;
+            }
+            break;
+        case RELATIVE_LOCATION_BELOW_CENTER:
+            if (relativeWidget)
+            {
+                Size rbs = relativeWidget->getSize();
+                float locationTop = relativeWidget->getBottomInParent();
+                
+                finalPosY = locationTop - (1.0f - ap.y) * cs.height;
+                finalPosX = relativeWidget->getLeftInParent() + rbs.width * 0.5f + ap.x * cs.width - cs.width * 0.5f;
+            }
+            break;
+        case RELATIVE_LOCATION_BELOW_RIGHTALIGN:
+            if (relativeWidget)
+            {
+                float locationTop = relativeWidget->getBottomInParent();
+                float locationRight = relativeWidget->getRightInParent();
+                finalPosY = locationTop - (1.0f - ap.y) * cs.height;
+                finalPosX = locationRight - (1.0f - ap.x) * cs.width;
+            }
+            break;
+        default:
+            break;
+    }
+    Margin relativeWidgetMargin;
+    Margin mg = layoutParameter->getMargin();
+    if (relativeWidgetLP)
+    {
+        relativeWidgetMargin = relativeWidgetLP->getMargin();
+    }
+    //handle margin
+    switch (align)
+    {
+        case RELATIVE_ALIGN_NONE:
+        case RELATIVE_ALIGN_PARENT_TOP_LEFT:
+            finalPosX += mg.left;
+            finalPosY -= mg.top;
+            break;
+        case RELATIVE_ALIGN_PARENT_TOP_CENTER_HORIZONTAL:
+            finalPosY -= mg.top;
+            break;
+        case RELATIVE_ALIGN_PARENT_TOP_RIGHT:
+            finalPosX -= mg.right;
+            finalPosY -= mg.top;
+            break;
+        case RELATIVE_ALIGN_PARENT_LEFT_CENTER_VERTICAL:
+            finalPosX += mg.left;
+            break;
+        case RELATIVE_CENTER_IN_PARENT:
+            break;
+        case RELATIVE_ALIGN_PARENT_RIGHT_CENTER_VERTICAL:
+            finalPosX -= mg.right;
+            break;
+        case RELATIVE_ALIGN_PARENT_LEFT_BOTTOM:
+            finalPosX += mg.left;
+            finalPosY += mg.bottom;
+            break;
+        case RELATIVE_ALIGN_PARENT_BOTTOM_CENTER_HORIZONTAL:
+            finalPosY += mg.bottom;
+            break;
+        case RELATIVE_ALIGN_PARENT_RIGHT_BOTTOM:
+            finalPosX -= mg.right;
+            finalPosY += mg.bottom;
+            break;
+            
+        case RELATIVE_LOCATION_ABOVE_LEFTALIGN:
+            finalPosY += mg.bottom;
+            finalPosX += mg.left;
+            break;
+        case RELATIVE_LOCATION_ABOVE_RIGHTALIGN:
+            finalPosY += mg.bottom;
+            finalPosX -= mg.right;
+            break;
+        case RELATIVE_LOCATION_ABOVE_CENTER:
+            finalPosY += mg.bottom;
+            break;
+            
+        case RELATIVE_LOCATION_LEFT_OF_TOPALIGN:
+            finalPosX -= mg.right;
+            finalPosY -= mg.top;
+            break;
+        case RELATIVE_LOCATION_LEFT_OF_BOTTOMALIGN:
+            finalPosX -= mg.right;
+            finalPosY += mg.bottom;
+            break;
+        case RELATIVE_LOCATION_LEFT_OF_CENTER:
+            finalPosX -= mg.right;
+            break;
+            
+        case RELATIVE_LOCATION_RIGHT_OF_TOPALIGN:
+            finalPosX += mg.left;
+            finalPosY -= mg.top;
+            break;
+        case RELATIVE_LOCATION_RIGHT_OF_BOTTOMALIGN:
+            finalPosX += mg.left;
+            finalPosY += mg.bottom;
+            break;
+        case RELATIVE_LOCATION_RIGHT_OF_CENTER:
+            finalPosX += mg.left;
+            break;
+            
+        case RELATIVE_LOCATION_BELOW_LEFTALIGN:
+            finalPosY -= mg.top;
+            finalPosX += mg.left;
+            break;
+        case RELATIVE_LOCATION_BELOW_RIGHTALIGN:
+            finalPosY -= mg.top;
+            finalPosX -= mg.right;
+            break;
+        case RELATIVE_LOCATION_BELOW_CENTER:
+            finalPosY -= mg.top;
+            break;
+        default:
+            break;
+    }
+    child->setPosition(Point(finalPosX, finalPosY));
+    layoutParameter->_put = true;
 }
     
 static const int BACKGROUNDIMAGE_Z = (-1);
@@ -590,6 +593,7 @@ _scissorRectDirty(false),
 _clippingRect(Rect::ZERO),
 _clippingParent(nullptr),
 _doLayoutDirty(true),
+_doLayoutStartIndex(-1),
 _clippingRectDirty(true),
 _currentStencilEnabled(GL_FALSE),
 _currentStencilWriteMask(~0),
@@ -730,6 +734,11 @@ void Layout::visit(Renderer *renderer, const kmMat4 &parentTransform, bool paren
     
 void Layout::sortAllChildren()
 {
+    if (_reorderChildDirty)
+    {
+        // linear layouts place children in their drawing order
+        _doLayoutDirty = true;
+    }
     Widget::sortAllChildren();
     doLayout();
 }
@@ -1470,17 +1479,36 @@ void Layout::requestDoLayout()
     _doLayoutDirty = true;
 }
 
+void Layout::requestDoLayoutFrom(Widget* child)
+{
+    if (_doLayoutDirty || !_curLayoutExecutant)
+    {
+        return;
+    }
+    if (_layoutType != LAYOUT_LINEAR_VERTICAL && _layoutType != LAYOUT_LINEAR_HORIZONTAL)
+    {
+        _doLayoutDirty = true;
+        return;
+    }
+    ssize_t index = getChildren().getIndex(child);
+    if (index >= 0 && (_doLayoutStartIndex < 0 || index < _doLayoutStartIndex))
+    {
+        _doLayoutStartIndex = index;
+    }
+}
+
 void Layout::doLayout()
 {
-    if (!_doLayoutDirty)
+    if (!_doLayoutDirty && _doLayoutStartIndex < 0)
     {
         return;
     }
     if (_curLayoutExecutant)
     {
-        _curLayoutExecutant->doLayout(getSize(), getChildren());
+        _curLayoutExecutant->doLayout(getSize(), getChildren(), _doLayoutDirty ? 0 : _doLayoutStartIndex);
     }
     _doLayoutDirty = false;
+    _doLayoutStartIndex = -1;
 }
 
 std::string Layout::getDescription() const
@@ -263,6 +263,13 @@ public:
     
     void requestDoLayout();
     
+    /**
+     * Tells the layout that the size or layout parameter of a child changed.
+     *
+     * Linear layouts only place that child and the children after it again, other layouts place every child.
+     */
+    void requestDoLayoutFrom(Widget* child);
+    
     virtual void onEnter() override;
     virtual void onExit() override;
         
@@ -325,6 +332,7 @@ protected:
     Rect _clippingRect;
     Layout* _clippingParent;
     bool _doLayoutDirty;
+    ssize_t _doLayoutStartIndex;
     bool _clippingRectDirty;
     
     //clipping
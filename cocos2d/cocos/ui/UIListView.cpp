@@ -39,7 +39,9 @@ _itemsMargin(0.0f),
 _listViewEventListener(nullptr),
 _listViewEventSelector(nullptr),
 _curSelectedIndex(0),
-_refreshViewDirty(true)
+_refreshViewDirty(true),
+_dataSource(nullptr),
+_firstVisibleIndex(0)
 {
     
 }
@@ -49,6 +51,7 @@ ListView::~ListView()
     _listViewEventListener = nullptr;
     _listViewEventSelector = nullptr;
     _items.clear();
+    _freeItems.clear();
     CC_SAFE_RELEASE(_model);
 }
 
@@ -87,6 +90,20 @@ void ListView::setItemModel(Widget *model)
 
 void ListView::updateInnerContainerSize()
 {
+    if (_dataSource)
+    {
+        ssize_t count = _itemOffsets.size() - 1;
+        float totalLength = count > 0 ? _itemOffsets[count] - _itemsMargin : 0.0f;
+        if (_direction == SCROLLVIEW_DIR_HORIZONTAL)
+        {
+            setInnerContainerSize(Size(totalLength, _size.height));
+        }
+        else
+        {
+            setInnerContainerSize(Size(_size.width, totalLength));
+        }
+        return;
+    }
     switch (_direction)
     {
         case SCROLLVIEW_DIR_VERTICAL:
@@ -245,6 +262,7 @@ void ListView::remedyLayoutParameter(Widget *item)
 
 void ListView::pushBackDefaultItem()
 {
+    CCASSERT(!_dataSource, "Items of a listview with a data source are created by the data source");
     if (!_model)
     {
         return;
@@ -258,6 +276,7 @@ void ListView::pushBackDefaultItem()
 
 void ListView::insertDefaultItem(ssize_t index)
 {
+    CCASSERT(!_dataSource, "Items of a listview with a data source are created by the data source");
     if (!_model)
     {
         return;
@@ -271,6 +290,7 @@ void ListView::insertDefaultItem(ssize_t index)
 
 void ListView::pushBackCustomItem(Widget* item)
 {
+    CCASSERT(!_dataSource, "Items of a listview with a data source are created by the data source");
     _items.pushBack(item);
     remedyLayoutParameter(item);
     addChild(item);
@@ -279,6 +299,7 @@ void ListView::pushBackCustomItem(Widget* item)
 
 void ListView::insertCustomItem(Widget* item, ssize_t index)
 {
+    CCASSERT(!_dataSource, "Items of a listview with a data source are created by the data source");
     _items.insert(index, item);
     remedyLayoutParameter(item);
     addChild(item);
@@ -287,6 +308,7 @@ void ListView::insertCustomItem(Widget* item, ssize_t index)
 
 void ListView::removeItem(ssize_t index)
 {
+    CCASSERT(!_dataSource, "Items of a listview with a data source are removed by reloadData()");
     Widget* item = getItem(index);
     if (!item)
     {
@@ -297,6 +319,21 @@ void ListView::removeItem(ssize_t index)
     _refreshViewDirty = true;
 }
 
+void ListView::removeChild(Node* widget, bool cleanup)
+{
+    // items of a data source are recycled by recycleItem()
+    if (!_dataSource)
+    {
+        Widget* item = dynamic_cast<Widget*>(widget);
+        if (item && _items.contains(item))
+        {
+            _items.eraseObject(item);
+            _refreshViewDirty = true;
+        }
+    }
+    ScrollView::removeChild(widget, cleanup);
+}
+
 void ListView::removeLastItem()
 {
     removeItem(_items.size() -1);
@@ -310,6 +347,10 @@ void ListView::removeAllItems()
 
 Widget* ListView::getItem(ssize_t index)
 {
+    if (_dataSource)
+    {
+        index -= _firstVisibleIndex;
+    }
     if (index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -328,7 +369,12 @@ ssize_t ListView::getIndex(Widget *item) const
     {
         return -1;
     }
-    return _items.getIndex(item);
+    ssize_t index = _items.getIndex(item);
+    if (_dataSource && index >= 0)
+    {
+        index += _firstVisibleIndex;
+    }
+    return index;
 }
 
 void ListView::setGravity(ListViewGravity gravity)
@@ -372,6 +418,10 @@ void ListView::setDirection(SCROLLVIEW_DIR dir)
             return;
             break;
     }
+    if (_dataSource)
+    {
+        setLayoutType(LAYOUT_ABSOLUTE);
+    }
     ScrollView::setDirection(dir);
 }
     
@@ -382,6 +432,11 @@ void ListView::requestRefreshView()
 
 void ListView::refreshView()
 {
+    if (_dataSource)
+    {
+        reloadData();
+        return;
+    }
     ssize_t length = _items.size();
     for (int i=0; i<length; i++)
     {
@@ -400,6 +455,206 @@ void ListView::sortAllChildren()
         refreshView();
         _refreshViewDirty = false;
     }
+    else if (_dataSource)
+    {
+        updateVisibleItems();
+    }
+}
+
+void ListView::setDataSource(ListViewDataSource* dataSource)
+{
+    if (_dataSource == dataSource)
+    {
+        return;
+    }
+    removeAllItems();
+    _freeItems.clear();
+    _itemOffsets.clear();
+    _firstVisibleIndex = 0;
+    _dataSource = dataSource;
+    if (_dataSource)
+    {
+        setLayoutType(LAYOUT_ABSOLUTE);
+    }
+    else
+    {
+        setLayoutType(_direction == SCROLLVIEW_DIR_HORIZONTAL ? LAYOUT_LINEAR_HORIZONTAL : LAYOUT_LINEAR_VERTICAL);
+    }
+    _refreshViewDirty = true;
+}
+
+ListViewDataSource* ListView::getDataSource() const
+{
+    return _dataSource;
+}
+
+void ListView::reloadData()
+{
+    if (!_dataSource)
+    {
+        return;
+    }
+    while (!_items.empty())
+    {
+        recycleItem(_items.back());
+    }
+    updateItemOffsets();
+    updateInnerContainerSize();
+    updateVisibleItems();
+    _refreshViewDirty = false;
+}
+
+Widget* ListView::dequeueItem()
+{
+    if (_freeItems.empty())
+    {
+        return nullptr;
+    }
+    Widget* item = _freeItems.back();
+    item->retain();
+    _freeItems.popBack();
+    item->autorelease();
+    return item;
+}
+
+void ListView::updateItemOffsets()
+{
+    ssize_t count = _dataSource->numberOfItemsInListView(this);
+    _itemOffsets.resize(count + 1);
+    float offset = 0.0f;
+    for (ssize_t i = 0; i < count; i++)
+    {
+        _itemOffsets[i] = offset;
+        offset += _dataSource->itemLengthAtIndex(this, i) + _itemsMargin;
+    }
+    _itemOffsets[count] = offset;
+}
+
+ssize_t ListView::indexFromOffset(float offset) const
+{
+    // the last item starting at or before offset
+    auto it = std::upper_bound(_itemOffsets.begin(), _itemOffsets.end() - 1, offset);
+    ssize_t index = (it - _itemOffsets.begin()) - 1;
+    return index < 0 ? 0 : index;
+}
+
+void ListView::updateVisibleItems()
+{
+    ssize_t count = _itemOffsets.size() - 1;
+    if (count <= 0)
+    {
+        while (!_items.empty())
+        {
+            recycleItem(_items.back());
+        }
+        return;
+    }
+    
+    // visible range, measured from the top (left) of the inner container
+    float start = 0.0f;
+    float end = 0.0f;
+    if (_direction == SCROLLVIEW_DIR_HORIZONTAL)
+    {
+        start = -_innerContainer->getLeftInParent();
+        end = start + _size.width;
+    }
+    else
+    {
+        end = _innerContainer->getTopInParent();
+        start = end - _size.height;
+    }
+    ssize_t first = indexFromOffset(start);
+    ssize_t last = indexFromOffset(end);
+    ssize_t lastVisibleIndex = _firstVisibleIndex + _items.size() - 1;
+    
+    if (_items.empty() || first > lastVisibleIndex || last < _firstVisibleIndex)
+    {
+        while (!_items.empty())
+        {
+            recycleItem(_items.back());
+        }
+        for (ssize_t i = first; i <= last; i++)
+        {
+            _items.pushBack(createItemAtIndex(i));
+        }
+    }
+    else
+    {
+        while (_firstVisibleIndex < first)
+        {
+            recycleItem(_items.front());
+            _firstVisibleIndex++;
+        }
+        while (lastVisibleIndex > last)
+        {
+            recycleItem(_items.back());
+            lastVisibleIndex--;
+        }
+        for (ssize_t i = _firstVisibleIndex - 1; i >= first; i--)
+        {
+            _items.insert(0, createItemAtIndex(i));
+        }
+        for (ssize_t i = lastVisibleIndex + 1; i <= last; i++)
+        {
+            _items.pushBack(createItemAtIndex(i));
+        }
+    }
+    _firstVisibleIndex = first;
+}
+
+void ListView::recycleItem(Widget* item)
+{
+    _freeItems.pushBack(item);
+    _items.eraseObject(item);
+    removeChild(item);
+}
+
+Widget* ListView::createItemAtIndex(ssize_t index)
+{
+    Widget* item = _dataSource->itemAtIndex(this, index);
+    CCASSERT(item, "The data source must return an item");
+    
+    float length = _itemOffsets[index + 1] - _itemOffsets[index] - _itemsMargin;
+    const Size& itemSize = item->getSize();
+    const Point& anchor = item->getAnchorPoint();
+    const Size& innerSize = _innerContainer->getSize();
+    float x = 0.0f;
+    float y = 0.0f;
+    if (_direction == SCROLLVIEW_DIR_HORIZONTAL)
+    {
+        x = _itemOffsets[index] + anchor.x * length;
+        switch (_gravity)
+        {
+            case LISTVIEW_GRAVITY_TOP:
+                y = innerSize.height - (1.0f - anchor.y) * itemSize.height;
+                break;
+            case LISTVIEW_GRAVITY_BOTTOM:
+                y = anchor.y * itemSize.height;
+                break;
+            default:
+                y = (innerSize.height - itemSize.height) / 2.0f + anchor.y * itemSize.height;
+                break;
+        }
+    }
+    else
+    {
+        y = innerSize.height - _itemOffsets[index] - (1.0f - anchor.y) * length;
+        switch (_gravity)
+        {
+            case LISTVIEW_GRAVITY_LEFT:
+                x = anchor.x * itemSize.width;
+                break;
+            case LISTVIEW_GRAVITY_RIGHT:
+                x = innerSize.width - (1.0f - anchor.x) * itemSize.width;
+                break;
+            default:
+                x = (innerSize.width - itemSize.width) / 2.0f + anchor.x * itemSize.width;
+                break;
+        }
+    }
+    item->setPosition(Point(x, y));
+    addChild(item);
+    return item;
 }
     
 void ListView::addEventListenerListView(Ref *target, SEL_ListViewEvent selector)
@@ -470,6 +725,11 @@ Widget* ListView::createCloneInstance()
 
 void ListView::copyClonedWidgetChildren(Widget* model)
 {
+    if (_dataSource)
+    {
+        // the items are created by the shared data source
+        return;
+    }
     auto& arrayItems = static_cast<ListView*>(model)->getItems();
     for (auto& item : arrayItems)
     {
@@ -486,6 +746,7 @@ void ListView::copySpecialProperties(Widget *widget)
         setItemModel(listViewEx->_model);
         setItemsMargin(listViewEx->_itemsMargin);
         setGravity(listViewEx->_gravity);
+        setDataSource(listViewEx->_dataSource);
     }
 }
 
@@ -52,6 +52,36 @@ typedef enum
 typedef void (Ref::*SEL_ListViewEvent)(Ref*,ListViewEventType);
 #define listvieweventselector(_SELECTOR) (SEL_ListViewEvent)(&_SELECTOR)
 
+class ListView;
+
+/**
+ * Data source of a virtualized listview.
+ *
+ * Only the items inside the view are created, and items scrolled out of the view are kept for reuse.
+ */
+class ListViewDataSource
+{
+public:
+    virtual ~ListViewDataSource() {}
+    
+    /**
+     * Returns number of items in a given listview.
+     */
+    virtual ssize_t numberOfItemsInListView(ListView* listView) = 0;
+    
+    /**
+     * Returns the height of the item at a given index for a vertical listview, the width for a horizontal one.
+     */
+    virtual float itemLengthAtIndex(ListView* listView, ssize_t index) = 0;
+    
+    /**
+     * Returns the item widget at a given index.
+     *
+     * The widget should be taken from ListView::dequeueItem() when it is not null.
+     */
+    virtual Widget* itemAtIndex(ListView* listView, ssize_t index) = 0;
+};
+
 class ListView : public ScrollView
 {
  
@@ -174,6 +204,28 @@ public:
     
     void requestRefreshView();
     void refreshView();
+    
+    /**
+     * Sets a data source, the listview only holds the items inside the view after that.
+     *
+     * Items can't be added or removed one by one while a data source is set, getItems() returns the visible items
+     * and getCurSelectedIndex() returns the index in the data source. The data source is not retained.
+     *
+     * @param dataSource  data source, nullptr goes back to holding every item.
+     */
+    void setDataSource(ListViewDataSource* dataSource);
+    
+    ListViewDataSource* getDataSource() const;
+    
+    /**
+     * Asks the data source for the number of items and their lengths again, and rebuilds the visible items.
+     */
+    void reloadData();
+    
+    /**
+     * Returns an item scrolled out of the view for reuse, or nullptr if there is none.
+     */
+    Widget* dequeueItem();
 
 CC_CONSTRUCTOR_ACCESS:
     virtual bool init() override;
@@ -182,7 +234,7 @@ protected:
     virtual void addChild(Node* child) override{ScrollView::addChild(child);};
     virtual void addChild(Node * child, int zOrder) override{ScrollView::addChild(child, zOrder);};
     virtual void addChild(Node* child, int zOrder, int tag) override{ScrollView::addChild(child, zOrder, tag);};
-    virtual void removeChild(Node* widget, bool cleanup = true) override{ScrollView::removeChild(widget, cleanup);};
+    virtual void removeChild(Node* widget, bool cleanup = true) override;
     
     virtual void removeAllChildren() override{removeAllChildrenWithCleanup(true);};
     virtual void removeAllChildrenWithCleanup(bool cleanup) override {ScrollView::removeAllChildrenWithCleanup(cleanup);};
@@ -193,6 +245,11 @@ protected:
     virtual Widget* getChildByName(const char* name) override {return ScrollView::getChildByName(name);};
     void updateInnerContainerSize();
     void remedyLayoutParameter(Widget* item);
+    void updateItemOffsets();
+    ssize_t indexFromOffset(float offset) const;
+    void updateVisibleItems();
+    void recycleItem(Widget* item);
+    Widget* createItemAtIndex(ssize_t index);
     virtual void onSizeChanged() override;
     virtual Widget* createCloneInstance() override;
     virtual void copySpecialProperties(Widget* model) override;
@@ -209,6 +266,11 @@ protected:
     SEL_ListViewEvent    _listViewEventSelector;
     ssize_t _curSelectedIndex;
     bool _refreshViewDirty;
+    
+    ListViewDataSource* _dataSource;
+    std::vector<float> _itemOffsets;        // start of each item from the top (left) of the inner container, plus the end
+    ssize_t _firstVisibleIndex;             // data source index of _items.front()
+    Vector<Widget*> _freeItems;
 };
 
 }
@@ -42,7 +42,6 @@ _touchMovePos(Point::ZERO),
 _touchEndPos(Point::ZERO),
 _touchEventListener(nullptr),
 _touchEventSelector(nullptr),
-_name("default"),
 _widgetType(WidgetTypeWidget),
 _actionTag(0),
 _size(Size::ZERO),
@@ -61,7 +60,7 @@ _opacity(255),
 _flippedX(false),
 _flippedY(false)
 {
-
+    _name = "default";
 }
 
 Widget::~Widget()
@@ -395,6 +394,11 @@ void Widget::onSizeChanged()
             widgetChild->updateSizeAndPosition();
         }
     }
+    Layout* layoutParent = dynamic_cast<Layout*>(getParent());
+    if (layoutParent)
+    {
+        layoutParent->requestDoLayoutFrom(this);
+    }
 }
 
 const Size& Widget::getVirtualRendererSize() const
@@ -790,7 +794,7 @@ const Point& Widget::getTouchEndPos()
 
 void Widget::setName(const char* name)
 {
-    _name = name;
+    Node::setName(name);
 }
 
 const char* Widget::getName() const
@@ -810,6 +814,11 @@ void Widget::setLayoutParameter(LayoutParameter *parameter)
         return;
     }
     _layoutParameterDictionary.insert(parameter->getLayoutType(), parameter);
+    Layout* layoutParent = dynamic_cast<Layout*>(getParent());
+    if (layoutParent)
+    {
+        layoutParent->requestDoLayoutFrom(this);
+    }
 }
 
 LayoutParameter* Widget::getLayoutParameter(LayoutParameterType type)
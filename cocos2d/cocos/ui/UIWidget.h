@@ -579,7 +579,6 @@ protected:
     Point _touchEndPos;      ///< touch ended point
     Ref*       _touchEventListener;
     SEL_TouchEvent    _touchEventSelector;
-    std::string _name;
     WidgetType _widgetType;
 	int _actionTag;
     Size _size;
@@ -0,0 +1,91 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+/*
+ * Bakes plist and TMX files for the BinaryValueCache.
+ *
+ * usage: cocos2d-valuebaker file.plist [file.tmx ...]
+ *
+ * Every baked file is written next to its source ("<file>.ccvb", or "<file>.<layer index>.ccvb"
+ * for the layers of a TMX map) and must be shipped along with it.
+ */
+
+#include "cocos2d.h"
+#include "platform/CCBinaryValueCache.h"
+
+#include <stdio.h>
+#include <limits.h>
+#include <string>
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+#include <direct.h>
+#define getcwd _getcwd
+#define PATH_MAX _MAX_PATH
+#else
+#include <unistd.h>
+#endif
+
+USING_NS_CC;
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s file.plist [file.tmx ...]\n", argv[0]);
+        return 1;
+    }
+
+    char cwd[PATH_MAX];
+    if (! getcwd(cwd, sizeof(cwd)))
+    {
+        fprintf(stderr, "can not get the current directory\n");
+        return 1;
+    }
+
+    BinaryValueCache* cache = BinaryValueCache::getInstance();
+
+    int failures = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string path = argv[i];
+        if (! FileUtils::getInstance()->isAbsolutePath(path))
+        {
+            path = std::string(cwd) + "/" + path;
+        }
+
+        if (cache->bakeFile(path))
+        {
+            printf("baked %s\n", path.c_str());
+        }
+        else
+        {
+            fprintf(stderr, "can not bake %s\n", path.c_str());
+            ++failures;
+        }
+    }
+
+    BinaryValueCache::destroyInstance();
+
+    return failures == 0 ? 0 : 1;
+}